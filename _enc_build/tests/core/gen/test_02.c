@@ -0,0 +1,843 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_02.c; do not edit.
+ * 31 compiled, 1 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'V', 0x1080, 0, 0, 1, 14, 4, 4, 9, 6, XO_COMPILED_NONE, 0, 16 },
+    { 'V', 0x18, 0, 0, 17, 13, 20, 5, 26, 4, XO_COMPILED_NONE, 0, 31 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{kt:name/%-*.*s}{eq:flags/0x%x}",
+    7, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, int a1, int a2, const char *a3, unsigned a4)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1, a2, a3, a4);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0x40, 0, 0, 1, 9, XO_COMPILED_NONE, 0, 4, 6, XO_COMPILED_NONE, 0, 11 },
+    { 'V', 0x1088, 0, 0, 12, 8, 16, 4, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 21 },
+    { 'V', 0x18, 0, 0, 22, 13, 25, 5, 31, 4, XO_COMPILED_NONE, 0, 36 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{d:/%-*.*s}{etk:name}{eq:flags/0x%x}",
+    9, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, int a1, int a2, const char *a3, const char *a4, unsigned a5)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2, a3, a4, a5);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 7, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 7 },
+    { '{', 0, 0, 0, 8, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 15 },
+    { '{', 0, 0, 0, 16, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 23 },
+    { '+', 0, 0, 0, 23, 0, 23, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 29 },
+    { 'V', 0, 0, 0, 30, 5, 31, 4, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 36 },
+    { '\n', 0, 0, 0, 36, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "We are {{emit}}{{ting}} some {:what}\n",
+    15, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 7, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 7 },
+    { 'V', 0, 0, 0, 8, 13, 9, 6, 16, 5, XO_COMPILED_NONE, 0, 22 },
+    { '\n', 0, 0, 0, 22, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    "length {:length/%6.6s}\n",
+    7, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_5[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 6 },
+    { 'V', 0, 0, 0, 7, 6, 8, 2, 11, 2, XO_COMPILED_NONE, 0, 14 },
+    { '+', 0, 0, 0, 14, 0, 14, 10, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 24 },
+    { 'V', 0, 0, 0, 25, 9, 26, 5, 32, 2, XO_COMPILED_NONE, 0, 35 },
+    { '+', 0, 0, 0, 35, 0, 35, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 36 },
+    { 'V', 0, 0, 0, 37, 5, 38, 4, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 43 },
+    { '\n', 0, 0, 0, 43, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_5 = {
+    XO_COMPILED_VERSION,
+    "close {:fd/%d} returned {:error/%m} {:test}\n",
+    11, xo_gen_fields_5
+};
+
+static xo_ssize_t
+xo_gen_emit_5 (xo_handle_t *xop, int a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_5, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_6[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 6 },
+    { 'V', 0, 0, 0, 7, 6, 8, 2, 11, 2, XO_COMPILED_NONE, 0, 14 },
+    { '+', 0, 0, 0, 14, 0, 14, 10, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 24 },
+    { 'V', 0, 0, 0, 25, 12, 26, 5, 32, 5, XO_COMPILED_NONE, 0, 38 },
+    { '+', 0, 0, 0, 38, 0, 38, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 39 },
+    { 'V', 0, 0, 0, 40, 5, 41, 4, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 46 },
+    { '\n', 0, 0, 0, 46, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_6 = {
+    XO_COMPILED_VERSION,
+    "close {:fd/%d} returned {:error/%6.6m} {:test}\n",
+    11, xo_gen_fields_6
+};
+
+static xo_ssize_t
+xo_gen_emit_6 (xo_handle_t *xop, int a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_6, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_7[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 'V', 0, 0, 0, 2, 11, 3, 5, 9, 4, XO_COMPILED_NONE, 0, 14 },
+    { '+', 0, 0, 0, 14, 0, 14, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 15 },
+    { 'V', 0, 0, 0, 16, 11, 17, 5, 23, 4, XO_COMPILED_NONE, 0, 28 },
+    { '+', 0, 0, 0, 28, 0, 28, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 29 },
+    { 'V', 0, 0, 0, 30, 16, 31, 10, 42, 4, XO_COMPILED_NONE, 0, 47 },
+    { '+', 0, 0, 0, 47, 0, 47, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 48 },
+    { 'V', 0x40, 0, 0, 49, 13, 51, 8, 60, 2, XO_COMPILED_NONE, 0, 63 },
+    { '\n', 0, 0, 0, 63, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_7 = {
+    XO_COMPILED_VERSION,
+    " {:lines/%7ju} {:words/%7ju} " "{:characters/%7ju} {d:filename/%s}\n",
+    13, xo_gen_fields_7
+};
+
+static xo_ssize_t
+xo_gen_emit_7 (xo_handle_t *xop, uintmax_t a1, uintmax_t a2, uintmax_t a3, const char *a4)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_7, a1, a2, a3, a4);
+}
+
+static xo_ssize_t
+xo_gen_emit_8 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_hf(xop, XOEF_RETAIN, "{lw:bytes/%d}{Np:byte,bytes}\n", a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_9[] = {
+    { 'L', 0x1, 0, 0, 1, 24, 4, 21, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 26 },
+    { 'P', 0, 0, 0, 27, 3, 29, 1, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 31 },
+    { 'V', 0, 0, 0, 32, 18, 33, 14, 48, 2, XO_COMPILED_NONE, 0, 51 },
+    { 'U', 0x4, 0, 0, 52, 7, XO_COMPILED_NONE, 0, 56, 3, XO_COMPILED_NONE, 0, 60 },
+    { '\n', 0, 0, 0, 60, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_9 = {
+    XO_COMPILED_VERSION,
+    "{Lc:Low\\/warn granularity}{P:\t}{:granularity-lw/%d}{Uw:/%sh}\n",
+    13, xo_gen_fields_9
+};
+
+static xo_ssize_t
+xo_gen_emit_9 (xo_handle_t *xop, int a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_9, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_10[] = {
+    { 'V', 0, 0, 0, 1, 16, 2, 12, 15, 2, XO_COMPILED_NONE, 0, 18 },
+    { '+', 0, 0, 0, 18, 0, 18, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 19 },
+    { 'V', 0, 0, 0, 20, 14, 21, 10, 32, 2, XO_COMPILED_NONE, 0, 35 },
+    { '+', 0, 0, 0, 35, 0, 35, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 36 },
+    { 'V', 0, 0, 0, 37, 14, 38, 10, 49, 2, XO_COMPILED_NONE, 0, 52 },
+    { '+', 0, 0, 0, 52, 0, 52, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 53 },
+    { 'N', 0, 0, 0, 54, 42, 56, 40, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 97 },
+    { '\n', 0, 0, 0, 97, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_10 = {
+    XO_COMPILED_VERSION,
+    "{:mbuf-current/%u}/{:mbuf-cache/%u}/{:mbuf-total/%u} " "{N:mbufs <&> in use (current\\/cache\\/total)}\n",
+    13, xo_gen_fields_10
+};
+
+static xo_ssize_t
+xo_gen_emit_10 (xo_handle_t *xop, unsigned a1, unsigned a2, unsigned a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_10, a1, a2, a3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_11[] = {
+    { 'V', 0, 0, 0, 1, 12, 2, 8, 11, 2, XO_COMPILED_NONE, 0, 14 },
+    { 'U', 0x4, 0, 0, 15, 8, 18, 5, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 24 },
+    { '+', 0, 0, 0, 24, 0, 24, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 30 },
+    { 'V', 0, 0, 0, 31, 9, 32, 8, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 41 },
+    { '\n', 0, 0, 0, 41, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_11 = {
+    XO_COMPILED_VERSION,
+    "{:distance/%u}{Uw:miles} from {:location}\n",
+    11, xo_gen_fields_11
+};
+
+static xo_ssize_t
+xo_gen_emit_11 (xo_handle_t *xop, unsigned a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_11, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_12[] = {
+    { 'V', 0, 0, 0, 1, 10, 2, 6, 9, 2, XO_COMPILED_NONE, 0, 12 },
+    { 'U', 0, 0, 0, 13, 3, 15, 1, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 17 },
+    { '+', 0, 0, 0, 17, 0, 17, 13, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 30 },
+    { 'V', 0, 0, 0, 31, 9, 32, 5, 38, 2, XO_COMPILED_NONE, 0, 41 },
+    { 'U', 0, 0, 0, 42, 4, 44, 2, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 47 },
+    { '\n', 0, 0, 0, 47, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_12 = {
+    XO_COMPILED_VERSION,
+    "{:memory/%u}{U:k} left out of {:total/%u}{U:kb}\n",
+    13, xo_gen_fields_12
+};
+
+static xo_ssize_t
+xo_gen_emit_12 (xo_handle_t *xop, unsigned a1, unsigned a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_12, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_13[] = {
+    { 'V', 0, 0, 0, 1, 10, 2, 6, 9, 2, XO_COMPILED_NONE, 0, 12 },
+    { 'U', 0, 0, 0, 13, 5, XO_COMPILED_NONE, 0, 16, 2, XO_COMPILED_NONE, 0, 19 },
+    { '+', 0, 0, 0, 19, 0, 19, 13, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 32 },
+    { 'V', 0, 0, 0, 33, 9, 34, 5, 40, 2, XO_COMPILED_NONE, 0, 43 },
+    { 'U', 0, 0, 0, 44, 5, XO_COMPILED_NONE, 0, 47, 2, XO_COMPILED_NONE, 0, 50 },
+    { '\n', 0, 0, 0, 50, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_13 = {
+    XO_COMPILED_VERSION,
+    "{:memory/%u}{U:/%s} left out of {:total/%u}{U:/%s}\n",
+    13, xo_gen_fields_13
+};
+
+static xo_ssize_t
+xo_gen_emit_13 (xo_handle_t *xop, unsigned a1, const char *a2, unsigned a3, const char *a4)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_13, a1, a2, a3, a4);
+}
+
+static const xo_compiled_field_t xo_gen_fields_14[] = {
+    { 'T', 0, 0, 0, 1, 22, XO_COMPILED_NONE, 0, 9, 14, XO_COMPILED_NONE, 0, 24 },
+    { '\n', 0, 0, 0, 24, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_14 = {
+    XO_COMPILED_VERSION,
+    "{,title:/before%safter:}\n",
+    7, xo_gen_fields_14
+};
+
+static xo_ssize_t
+xo_gen_emit_14 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_14, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_15[] = {
+    { 'V', 0x45, 0, 0, 1, 28, 22, 4, 27, 2, XO_COMPILED_NONE, 0, 30 },
+    { 'V', 0, 0, 0, 31, 14, 38, 3, 42, 3, XO_COMPILED_NONE, 0, 46 },
+    { 'V', 0, 0, 0, 47, 17, 54, 6, 61, 3, XO_COMPILED_NONE, 0, 65 },
+    { '\n', 0, 0, 0, 65, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_15 = {
+    XO_COMPILED_VERSION,
+    "{,display,white,colon:some/%s}" "{,value:ten/%ju}{,value:eleven/%ju}\n",
+    11, xo_gen_fields_15
+};
+
+static xo_ssize_t
+xo_gen_emit_15 (xo_handle_t *xop, const char *a1, uintmax_t a2, uintmax_t a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_15, a1, a2, a3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_16[] = {
+    { 'V', 0, 0, 0, 1, 11, 2, 7, 10, 2, XO_COMPILED_NONE, 0, 13 },
+    { '+', 0, 0, 0, 13, 0, 13, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 14 },
+    { 'N', 0, 0, 0, 15, 35, XO_COMPILED_NONE, 0, 18, 32, XO_COMPILED_NONE, 0, 51 },
+    { '\n', 0, 0, 0, 51, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_16 = {
+    XO_COMPILED_VERSION,
+    "{:unknown/%u} " "{N:/packet%s here\\/there\\/everywhere}\n",
+    9, xo_gen_fields_16
+};
+
+static xo_ssize_t
+xo_gen_emit_16 (xo_handle_t *xop, unsigned a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_16, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_17[] = {
+    { 'V', 0, 0, 0, 1, 11, 2, 7, 10, 2, XO_COMPILED_NONE, 0, 13 },
+    { '+', 0, 0, 0, 13, 0, 13, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 14 },
+    { 'N', 0, 0, 0, 15, 39, XO_COMPILED_NONE, 0, 22, 32, XO_COMPILED_NONE, 0, 55 },
+    { '\n', 0, 0, 0, 55, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_17 = {
+    XO_COMPILED_VERSION,
+    "{:unknown/%u} " "{,note:/packet%s here\\/there\\/everywhere}\n",
+    9, xo_gen_fields_17
+};
+
+static xo_ssize_t
+xo_gen_emit_17 (xo_handle_t *xop, unsigned a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_17, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_18[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { '[', 0, 0, 0, 2, 5, XO_COMPILED_NONE, 0, 5, 2, XO_COMPILED_NONE, 0, 8 },
+    { 'V', 0x20, 0, 0, 9, 8, 11, 3, 15, 2, XO_COMPILED_NONE, 0, 18 },
+    { '+', 0, 0, 0, 18, 0, 18, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 19 },
+    { 'V', 0x20, 0, 0, 20, 8, 22, 3, 26, 2, XO_COMPILED_NONE, 0, 29 },
+    { '+', 0, 0, 0, 29, 0, 29, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 30 },
+    { 'V', 0, 0, 0, 31, 7, 32, 3, 36, 2, XO_COMPILED_NONE, 0, 39 },
+    { ']', 0, 0, 0, 40, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 43 },
+    { '+', 0, 0, 0, 43, 0, 43, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 44 },
+    { '\n', 0, 0, 0, 44, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_18 = {
+    XO_COMPILED_VERSION,
+    "({[:/%d}{n:min/15}/{n:cur/20}/{:max/%d}{]:})\n",
+    15, xo_gen_fields_18
+};
+
+static xo_ssize_t
+xo_gen_emit_18 (xo_handle_t *xop, int a1, int a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_18, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_19[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { '[', 0, 0, 0, 2, 4, 4, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 7 },
+    { 'V', 0, 0, 0, 8, 7, 9, 3, 13, 2, XO_COMPILED_NONE, 0, 16 },
+    { '+', 0, 0, 0, 16, 0, 16, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 17 },
+    { 'V', 0, 0, 0, 18, 7, 19, 3, 23, 2, XO_COMPILED_NONE, 0, 26 },
+    { '+', 0, 0, 0, 26, 0, 26, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 27 },
+    { 'V', 0, 0, 0, 28, 7, 29, 3, 33, 2, XO_COMPILED_NONE, 0, 36 },
+    { ']', 0, 0, 0, 37, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 40 },
+    { '+', 0, 0, 0, 40, 0, 40, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 41 },
+    { '\n', 0, 0, 0, 41, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_19 = {
+    XO_COMPILED_VERSION,
+    "({[:30}{:min/%u}/{:cur/%u}/{:max/%u}{]:})\n",
+    15, xo_gen_fields_19
+};
+
+static xo_ssize_t
+xo_gen_emit_19 (xo_handle_t *xop, unsigned a1, unsigned a2, unsigned a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_19, a1, a2, a3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_20[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { '[', 0, 0, 0, 2, 5, 4, 3, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 8 },
+    { 'V', 0x20, 0, 0, 9, 8, 11, 3, 15, 2, XO_COMPILED_NONE, 0, 18 },
+    { '+', 0, 0, 0, 18, 0, 18, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 19 },
+    { 'V', 0x20, 0, 0, 20, 8, 22, 3, 26, 2, XO_COMPILED_NONE, 0, 29 },
+    { '+', 0, 0, 0, 29, 0, 29, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 30 },
+    { 'V', 0x20, 0, 0, 31, 9, 33, 3, 37, 3, XO_COMPILED_NONE, 0, 41 },
+    { ']', 0, 0, 0, 42, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 45 },
+    { '+', 0, 0, 0, 45, 0, 45, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 46 },
+    { '\n', 0, 0, 0, 46, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_20 = {
+    XO_COMPILED_VERSION,
+    "({[:-30}{n:min/15}/{n:cur/20}/{n:max/125}{]:})\n",
+    15, xo_gen_fields_20
+};
+
+static xo_ssize_t
+xo_gen_emit_20 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_20);
+}
+
+static const xo_compiled_field_t xo_gen_fields_21[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { '[', 0, 0, 0, 2, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 5 },
+    { 'V', 0, 0, 0, 6, 7, 7, 3, 11, 2, XO_COMPILED_NONE, 0, 14 },
+    { '+', 0, 0, 0, 14, 0, 14, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 15 },
+    { 'V', 0, 0, 0, 16, 7, 17, 3, 21, 2, XO_COMPILED_NONE, 0, 24 },
+    { '+', 0, 0, 0, 24, 0, 24, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 25 },
+    { 'V', 0, 0, 0, 26, 7, 27, 3, 31, 2, XO_COMPILED_NONE, 0, 34 },
+    { ']', 0, 0, 0, 35, 5, XO_COMPILED_NONE, 0, 38, 2, XO_COMPILED_NONE, 0, 41 },
+    { '+', 0, 0, 0, 41, 0, 41, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 42 },
+    { '\n', 0, 0, 0, 42, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_21 = {
+    XO_COMPILED_VERSION,
+    "({[:}{:min/%u}/{:cur/%u}/{:max/%u}{]:/%d})\n",
+    15, xo_gen_fields_21
+};
+
+static xo_ssize_t
+xo_gen_emit_21 (xo_handle_t *xop, unsigned a1, unsigned a2, unsigned a3, int a4)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_21, a1, a2, a3, a4);
+}
+
+static const xo_compiled_field_t xo_gen_fields_22[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 10, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 10 },
+    { 'V', 0x8000, 0, 0, 11, 9, 13, 4, 18, 2, XO_COMPILED_NONE, 0, 21 },
+    { '+', 0, 0, 0, 21, 0, 21, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 23 },
+    { 'V', 0x18000, 0, 0, 24, 18, 35, 4, 40, 2, XO_COMPILED_NONE, 0, 43 },
+    { '+', 0, 0, 0, 43, 0, 43, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 45 },
+    { 'V', 0x28000, 0, 0, 46, 20, 59, 4, 64, 2, XO_COMPILED_NONE, 0, 67 },
+    { '+', 0, 0, 0, 67, 0, 67, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 69 },
+    { 'V', 0x48000, 0, 0, 70, 17, 80, 4, 85, 2, XO_COMPILED_NONE, 0, 88 },
+    { '+', 0, 0, 0, 88, 0, 88, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 90 },
+    { 'V', 0x28000, 0, 0, 91, 20, 104, 4, 109, 2, XO_COMPILED_NONE, 0, 112 },
+    { '\n', 0, 0, 0, 112, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_22 = {
+    XO_COMPILED_VERSION,
+    "Humanize: {h:val1/%u}, {h,hn-space:val2/%u}, " "{h,hn-decimal:val3/%u}, {h,hn-1000:val4/%u}, " "{h,hn-decimal:val5/%u}\n",
+    15, xo_gen_fields_22
+};
+
+static xo_ssize_t
+xo_gen_emit_22 (xo_handle_t *xop, unsigned a1, unsigned a2, unsigned a3, unsigned a4, unsigned a5)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_22, a1, a2, a3, a4, a5);
+}
+
+static const xo_compiled_field_t xo_gen_fields_23[] = {
+    { 'V', 0x2010, 0, 0, 1, 11, 4, 4, 9, 3, XO_COMPILED_NONE, 0, 13 },
+    { '+', 0, 0, 0, 13, 0, 13, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 14 },
+    { 'V', 0x2010, 0, 0, 15, 11, 18, 4, 23, 3, XO_COMPILED_NONE, 0, 27 },
+    { '+', 0, 0, 0, 27, 0, 27, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 28 },
+    { 'V', 0x2010, 0, 0, 29, 13, 32, 4, 37, 5, XO_COMPILED_NONE, 0, 43 },
+    { '\n', 0, 0, 0, 43, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_23 = {
+    XO_COMPILED_VERSION,
+    "{lq:flag/one} {lq:flag/two} {lq:flag/three}\n",
+    11, xo_gen_fields_23
+};
+
+static xo_ssize_t
+xo_gen_emit_23 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_23);
+}
+
+static const xo_compiled_field_t xo_gen_fields_24[] = {
+    { 'V', 0x20, 0, 0, 1, 10, 3, 5, 9, 2, XO_COMPILED_NONE, 0, 12 },
+    { '\n', 0, 0, 0, 12, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_24 = {
+    XO_COMPILED_VERSION,
+    "{n:works/%s}\n",
+    7, xo_gen_fields_24
+};
+
+static xo_ssize_t
+xo_gen_emit_24 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_24, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_25[] = {
+    { 'V', 0x8, 0, 0, 1, 12, 3, 9, 13, 0, XO_COMPILED_NONE, 0, 14 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_25 = {
+    XO_COMPILED_VERSION,
+    "{e:empty-tag/}",
+    5, xo_gen_fields_25
+};
+
+static xo_ssize_t
+xo_gen_emit_25 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_25);
+}
+
+static const xo_compiled_field_t xo_gen_fields_26[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 2 },
+    { 'V', 0x1010, 0, 0, 3, 9, 6, 2, 9, 3, XO_COMPILED_NONE, 0, 13 },
+    { '+', 0, 0, 0, 13, 0, 13, 3, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 16 },
+    { 'V', 0x1010, 0, 0, 17, 14, 20, 2, 23, 8, XO_COMPILED_NONE, 0, 32 },
+    { '+', 0, 0, 0, 32, 0, 32, 3, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 35 },
+    { 'V', 0x1010, 0, 0, 36, 11, 39, 2, 42, 5, XO_COMPILED_NONE, 0, 48 },
+    { '+', 0, 0, 0, 48, 0, 48, 3, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 51 },
+    { 'V', 0x1010, 0, 0, 52, 13, 55, 2, 58, 7, XO_COMPILED_NONE, 0, 66 },
+    { '\n', 0, 0, 0, 66, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_26 = {
+    XO_COMPILED_VERSION,
+    "1:{qt:t1/%*d} 2:{qt:t2/test%-*u} " "3:{qt:t3/%10sx} 4:{qt:t4/x%-*.*s}\n",
+    13, xo_gen_fields_26
+};
+
+static xo_ssize_t
+xo_gen_emit_26 (xo_handle_t *xop, int a1, int a2, int a3, unsigned a4, const char *a5, int a6, int a7, const char *a8)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_26, a1, a2, a3, a4, a5, a6, a7, a8);
+}
+
+static const xo_compiled_field_t xo_gen_fields_27[] = {
+    { 'E', 0, 0, 0, 1, 18, 3, 16, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 20 },
+    { '\n', 0, 0, 0, 20, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_27 = {
+    XO_COMPILED_VERSION,
+    "{E:this is an error}\n",
+    7, xo_gen_fields_27
+};
+
+static xo_ssize_t
+xo_gen_emit_27 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_27);
+}
+
+static const xo_compiled_field_t xo_gen_fields_28[] = {
+    { 'E', 0, 0, 0, 1, 18, XO_COMPILED_NONE, 0, 4, 15, XO_COMPILED_NONE, 0, 20 },
+    { '\n', 0, 0, 0, 20, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_28 = {
+    XO_COMPILED_VERSION,
+    "{E:/%s more error%s}\n",
+    7, xo_gen_fields_28
+};
+
+static xo_ssize_t
+xo_gen_emit_28 (xo_handle_t *xop, const char *a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_28, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_29[] = {
+    { 'W', 0, 0, 0, 1, 20, 3, 18, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 22 },
+    { '\n', 0, 0, 0, 22, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_29 = {
+    XO_COMPILED_VERSION,
+    "{W:this is an warning}\n",
+    7, xo_gen_fields_29
+};
+
+static xo_ssize_t
+xo_gen_emit_29 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_29);
+}
+
+static const xo_compiled_field_t xo_gen_fields_30[] = {
+    { 'W', 0, 0, 0, 1, 20, XO_COMPILED_NONE, 0, 4, 17, XO_COMPILED_NONE, 0, 22 },
+    { '\n', 0, 0, 0, 22, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_30 = {
+    XO_COMPILED_VERSION,
+    "{W:/%s more warning%s}\n",
+    7, xo_gen_fields_30
+};
+
+static xo_ssize_t
+xo_gen_emit_30 (xo_handle_t *xop, const char *a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_30, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_31[] = {
+    { 'L', 0, 0, 0, 1, 18, XO_COMPILED_NONE, 0, 4, 15, XO_COMPILED_NONE, 0, 20 },
+    { '+', 0, 0, 0, 20, 0, 20, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 22 },
+    { 'V', 0, 0, 0, 23, 9, 24, 5, 30, 2, XO_COMPILED_NONE, 0, 33 },
+    { '\n', 0, 0, 0, 33, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_31 = {
+    XO_COMPILED_VERSION,
+    "{L:/V1\\/V2 packet%s}: {:count/%u}\n",
+    9, xo_gen_fields_31
+};
+
+static xo_ssize_t
+xo_gen_emit_31 (xo_handle_t *xop, const char *a1, unsigned a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_31, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_32[] = {
+    { 'V', 0, 0, 0, 1, 10, 2, 4, 7, 4, XO_COMPILED_NONE, 0, 12 },
+    { '+', 0, 0, 0, 12, 0, 12, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 13 },
+    { 'L', 0, 0, 0, 14, 7, XO_COMPILED_NONE, 0, 17, 4, XO_COMPILED_NONE, 0, 22 },
+    { '\n', 0, 0, 0, 22, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_32 = {
+    XO_COMPILED_VERSION,
+    "{:test/%04d} {L:/tr%s}\n",
+    9, xo_gen_fields_32
+};
+
+static xo_ssize_t
+xo_gen_emit_32 (xo_handle_t *xop, int a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_32, a1, a2);
+}
+
+#line 1 "../../../tests/core/test_02.c"
+/*
+ * Copyright (c) 2014-2019, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2014
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xo.h"
+#include "xo_encoder.h"
+
+#include "xo_humanize.h"
+
+int
+main (int argc, char **argv)
+{
+    xo_set_program("test_02");
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    for (argc = 1; argv[argc]; argc++) {
+	if (xo_streq(argv[argc], "xml"))
+	    xo_set_style(NULL, XO_STYLE_XML);
+	else if (xo_streq(argv[argc], "json"))
+	    xo_set_style(NULL, XO_STYLE_JSON);
+	else if (xo_streq(argv[argc], "text"))
+	    xo_set_style(NULL, XO_STYLE_TEXT);
+	else if (xo_streq(argv[argc], "html"))
+	    xo_set_style(NULL, XO_STYLE_HTML);
+	else if (xo_streq(argv[argc], "pretty"))
+	    xo_set_flags(NULL, XOF_PRETTY);
+	else if (xo_streq(argv[argc], "xpath"))
+	    xo_set_flags(NULL, XOF_XPATH);
+	else if (xo_streq(argv[argc], "info"))
+	    xo_set_flags(NULL, XOF_INFO);
+    }
+
+    xo_set_flags(NULL, XOF_UNITS); /* Always test w/ this */
+    xo_set_file(stdout);
+
+    xo_open_container_h(NULL, "top");
+
+    xo_open_container("data");
+
+    xo_gen_emit_1(NULL,
+	    5, 5, "em0", 34883);
+
+    xo_gen_emit_2(NULL,
+	    5, 5, "em0", "em0", 34883);
+
+    xo_gen_emit_3(NULL, "braces");
+
+    xo_message("abcdef");
+    close(-1);
+    xo_message_e("abcdef");
+
+    xo_message("improper use of profanity; %s; %s",
+	       "ten yard penalty", "first down");
+
+    xo_gen_emit_4(NULL, "abcdefghijklmnopqrstuvwxyz");
+
+    close(-1);
+    xo_gen_emit_5(NULL, -1, "good");
+    close(-1);
+    xo_gen_emit_6(NULL, -1, "good");
+
+
+    xo_message("improper use of profanity; %s; %s",
+	       "ten yard penalty", "first down");
+
+    xo_gen_emit_7(NULL
+,
+            (uintmax_t) 20, (uintmax_t) 30, (uintmax_t) 40, "file");
+
+    int i;
+    for (i = 0; i < 5; i++)
+	xo_gen_emit_8(NULL, i);
+
+    xo_gen_emit_9(NULL,
+	    155, "mA");
+
+    xo_gen_emit_10(NULL
+,
+	    10, 20, 30);
+
+    xo_gen_emit_11(NULL, 50, "Boston");
+    xo_gen_emit_12(NULL, 64, 640);
+    xo_gen_emit_13(NULL,
+	    64, "k", 640, "kilobytes");
+
+    xo_gen_emit_14(NULL, "working");
+
+    xo_gen_emit_15(NULL
+,
+	    "string", (uintmax_t) 10, (uintmax_t) 11);
+
+    xo_gen_emit_16(NULL
+,
+	    1010, "s");
+
+    xo_gen_emit_17(NULL
+,
+	    1010, "s");
+
+    xo_gen_emit_18(NULL, 30, 125);
+    xo_gen_emit_19(NULL, 15, 20, 125);
+    xo_gen_emit_20(NULL);
+    xo_gen_emit_21(NULL, 15, 20, 125, -30);
+
+    xo_gen_emit_22(NULL
+
+,
+            21,
+	    57 * 1024,
+	    96 * 1024 * 1024,
+	    (42 * 1024 + 420) * 1024,
+	    1342172800);
+
+    xo_open_list("flag");
+    xo_gen_emit_23(NULL);
+    xo_close_list("flag");
+
+    xo_gen_emit_24(NULL, NULL);
+
+    xo_gen_emit_25(NULL);
+    xo_gen_emit_26(NULL
+,
+	    6, 1000, 8, 5000, "ten-long", 10, 10, "test");
+    xo_gen_emit_27(NULL);
+    xo_gen_emit_28(NULL, "two", "s" );
+    xo_gen_emit_29(NULL);
+    xo_gen_emit_30(NULL, "two", "s" );
+    xo_gen_emit_31(NULL, "s", 10);
+
+    int test = 4;
+    xo_gen_emit_32(NULL, test, (test == 1) ? "y" : "ies");
+
+    xo_message("improper use of profanity; %s; %s",
+	       "ten yard penalty", "first down");
+
+    xo_error("Shut 'er down, Clancey!  She's a-pumpin' mud!  <>!,\"!<>\n");
+    xo_error("err message (%d)", 1);
+    xo_error("err message (%d)\n", 2);
+    xo_errorn("err message (%d)", 1);
+    xo_errorn("err message (%d)\n", 2);
+
+    xo_close_container("data");
+
+    xo_close_container_h(NULL, "top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_03.c; do not edit.
+ * 7 compiled, 1 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 'V', 0, 0, 0, 2, 10, 3, 5, 9, 3, XO_COMPILED_NONE, 0, 13 },
+    { '+', 0, 0, 0, 13, 0, 13, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 14 },
+    { '\n', 0, 0, 0, 14, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "[{:extra/%*s}]\n",
+    7, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, int a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'T', 0, 0, 0, 1, 7, XO_COMPILED_NONE, 0, 4, 4, XO_COMPILED_NONE, 0, 9 },
+    { '+', 0, 0, 0, 9, 0, 9, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 10 },
+    { 'T', 0, 0, 0, 11, 6, XO_COMPILED_NONE, 0, 14, 3, XO_COMPILED_NONE, 0, 18 },
+    { '+', 0, 0, 0, 18, 0, 18, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 19 },
+    { 'T', 0, 0, 0, 20, 6, XO_COMPILED_NONE, 0, 23, 3, XO_COMPILED_NONE, 0, 27 },
+    { '+', 0, 0, 0, 27, 0, 27, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 28 },
+    { 'T', 0, 0, 0, 29, 6, XO_COMPILED_NONE, 0, 32, 3, XO_COMPILED_NONE, 0, 36 },
+    { '+', 0, 0, 0, 36, 0, 36, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 37 },
+    { 'T', 0, 0, 0, 38, 6, XO_COMPILED_NONE, 0, 41, 3, XO_COMPILED_NONE, 0, 45 },
+    { '+', 0, 0, 0, 45, 0, 45, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 47 },
+    { 'T', 0, 0, 0, 48, 9, 50, 7, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 58 },
+    { '\n', 0, 0, 0, 58, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{T:/%13s} {T:/%5s} {T:/%6s} {T:/%7s} {T:/%8s}  {T:Size(s)}\n",
+    17, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1, const char *a2, const char *a3, const char *a4, const char *a5)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2, a3, a4, a5);
+}
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, const char *a1, unsigned long long a2, unsigned long long a3, const char *a4, unsigned long long a5)
+{
+    return xo_emit_hf(xop, XOEF_RETAIN, "{k:type/%13s} {:in-use/%5" PRIu64 "} " "{:memory-use/%5" PRIu64 "}{U:K} {:high-use/%7s} " "{:requests/%8" PRIu64 "}  ", a1, a2, a3, a4, a5);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    ",",
+    3, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4);
+}
+
+static const xo_compiled_field_t xo_gen_fields_5[] = {
+    { 'V', 0x2000, 0, 0, 1, 9, 3, 4, 8, 2, XO_COMPILED_NONE, 0, 11 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_5 = {
+    XO_COMPILED_VERSION,
+    "{l:size/%d}",
+    5, xo_gen_fields_5
+};
+
+static xo_ssize_t
+xo_gen_emit_5 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_5, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_6[] = {
+    { '\n', 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_6 = {
+    XO_COMPILED_VERSION,
+    "\n",
+    5, xo_gen_fields_6
+};
+
+static xo_ssize_t
+xo_gen_emit_6 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_6);
+}
+
+static const xo_compiled_field_t xo_gen_fields_7[] = {
+    { 'V', 0, 0, 0, 1, 11, 2, 10, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 13 },
+    { '+', 0, 0, 0, 13, 0, 13, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 14 },
+    { 'V', 0, 0, 0, 15, 10, 16, 9, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 26 },
+    { '+', 0, 0, 0, 26, 0, 26, 16, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 42 },
+    { 'V', 0, 0, 0, 43, 14, 44, 10, 55, 2, XO_COMPILED_NONE, 0, 58 },
+    { '\n', 0, 0, 0, 58, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_7 = {
+    XO_COMPILED_VERSION,
+    "{:first-name} {:last-name} works in " "dept #{:department/%u}\n",
+    11, xo_gen_fields_7
+};
+
+static xo_ssize_t
+xo_gen_emit_7 (xo_handle_t *xop, const char *a1, const char *a2, unsigned a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_7, a1, a2, a3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_8[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 4, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 4 },
+    { '\n', 0, 0, 0, 4, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_8 = {
+    XO_COMPILED_VERSION,
+    "done\n",
+    5, xo_gen_fields_8
+};
+
+static xo_ssize_t
+xo_gen_emit_8 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_8);
+}
+
+#line 1 "../../../tests/core/test_03.c"
+/*
+ * Copyright (c) 2014, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2014
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+#include "xo_encoder.h"
+
+xo_info_t info[] = {
+    { "employee", "object", "Employee data" },
+    { "first-name", "string", "First name of employee" },
+    { "last-name", "string", "Last name of employee" },
+    { "department", "number", "Department number" },
+};
+int info_count = (sizeof(info) / sizeof(info[0]));
+
+int
+main (int argc, char **argv)
+{
+    unsigned opt_count = 1;
+    unsigned opt_extra = 0;
+
+    struct employee {
+	const char *e_first;
+	const char *e_last;
+	unsigned e_dept;
+    } employees[] = {
+	{ "Terry", "Jones", 660 },
+	{ "Leslie", "Patterson", 341 },
+	{ "Ashley", "Smith", 1440 },
+	{ NULL, NULL }
+    }, *ep;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    for (argc = 1; argv[argc]; argc++) {
+	if (xo_streq(argv[argc], "count")) {
+	    if (argv[argc + 1])
+		opt_count = atoi(argv[++argc]);
+	} else if (xo_streq(argv[argc], "extra")) {
+	    if (argv[argc + 1])
+		opt_extra = atoi(argv[++argc]);
+	}
+    }
+
+    xo_set_info(NULL, info, info_count);
+
+    xo_open_container("employees");
+    xo_open_list("employee");
+
+    xo_gen_emit_1(NULL, opt_extra, "");
+
+    xo_gen_emit_2(NULL,
+	    "Type", "InUse", "MemUse", "HighUse", "Requests");
+    xo_open_list("memory");
+    xo_open_instance("memory");
+
+#define PRIu64 "llu"
+#define TO_ULL(_x) ((unsigned long long) _x)
+    xo_gen_emit_3(NULL
+
+,
+	    "name", TO_ULL(12345), TO_ULL(54321), "-", TO_ULL(32145));
+
+    int first = 1, i;
+#if 0
+    xo_open_list("size");
+    for (i = 0; i < 32; i++) {
+	if (!first)
+	    xo_gen_emit_4(NULL);
+	xo_gen_emit_5(NULL, 1 << (i + 4));
+	first = 0;
+    }
+    xo_close_list("size");
+#endif
+    xo_close_instance("memory");
+    xo_gen_emit_6(NULL);
+    xo_close_list("memory");
+
+    while (opt_count-- != 0) {
+	for (ep = employees; ep->e_first; ep++) {
+	    xo_open_instance("employee");
+	    xo_gen_emit_7(NULL
+,
+		    ep->e_first, ep->e_last, ep->e_dept);
+	    xo_close_instance("employee");
+	}
+    }
+
+    xo_gen_emit_8(NULL);
+
+    xo_close_list("employee");
+    xo_close_container("employees");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_04.c; do not edit.
+ * 2 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'T', 0, 0, 0, 1, 17, 3, 9, 13, 5, XO_COMPILED_NONE, 0, 19 },
+    { 'T', 0, 0, 0, 20, 18, 22, 10, 33, 5, XO_COMPILED_NONE, 0, 39 },
+    { 'T', 0, 0, 0, 40, 15, 42, 10, 53, 2, XO_COMPILED_NONE, 0, 56 },
+    { '\n', 0, 0, 0, 56, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{T:Last Name/%-12s}{T:First Name/%-14s}{T:Department/%s}\n",
+    11, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0, 0, 0, 1, 20, 2, 10, 13, 5, 19, 2, 22 },
+    { 'V', 0, 0, 0, 23, 19, 24, 9, 34, 5, 40, 2, 43 },
+    { 'V', 0, 0, 0, 44, 18, 45, 10, 56, 3, 60, 2, 63 },
+    { '\n', 0, 0, 0, 63, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{:first-name/%-12s/%s}{:last-name/%-14s/%s}" "{:department/%8u/%u}\n",
+    11, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1, const char *a2, unsigned a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2, a3);
+}
+
+#line 1 "../../../tests/core/test_04.c"
+/*
+ * Copyright (c) 2014, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2014
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+xo_info_t info[] = {
+    { "employee", "object", "Employee data" },
+    { "first-name", "string", "First name of employee" },
+    { "last-name", "string", "Last name of employee" },
+    { "department", "number", "Department number" },
+};
+int info_count = (sizeof(info) / sizeof(info[0]));
+
+int
+main (int argc, char **argv)
+{
+    struct employee {
+	const char *e_first;
+	const char *e_last;
+	unsigned e_dept;
+    } employees[] = {
+	{ "Terry", "Jones", 660 },
+	{ "Leslie", "Patterson", 341 },
+	{ "Ashley", "Smith", 1440 },
+	{ NULL, NULL }
+    }, *ep = employees;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_info(NULL, info, info_count);
+
+    xo_open_container("employees");
+    xo_open_list("employee");
+
+    xo_gen_emit_1(NULL);
+    for ( ; ep->e_first; ep++) {
+	xo_open_instance("employee");
+	xo_gen_emit_2(NULL
+,
+		ep->e_first, ep->e_last, ep->e_dept);
+	xo_close_instance("employee");
+    }
+
+    xo_close_list("employee");
+    xo_close_container("employees");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,544 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_05.c; do not edit.
+ * 20 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'T', 0, 0, 0, 1, 13, 3, 11, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 15 },
+    { '\n', 0, 0, 0, 15, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{T:Sample text}\n",
+    7, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 113, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 113 },
+    { '\n', 0, 0, 0, 113, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "This sample text was taken from the Punjabi Wikipedia " "article on Lahore and transliterated into the Latin script.\n",
+    5, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { 'T', 0, 0, 0, 1, 11, 3, 9, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 13 },
+    { '\n', 0, 0, 0, 13, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "{T:Gurmukhi:}\n",
+    7, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { 'V', 0, 0, 0, 1, 9, 2, 8, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 11 },
+    { '\n', 0, 0, 0, 11, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    "{:gurmukhi}\n",
+    7, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_5[] = {
+    { 'T', 0, 0, 0, 1, 12, 3, 10, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 14 },
+    { '\n', 0, 0, 0, 14, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_5 = {
+    XO_COMPILED_VERSION,
+    "{T:Shahmukhi:}\n",
+    7, xo_gen_fields_5
+};
+
+static xo_ssize_t
+xo_gen_emit_5 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_5);
+}
+
+static const xo_compiled_field_t xo_gen_fields_6[] = {
+    { 'V', 0, 0, 0, 1, 10, 2, 9, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 12 },
+    { '\n', 0, 0, 0, 12, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_6 = {
+    XO_COMPILED_VERSION,
+    "{:shahmukhi}\n",
+    7, xo_gen_fields_6
+};
+
+static xo_ssize_t
+xo_gen_emit_6 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_6, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_7[] = {
+    { 'T', 0, 0, 0, 1, 17, 3, 15, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 19 },
+    { '+', 0, 0, 0, 19, 0, 19, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 20 },
+    { '\n', 0, 0, 0, 20, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_7 = {
+    XO_COMPILED_VERSION,
+    "{T:Transliteration}:\n",
+    7, xo_gen_fields_7
+};
+
+static xo_ssize_t
+xo_gen_emit_7 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_7);
+}
+
+static const xo_compiled_field_t xo_gen_fields_8[] = {
+    { 'V', 0, 0, 0, 1, 15, 2, 14, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 17 },
+    { '\n', 0, 0, 0, 17, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_8 = {
+    XO_COMPILED_VERSION,
+    "{:tranliteration}\n",
+    7, xo_gen_fields_8
+};
+
+static xo_ssize_t
+xo_gen_emit_8 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_8, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_9[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 11, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 11 },
+    { 'V', 0x2010, 0, 0, 12, 21, 15, 2, 18, 15, XO_COMPILED_NONE, 0, 34 },
+    { '\n', 0, 0, 0, 34, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_9 = {
+    XO_COMPILED_VERSION,
+    "Wide char: {lq:wc/%lc - %#lx - %d}\n",
+    7, xo_gen_fields_9
+};
+
+static xo_ssize_t
+xo_gen_emit_9 (xo_handle_t *xop, int a1, unsigned long a2, int a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_9, a1, a2, a3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_10[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 7, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 7 },
+    { 'V', 0, 0, 0, 8, 10, 9, 5, 15, 3, XO_COMPILED_NONE, 0, 19 },
+    { '+', 0, 0, 0, 19, 0, 19, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 20 },
+    { '\n', 0, 0, 0, 20, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_10 = {
+    XO_COMPILED_VERSION,
+    "Cool: [{:fancy/%ls}]\n",
+    7, xo_gen_fields_10
+};
+
+static xo_ssize_t
+xo_gen_emit_10 (xo_handle_t *xop, const wchar_t *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_10, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_11[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 54, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 54 },
+    { 'V', 0, 0, 0, 55, 6, 56, 2, 59, 2, XO_COMPILED_NONE, 0, 62 },
+    { '+', 0, 0, 0, 62, 0, 62, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 64 },
+    { 'V', 0, 0, 0, 65, 6, 66, 2, 69, 2, XO_COMPILED_NONE, 0, 72 },
+    { '\n', 0, 0, 0, 72, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_11 = {
+    XO_COMPILED_VERSION,
+    "Οὐχὶ ταὐτὰ παρίσταταί μοι {:v1/%s}, {:v2/%s}\n",
+    9, xo_gen_fields_11
+};
+
+static xo_ssize_t
+xo_gen_emit_11 (xo_handle_t *xop, const char *a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_11, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_12[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 19, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 19 },
+    { 'V', 0, 0, 0, 20, 6, 21, 2, 24, 2, XO_COMPILED_NONE, 0, 27 },
+    { '+', 0, 0, 0, 27, 0, 27, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 28 },
+    { 'V', 0, 0, 0, 29, 6, 30, 2, 33, 2, XO_COMPILED_NONE, 0, 36 },
+    { '\n', 0, 0, 0, 36, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_12 = {
+    XO_COMPILED_VERSION,
+    "გთხოვთ {:v1/%s} {:v2/%s}\n",
+    9, xo_gen_fields_12
+};
+
+static xo_ssize_t
+xo_gen_emit_12 (xo_handle_t *xop, const char *a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_12, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_13[] = {
+    { 'T', 0x5, 0, 0, 1, 9, 5, 5, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 11 },
+    { 'V', 0, 0, 0, 12, 9, 13, 5, 19, 2, XO_COMPILED_NONE, 0, 22 },
+    { '\n', 0, 0, 0, 22, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_13 = {
+    XO_COMPILED_VERSION,
+    "{Twc:Width}{:width/%d}\n",
+    9, xo_gen_fields_13
+};
+
+static xo_ssize_t
+xo_gen_emit_13 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_13, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_14[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 'V', 0, 0, 0, 2, 8, 3, 7, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 11 },
+    { '+', 0, 0, 0, 11, 0, 11, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 12 },
+    { '\n', 0, 0, 0, 12, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_14 = {
+    XO_COMPILED_VERSION,
+    "[{:sinhala}]\n",
+    7, xo_gen_fields_14
+};
+
+static xo_ssize_t
+xo_gen_emit_14 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_14, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_15[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 'V', 0, 0, 0, 2, 19, 3, 7, 11, 7, 19, 2, 22 },
+    { '+', 0, 0, 0, 22, 0, 22, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 23 },
+    { '\n', 0, 0, 0, 23, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_15 = {
+    XO_COMPILED_VERSION,
+    "[{:sinhala/%-4..4s/%s}]\n",
+    7, xo_gen_fields_15
+};
+
+static xo_ssize_t
+xo_gen_emit_15 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_15, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_16[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 'V', 0, 0, 0, 2, 23, 3, 11, 15, 7, 23, 2, 26 },
+    { '+', 0, 0, 0, 26, 0, 26, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 27 },
+    { '\n', 0, 0, 0, 27, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_16 = {
+    XO_COMPILED_VERSION,
+    "[{:not-sinhala/%-4..4s/%s}]\n",
+    7, xo_gen_fields_16
+};
+
+static xo_ssize_t
+xo_gen_emit_16 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_16, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_17[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 'V', 0, 0, 0, 2, 7, 3, 3, 7, 2, XO_COMPILED_NONE, 0, 10 },
+    { '+', 0, 0, 0, 10, 0, 10, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 11 },
+    { '\n', 0, 0, 0, 11, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_17 = {
+    XO_COMPILED_VERSION,
+    "[{:tag/%s}]\n",
+    7, xo_gen_fields_17
+};
+
+static xo_ssize_t
+xo_gen_emit_17 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_17, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_18[] = {
+    { 'T', 0, 0, 0, 1, 18, 3, 10, 14, 5, XO_COMPILED_NONE, 0, 20 },
+    { 'T', 0, 0, 0, 21, 17, 23, 9, 33, 5, XO_COMPILED_NONE, 0, 39 },
+    { 'T', 0, 0, 0, 40, 8, XO_COMPILED_NONE, 0, 43, 5, XO_COMPILED_NONE, 0, 49 },
+    { 'T', 0, 0, 0, 50, 10, 52, 8, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 61 },
+    { '\n', 0, 0, 0, 61, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_18 = {
+    XO_COMPILED_VERSION,
+    "{T:First Name/%-25s}{T:Last Name/%-14s}" "{T:/%-12s}{T:Time (%)}\n",
+    13, xo_gen_fields_18
+};
+
+static xo_ssize_t
+xo_gen_emit_18 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_18, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_19[] = {
+    { '[', 0, 0, 0, 1, 5, 3, 3, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 7 },
+    { 'V', 0, 0, 0, 8, 14, 9, 10, 20, 2, XO_COMPILED_NONE, 0, 23 },
+    { '+', 0, 0, 0, 23, 0, 23, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 25 },
+    { 'V', 0, 0, 0, 26, 14, 27, 8, 36, 4, XO_COMPILED_NONE, 0, 41 },
+    { '+', 0, 0, 0, 41, 0, 41, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 42 },
+    { ']', 0, 0, 0, 43, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 46 },
+    { 'V', 0, 0, 0, 47, 23, 48, 9, 58, 9, 68, 2, 71 },
+    { 'V', 0, 0, 0, 72, 15, 73, 10, 84, 3, XO_COMPILED_NONE, 0, 88 },
+    { 'V', 0, 0, 0, 89, 17, 90, 12, 103, 3, XO_COMPILED_NONE, 0, 107 },
+    { '\n', 0, 0, 0, 107, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_19 = {
+    XO_COMPILED_VERSION,
+    "{[:-25}{:first-name/%s} ({:nic-name/\"%s\"}){]:}" "{:last-name/%-14..14s/%s}" "{:department/%8u}{:percent-time/%8u}\n",
+    19, xo_gen_fields_19
+};
+
+static xo_ssize_t
+xo_gen_emit_19 (xo_handle_t *xop, const char *a1, const char *a2, const char *a3, unsigned a4, unsigned a5)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_19, a1, a2, a3, a4, a5);
+}
+
+static const xo_compiled_field_t xo_gen_fields_20[] = {
+    { 'V', 0x8, 0, 0, 1, 13, 3, 8, 12, 2, XO_COMPILED_NONE, 0, 15 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_20 = {
+    XO_COMPILED_VERSION,
+    "{e:benefits/%s}",
+    5, xo_gen_fields_20
+};
+
+static xo_ssize_t
+xo_gen_emit_20 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_20, a1);
+}
+
+#line 1 "../../../tests/core/test_05.c"
+/*
+ * Copyright (c) 2014, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2014
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "xo.h"
+#include "xo_config.h"
+
+#ifdef LIBXO_WCWIDTH
+#include "xo_wcwidth.h"
+#else /* LIBXO_WCWIDTH */
+#define xo_wcwidth(_x) wcwidth(_x)
+#endif /* LIBXO_WCWIDTH */
+
+xo_info_t info[] = {
+    { "employee", "object", "Employee data" },
+    { "first-name", "string", "First name of employee" },
+    { "last-name", "string", "Last name of employee" },
+    { "department", "number", "Department number" },
+    { "percent-time", "number", "Percentage of full & part time (%)" },
+};
+int info_count = (sizeof(info) / sizeof(info[0]));
+
+int
+main (int argc, char **argv)
+{
+    struct employee {
+	const char *e_first;
+	const char *e_nic;
+	const char *e_last;
+	unsigned e_dept;
+	unsigned e_percent;
+    } employees[] = {
+	{ "Jim", "რეგტ", "გთხოვთ ახ", 431, 90 },
+	{ "Terry", "<one", "Οὐχὶ ταὐτὰ παρίσταταί μοι Jones", 660, 90 },
+	{ "Leslie", "Les", "Patterson", 341,60 },
+	{ "Ashley", "Ash", "Meter & Smith", 1440, 40 },
+	{ "0123456789", "0123456789", "012345678901234567890", 1440, 40 },
+	{ "ახლა", "გაიარო", "საერთაშორისო", 123, 90 },
+	{ "෴ණ්ණ෴෴ණ්ණ෴", "Mick",
+	  "෴ණ්ණ෴෴ණ්ණ෴෴ණ්ණ෴෴෴", 110, 20 },
+	{ NULL, NULL }
+    }, *ep = employees;
+    int rc, i;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_info(NULL, info, info_count);
+    xo_set_flags(NULL, XOF_COLUMNS);
+
+    xo_open_container("indian-languages");
+    
+    xo_gen_emit_1(NULL);
+    xo_gen_emit_2(NULL
+);
+
+    xo_gen_emit_3(NULL);
+    xo_gen_emit_4(NULL,
+	    "ਲਹੌਰ ਪਾਕਿਸਤਾਨੀ ਪੰਜਾਬ ਦੀ ਰਾਜਧਾਨੀ ਹੈ । ਲੋਕ ਗਿਣਤੀ ਦੇ ਨਾਲ ਕਰਾਚੀ ਤੋਂ ਬਾਅਦ ਲਹੌਰ ਦੂਜਾ ਸਭ ਤੋਂ ਵੱਡਾ ਸ਼ਹਿਰ ਹੈ । ਲਹੌਰ ਪਾਕਿਸਤਾਨ ਦਾ ਸਿਆਸੀ, ਰਹਤਲੀ ਤੇ ਪੜ੍ਹਾਈ ਦਾ ਗੜ੍ਹ ਹੈ ਅਤੇ ਇਸ ਲਈ ਇਹਨੂੰ ਪਾਕਿਸਤਾਨ ਦਾ ਦਿਲ ਵੀ ਕਿਹਾ ਜਾਂਦਾ ਹੈ । ਲਹੌਰ ਦਰਿਆ-ਏ-ਰਾਵੀ ਦੇ ਕੰਢੇ ਤੇ ਵਸਦਾ ਹੈ ਤੇ ਇਸਦੀ ਲੋਕ ਗਿਣਤੀ ਇੱਕ ਕਰੋੜ ਦੇ ਨੇੜੇ ਹੈ ।");
+
+
+    xo_gen_emit_5(NULL);
+    xo_gen_emit_6(NULL,
+	    "لہور پاکستانی پنجاب دا دارالحکومت اے۔ لوک گنتی دے نال کراچی توں بعد لہور دوجا سبھ توں وڈا شہر اے۔ لہور پاکستان دا سیاسی، رہتلی تے پڑھائی دا گڑھ اے تے اس لئی ایھنوں پاکستان دا دل وی کیھا جاندا اے۔ لہور دریاۓ راوی دے کنڈھے تے وسدا اے اسدی لوک گنتی اک کروڑ دے نیڑے اے ۔");
+
+    xo_gen_emit_7(NULL);
+    xo_gen_emit_8(NULL,
+	    "lahor pākistān panjāb dā dārul hakūmat ē. lōk giṇtī dē nāḷ karācī tō᷈ bāad lahor dūjā sab tō᷈ vaḍḍā shahr ē. lahor pākistān dā siāsī, rahtalī tē paṛā̀ī dā gā́ṛ ē tē is laī ihnū᷈ pākistān dā dil vī kehā jāndā ē. lahor dariāē rāvī dē kanḍē tē vasdā ē. isdī lōk giṇtī ikk karōṛ dē nēṛē ē.");
+
+    xo_close_container("indian-languages");
+
+    xo_open_container("employees");
+
+    wchar_t wc[] = { L'෴', L'ණ', L'්', L'ණ', 0x17D2, L'෴', 0 };
+    for (i = 0; wc[i]; i++)
+	xo_gen_emit_9(NULL,
+		wc[i], (unsigned long) wc[i], xo_wcwidth(wc[i]));
+
+    wchar_t msg[] = { L'1', 0x034f, L'2', 0x20dd, 0 };
+    for (i = 0; msg[i]; i++)
+	xo_gen_emit_9(NULL,
+		msg[i], (unsigned long) msg[i], xo_wcwidth((int) msg[i]));
+    xo_gen_emit_10(NULL, msg);
+
+    xo_gen_emit_11(NULL,
+	    "γιγνώσκειν", "ὦ ἄνδρες ᾿Αθηναῖοι");
+
+    rc = xo_gen_emit_12(NULL,
+	    "ახლავე გაიაროთ რეგისტრაცია",
+	    "Unicode-ის მეათე საერთაშორისო");
+    xo_gen_emit_13(NULL, rc);
+
+    /* Okay, Sinhala is uber cool ... */
+    rc = xo_gen_emit_14(NULL, "෴ණ්ණ෴");
+    xo_gen_emit_13(NULL, rc);
+
+    rc = xo_gen_emit_14(NULL, "෴");
+    xo_gen_emit_13(NULL, rc);
+
+    rc = xo_gen_emit_15(NULL, "෴ණ්ණ෴෴ණ්ණ෴");
+    xo_gen_emit_13(NULL, rc);
+
+    xo_gen_emit_16(NULL, "123456");
+
+    rc = xo_gen_emit_17(NULL, "ර්‍ඝ");
+    xo_gen_emit_13(NULL, rc);
+
+    xo_open_list("employee");
+
+    xo_gen_emit_18(NULL
+, "Department");
+    for ( ; ep->e_first; ep++) {
+	xo_open_instance("employee");
+	xo_gen_emit_19(NULL
+
+,
+		ep->e_first, ep->e_nic, ep->e_last, ep->e_dept, ep->e_percent);
+	if (ep->e_percent > 50) {
+	    xo_attr("full-time", "%s", "honest & for true");
+	    xo_gen_emit_20(NULL, "full");
+	}
+	xo_close_instance("employee");
+    }
+
+    xo_close_list("employee");
+    xo_close_container("employees");
+
+    xo_finish();
+
+    return 0;
+}
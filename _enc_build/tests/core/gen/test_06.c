@@ -0,0 +1,97 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_06.c; do not edit.
+ * 1 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'V', 0, 0, 0, 1, 11, 2, 10, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 13 },
+    { '+', 0, 0, 0, 13, 0, 13, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 14 },
+    { 'V', 0, 0, 0, 15, 10, 16, 9, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 26 },
+    { '+', 0, 0, 0, 26, 0, 26, 16, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 42 },
+    { 'V', 0, 0, 0, 43, 14, 44, 10, 55, 2, XO_COMPILED_NONE, 0, 58 },
+    { '\n', 0, 0, 0, 58, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{:first-name} {:last-name} works in dept #{:department/%u}\n",
+    11, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, const char *a1, const char *a2, unsigned a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1, a2, a3);
+}
+
+#line 1 "../../../tests/core/test_06.c"
+/*
+ * Copyright (c) 2014, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2014
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+xo_info_t info[] = {
+    { "employee", "object", "Employee data" },
+    { "first-name", "string", "First name of employee" },
+    { "last-name", "string", "Last name of employee" },
+    { "department", "number", "Department number" },
+};
+int info_count = (sizeof(info) / sizeof(info[0]));
+
+int
+main (int argc, char **argv)
+{
+    struct employee {
+	const char *e_first;
+	const char *e_last;
+	unsigned e_dept;
+    } employees[] = {
+	{ "Terry", "Jones", 660 },
+	{ "Leslie", "Patterson", 341 },
+	{ "Ashley", "Smith", 1440 },
+	{ NULL, NULL }
+    }, *ep = employees;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_info(NULL, info, info_count);
+
+    xo_set_flags(NULL, XOF_DTRT);
+
+    xo_open_container("employees");
+    xo_open_list("employee");
+
+    for ( ; ep->e_first; ep++) {
+	xo_open_instance("employee");
+	xo_gen_emit_1(NULL,
+		ep->e_first, ep->e_last, ep->e_dept);
+	xo_close_instance_d();
+    }
+
+    xo_close_list_d();
+    xo_close_container_d();
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_07.c; do not edit.
+ * 7 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'V', 0x88, 0, 0, 1, 14, 4, 8, 13, 2, XO_COMPILED_NONE, 0, 16 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{ek:filename/%s}",
+    5, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 54, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 54 },
+    { 'V', 0, 0, 0, 55, 6, 56, 2, 59, 2, XO_COMPILED_NONE, 0, 62 },
+    { '+', 0, 0, 0, 62, 0, 62, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 64 },
+    { 'V', 0, 0, 0, 65, 6, 66, 2, 69, 2, XO_COMPILED_NONE, 0, 72 },
+    { '\n', 0, 0, 0, 72, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "Οὐχὶ ταὐτὰ παρίσταταί μοι {:v1/%s}, {:v2/%s}\n",
+    9, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { 'V', 0, 0, 0, 1, 11, 2, 7, 10, 2, XO_COMPILED_NONE, 0, 13 },
+    { '\n', 0, 0, 0, 13, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "{:columns/%d}\n",
+    7, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 19, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 19 },
+    { 'V', 0, 0, 0, 20, 6, 21, 2, 24, 2, XO_COMPILED_NONE, 0, 27 },
+    { '+', 0, 0, 0, 27, 0, 27, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 28 },
+    { 'V', 0, 0, 0, 29, 6, 30, 2, 33, 2, XO_COMPILED_NONE, 0, 36 },
+    { '\n', 0, 0, 0, 36, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    "გთხოვთ {:v1/%s} {:v2/%s}\n",
+    9, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop, const char *a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_5[] = {
+    { 'T', 0, 0, 0, 1, 18, 3, 10, 14, 5, XO_COMPILED_NONE, 0, 20 },
+    { 'T', 0, 0, 0, 21, 17, 23, 9, 33, 5, XO_COMPILED_NONE, 0, 39 },
+    { 'T', 0, 0, 0, 40, 8, XO_COMPILED_NONE, 0, 43, 5, XO_COMPILED_NONE, 0, 49 },
+    { 'T', 0, 0, 0, 50, 10, 52, 8, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 61 },
+    { '\n', 0, 0, 0, 61, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_5 = {
+    XO_COMPILED_VERSION,
+    "{T:First Name/%-25s}{T:Last Name/%-14s}" "{T:/%-12s}{T:Time (%)}\n",
+    13, xo_gen_fields_5
+};
+
+static xo_ssize_t
+xo_gen_emit_5 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_5, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_6[] = {
+    { '[', 0, 0, 0, 1, 5, 3, 3, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 7 },
+    { 'V', 0, 0, 0, 8, 14, 9, 10, 20, 2, XO_COMPILED_NONE, 0, 23 },
+    { '+', 0, 0, 0, 23, 0, 23, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 25 },
+    { 'V', 0, 0, 0, 26, 14, 27, 8, 36, 4, XO_COMPILED_NONE, 0, 41 },
+    { '+', 0, 0, 0, 41, 0, 41, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 42 },
+    { ']', 0, 0, 0, 43, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 46 },
+    { 'V', 0, 0, 0, 47, 23, 48, 9, 58, 9, 68, 2, 71 },
+    { 'V', 0, 0, 0, 72, 18, 73, 10, 84, 3, 88, 2, 91 },
+    { 'V', 0, 0, 0, 92, 20, 93, 12, 106, 3, 110, 2, 113 },
+    { '\n', 0, 0, 0, 113, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_6 = {
+    XO_COMPILED_VERSION,
+    "{[:-25}{:first-name/%s} ({:nic-name/\"%s\"}){]:}" "{:last-name/%-14..14s/%s}" "{:department/%8u/%u}{:percent-time/%8u/%u}\n",
+    19, xo_gen_fields_6
+};
+
+static xo_ssize_t
+xo_gen_emit_6 (xo_handle_t *xop, const char *a1, const char *a2, const char *a3, unsigned a4, unsigned a5)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_6, a1, a2, a3, a4, a5);
+}
+
+static const xo_compiled_field_t xo_gen_fields_7[] = {
+    { 'V', 0x8, 0, 0, 1, 13, 3, 8, 12, 2, XO_COMPILED_NONE, 0, 15 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_7 = {
+    XO_COMPILED_VERSION,
+    "{e:benefits/%s}",
+    5, xo_gen_fields_7
+};
+
+static xo_ssize_t
+xo_gen_emit_7 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_7, a1);
+}
+
+#line 1 "../../../tests/core/test_07.c"
+/*
+ * Copyright (c) 2014, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2014
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+xo_info_t info[] = {
+    { "employee", "object", "Employee data" },
+    { "first-name", "string", "First name of employee" },
+    { "last-name", "string", "Last name of employee" },
+    { "department", "number", "Department number" },
+    { "percent-time", "number", "Percentage of full & part time (%)" },
+};
+int info_count = (sizeof(info) / sizeof(info[0]));
+
+int
+main (int argc, char **argv)
+{
+    struct employee {
+	const char *e_first;
+	const char *e_nic;
+	const char *e_last;
+	unsigned e_dept;
+	unsigned e_percent;
+    } employees[] = {
+	{ "Jim", "რეგტ", "გთხოვთ ახ", 431, 90 },
+	{ "Terry", "<one", "Οὐχὶ ταὐτὰ παρίσταταί μοι Jones", 660, 90 },
+	{ "Leslie", "Les", "Patterson", 341,60 },
+	{ "Ashley", "Ash", "Meter & Smith", 1440, 40 },
+	{ "0123456789", "0123456789", "012345678901234567890", 1440, 40 },
+	{ "ახლა", "გაიარო", "საერთაშორისო", 123, 90 },
+	{ NULL, NULL }
+    }, *ep = employees;
+    int rc;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_info(NULL, info, info_count);
+    xo_set_flags(NULL, XOF_COLUMNS);
+
+    xo_open_container("employees");
+
+    xo_open_list("test");
+    xo_open_instance("test");
+    xo_gen_emit_1(NULL, NULL);
+    xo_close_instance("test");
+    xo_close_list("test");
+
+    rc = xo_gen_emit_2(NULL,
+	    "γιγνώσκειν", "ὦ ἄνδρες ᾿Αθηναῖοι");
+    rc = xo_gen_emit_3(NULL, rc);
+    xo_gen_emit_3(NULL, rc);
+
+    rc = xo_gen_emit_4(NULL,
+	    "ახლავე გაიაროთ რეგისტრაცია",
+	    "Unicode-ის მეათე საერთაშორისო");
+    xo_gen_emit_3(NULL, rc);
+
+
+    rc = xo_gen_emit_5(NULL
+, "Department");
+    xo_gen_emit_3(NULL, rc);
+
+    xo_open_list("employee");
+    for ( ; ep->e_first; ep++) {
+	xo_open_instance("employee");
+	rc = xo_gen_emit_6(NULL
+
+,
+		ep->e_first, ep->e_nic, ep->e_last, ep->e_dept, ep->e_percent);
+	xo_gen_emit_3(NULL, rc);
+	if (ep->e_percent > 50) {
+	    xo_attr("full-time", "%s", "honest & for true");
+	    xo_gen_emit_7(NULL, "full");
+	}
+	xo_close_instance("employee");
+    }
+
+    xo_close_list("employee");
+    xo_close_container("employees");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,283 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_08.c; do not edit.
+ * 6 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'T', 0, 0, 0, 1, 12, 3, 4, 8, 5, XO_COMPILED_NONE, 0, 14 },
+    { 'T', 0, 0, 0, 15, 12, 17, 5, 23, 4, XO_COMPILED_NONE, 0, 28 },
+    { '\n', 0, 0, 0, 28, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{T:Item/%-10s}{T:Count/%12s}\n",
+    9, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0x80, 0, 0, 1, 15, 3, 4, 8, 5, 14, 2, 17 },
+    { 'V', 0x20, 0, 0, 18, 15, 20, 5, 26, 4, 31, 2, 34 },
+    { '\n', 0, 0, 0, 34, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{k:name/%-10s/%s}{n:count/%12u/%u}\n",
+    9, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1, unsigned a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { '\n', 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { '\n', 0, 0, 0, 1, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "\n\n",
+    7, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { 'V', 0, 0, 0, 1, 5, 2, 4, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 7 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    "{:test}",
+    5, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_5[] = {
+    { 'L', 0x5, 0, 0, 1, 9, XO_COMPILED_NONE, 0, 6, 4, XO_COMPILED_NONE, 0, 11 },
+    { 'V', 0, 0, 0, 12, 8, 13, 4, 18, 2, XO_COMPILED_NONE, 0, 21 },
+    { '+', 0, 0, 0, 21, 0, 21, 7, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 28 },
+    { 'V', 0, 0, 0, 29, 8, 30, 4, 35, 2, XO_COMPILED_NONE, 0, 38 },
+    { '\n', 0, 0, 0, 38, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_5 = {
+    XO_COMPILED_VERSION,
+    "{Lwc:/Name}{:name/%d} + 1 = {:next/%d}\n",
+    11, xo_gen_fields_5
+};
+
+static xo_ssize_t
+xo_gen_emit_5 (xo_handle_t *xop, int a1, int a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_5, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_6[] = {
+    { 'L', 0x5, 0, 0, 1, 9, XO_COMPILED_NONE, 0, 6, 4, XO_COMPILED_NONE, 0, 11 },
+    { 'V', 0, 0, 0, 12, 8, 13, 4, 18, 2, XO_COMPILED_NONE, 0, 21 },
+    { '\n', 0, 0, 0, 21, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_6 = {
+    XO_COMPILED_VERSION,
+    "{Lwc:/Last}{:last/%d}\n",
+    9, xo_gen_fields_6
+};
+
+static xo_ssize_t
+xo_gen_emit_6 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_6, a1);
+}
+
+#line 1 "../../../tests/core/test_08.c"
+/*
+ * Copyright (c) 2015, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2015
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "xo.h"
+#include "xo_encoder.h"
+
+int
+main (int argc, char **argv)
+{
+    struct item {
+	const char *i_title;
+	int i_count;
+    };
+    struct item list[] = {
+	{ "gum", 1412 },
+	{ "rope", 85 },
+	{ "ladder", 0 },
+	{ "bolt", 4123 },
+	{ "water", 17 },
+	{ NULL, 0 }
+    };
+    struct item *ip;
+    int i;
+    
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    for (argc = 1; argv[argc]; argc++) {
+	if (xo_streq(argv[argc], "xml"))
+	    xo_set_style(NULL, XO_STYLE_XML);
+	else if (xo_streq(argv[argc], "json"))
+	    xo_set_style(NULL, XO_STYLE_JSON);
+	else if (xo_streq(argv[argc], "text"))
+	    xo_set_style(NULL, XO_STYLE_TEXT);
+	else if (xo_streq(argv[argc], "html"))
+	    xo_set_style(NULL, XO_STYLE_HTML);
+	else if (xo_streq(argv[argc], "pretty"))
+	    xo_set_flags(NULL, XOF_PRETTY);
+	else if (xo_streq(argv[argc], "xpath"))
+	    xo_set_flags(NULL, XOF_XPATH);
+	else if (xo_streq(argv[argc], "info"))
+	    xo_set_flags(NULL, XOF_INFO);
+        else if (xo_streq(argv[argc], "error")) {
+            close(-1);
+            xo_err(1, "error detected");
+        }
+    }
+
+    xo_set_flags(NULL, XOF_KEYS);
+    xo_set_program("test");
+
+    xo_open_container_h(NULL, "top");
+
+    xo_open_container("data");
+    xo_open_container("contents");
+    xo_open_list("item");
+
+    xo_gen_emit_1(NULL);
+
+    for (ip = list; ip->i_title; ip++) {
+	xo_open_instance("item");
+
+	xo_gen_emit_2(NULL,
+		ip->i_title, ip->i_count);
+
+	xo_close_instance("item");
+    }
+
+    xo_close_list("item");
+    xo_close_container("contents");
+    xo_close_container("data");
+
+    xo_gen_emit_3(NULL);
+
+    xo_open_container("data2");
+    xo_open_container("contents");
+
+    xo_gen_emit_1(NULL);
+
+    for (ip = list; ip->i_title; ip++) {
+	xo_open_instance("item");
+
+	xo_gen_emit_2(NULL,
+		ip->i_title, ip->i_count);
+    }
+
+    xo_close_container("data2");
+
+    xo_gen_emit_3(NULL);
+
+    xo_open_container("data3");
+    xo_open_marker("m1");
+    xo_open_container("contents");
+
+    xo_gen_emit_1(NULL);
+
+    for (ip = list; ip->i_title; ip++) {
+	xo_open_instance("item");
+
+	xo_gen_emit_2(NULL,
+		ip->i_title, ip->i_count);
+    }
+
+    xo_close_container("data3");	/* warn: fails at marker 'm1' */
+    xo_gen_emit_4(NULL, "one");
+
+    xo_close_marker("m1");
+    xo_close_container("data3");	/* this one works, post-marker */
+
+    xo_gen_emit_3(NULL);
+
+    xo_open_container("data4");
+    xo_open_marker("m1");
+    xo_open_container("contents");
+
+    xo_gen_emit_1(NULL);
+
+    for (ip = list; ip->i_title; ip++) {
+	xo_open_instance("item");
+
+	xo_gen_emit_2(NULL,
+		ip->i_title, ip->i_count);
+	
+	xo_open_marker("m2");
+	for (i = 0; i < 3; i++) {
+	    xo_open_instance("sub");
+	    xo_gen_emit_5(NULL, i, i + 1);
+	    xo_close_container("data4"); /* warn: fails at marker 'm2' */
+	}
+	xo_close_marker("m2");
+	xo_gen_emit_6(NULL, i);
+    }
+
+    xo_close_container("data4");	/* warn: fails at marker 'm1' */
+    xo_gen_emit_4(NULL, "one");
+
+    xo_gen_emit_3(NULL);
+
+    xo_close_container_h(NULL, "top");
+
+    xo_finish();
+
+    return 0;
+}
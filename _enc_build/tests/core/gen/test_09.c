@@ -0,0 +1,291 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_09.c; do not edit.
+ * 9 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'T', 0, 0, 0, 1, 12, 3, 4, 8, 5, XO_COMPILED_NONE, 0, 14 },
+    { 'T', 0, 0, 0, 15, 12, 17, 5, 23, 4, XO_COMPILED_NONE, 0, 28 },
+    { '\n', 0, 0, 0, 28, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{T:Item/%-10s}{T:Count/%12s}\n",
+    9, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 6 },
+    { 'V', 0x2000, 0, 0, 7, 15, 9, 4, 14, 5, 20, 2, 23 },
+    { '\n', 0, 0, 0, 23, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "Name: {l:name/%-10s/%s}\n",
+    7, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { '\n', 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { '\n', 0, 0, 0, 1, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "\n\n",
+    7, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 6 },
+    { 'V', 0x2000, 0, 0, 7, 15, 9, 4, 14, 5, 20, 2, 23 },
+    { '\n', 0, 0, 0, 23, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    "Name: {l:item/%-10s/%s}\n",
+    7, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_5[] = {
+    { 'T', 0, 0, 0, 1, 12, 3, 4, 8, 5, XO_COMPILED_NONE, 0, 14 },
+    { 'T', 0, 0, 0, 15, 12, 17, 5, 23, 4, XO_COMPILED_NONE, 0, 28 },
+    { '\n', 0, 0, 0, 28, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_5 = {
+    XO_COMPILED_VERSION,
+    "{T:Test/%-10s}{T:Three/%12s}\n",
+    9, xo_gen_fields_5
+};
+
+static xo_ssize_t
+xo_gen_emit_5 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_5);
+}
+
+static const xo_compiled_field_t xo_gen_fields_6[] = {
+    { 'L', 0x5, 0, 0, 1, 11, XO_COMPILED_NONE, 0, 6, 6, XO_COMPILED_NONE, 0, 13 },
+    { 'V', 0, 0, 0, 14, 6, 15, 5, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 21 },
+    { '\n', 0, 0, 0, 21, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_6 = {
+    XO_COMPILED_VERSION,
+    "{Lwc:/Total:}{:total}\n",
+    9, xo_gen_fields_6
+};
+
+static xo_ssize_t
+xo_gen_emit_6 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_6, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_7[] = {
+    { 'V', 0, 0, 0, 1, 4, 2, 3, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 6 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_7 = {
+    XO_COMPILED_VERSION,
+    "{:one}",
+    5, xo_gen_fields_7
+};
+
+static xo_ssize_t
+xo_gen_emit_7 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_7, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_8[] = {
+    { 'V', 0x2000, 0, 0, 1, 5, 3, 3, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 7 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_8 = {
+    XO_COMPILED_VERSION,
+    "{l:two}",
+    5, xo_gen_fields_8
+};
+
+static xo_ssize_t
+xo_gen_emit_8 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_8, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_9[] = {
+    { 'V', 0, 0, 0, 1, 6, 2, 5, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 8 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_9 = {
+    XO_COMPILED_VERSION,
+    "{:three}",
+    5, xo_gen_fields_9
+};
+
+static xo_ssize_t
+xo_gen_emit_9 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_9, a1);
+}
+
+#line 1 "../../../tests/core/test_09.c"
+/*
+ * Copyright (c) 2015, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2015
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "xo.h"
+#include "xo_encoder.h"
+
+int
+main (int argc, char **argv)
+{
+    struct item {
+	const char *i_title;
+	int i_count;
+    };
+    struct item list[] = {
+	{ "gum", 1412 },
+	{ "rope", 85 },
+	{ "ladder", 0 },
+	{ "bolt", 4123 },
+	{ "water", 17 },
+	{ NULL, 0 }
+    };
+    struct item *ip;
+    int i;
+    
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    for (argc = 1; argv[argc]; argc++) {
+	if (xo_streq(argv[argc], "xml"))
+	    xo_set_style(NULL, XO_STYLE_XML);
+	else if (xo_streq(argv[argc], "json"))
+	    xo_set_style(NULL, XO_STYLE_JSON);
+	else if (xo_streq(argv[argc], "text"))
+	    xo_set_style(NULL, XO_STYLE_TEXT);
+	else if (xo_streq(argv[argc], "html"))
+	    xo_set_style(NULL, XO_STYLE_HTML);
+	else if (xo_streq(argv[argc], "pretty"))
+	    xo_set_flags(NULL, XOF_PRETTY);
+	else if (xo_streq(argv[argc], "xpath"))
+	    xo_set_flags(NULL, XOF_XPATH);
+	else if (xo_streq(argv[argc], "info"))
+	    xo_set_flags(NULL, XOF_INFO);
+        else if (xo_streq(argv[argc], "error")) {
+            close(-1);
+            xo_err(1, "error detected");
+        }
+    }
+
+    xo_set_flags(NULL, XOF_KEYS);
+    xo_set_program("test");
+
+    xo_open_container_h(NULL, "top");
+
+    xo_open_container("data");
+    xo_open_container("contents");
+
+    xo_gen_emit_1(NULL);
+
+    for (ip = list; ip->i_title; ip++) {
+	xo_gen_emit_2(NULL, ip->i_title);
+    }
+
+    xo_close_container("contents");
+
+    xo_gen_emit_3(NULL);
+    xo_open_container("contents");
+
+    xo_gen_emit_1(NULL);
+
+    for (ip = list; ip->i_title; ip++) {
+	xo_gen_emit_4(NULL, ip->i_title);
+    }
+
+    xo_close_container("contents");
+
+    xo_gen_emit_3(NULL);
+
+    xo_open_container("contents");
+    xo_gen_emit_5(NULL);
+
+    xo_open_list("item");
+    for (ip = list; ip->i_title; ip++) {
+	xo_gen_emit_4(NULL, ip->i_title);
+    }
+    xo_gen_emit_6(NULL, "six");
+
+    xo_gen_emit_7(NULL, "one");
+    xo_gen_emit_8(NULL, "two");
+    xo_gen_emit_9(NULL, "three");
+
+
+    xo_close_container("contents");
+
+    xo_gen_emit_3(NULL);
+
+    xo_close_container_h(NULL, "top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_12.c; do not edit.
+ * 3 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'C', 0, 0, 0, 1, 17, 3, 15, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 19 },
+    { '+', 0, 0, 0, 19, 0, 19, 12, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 31 },
+    { 'C', 0, 0, 0, 32, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 35 },
+    { '\n', 0, 0, 0, 35, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{C:fg-red,bg-green}Merry XMas!!{C:}\n",
+    9, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 4, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 4 },
+    { 'C', 0, 0, 0, 5, 19, 7, 17, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 25 },
+    { 'V', 0, 0, 0, 26, 7, 27, 6, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 34 },
+    { 'C', 0, 0, 0, 35, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 38 },
+    { '+', 0, 0, 0, 38, 0, 38, 6, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 44 },
+    { 'C', 0, 0, 0, 45, 20, 47, 18, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 66 },
+    { 'V', 0, 0, 0, 67, 7, 68, 6, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 75 },
+    { 'C', 0, 0, 0, 76, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 79 },
+    { '\n', 0, 0, 0, 79, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "One {C:fg-yellow,bg-blue}{:animal}{C:}, " "Two {C:fg-green,bg-yellow}{:animal}{C:}\n",
+    17, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 9, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 9 },
+    { 'V', 0, 0, 0, 10, 4, 11, 3, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 15 },
+    { '+', 0, 0, 0, 15, 0, 15, 4, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 19 },
+    { 'V', 0, 0, 0, 20, 8, 21, 7, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 29 },
+    { '\n', 0, 0, 0, 29, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "There is {:4x4} in {:2morrow}\n",
+    9, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, const char *a1, const char *a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3, a1, a2);
+}
+
+#line 1 "../../../tests/core/test_12.c"
+/*
+ * Copyright (c) 2014, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ * Phil Shafer, July 2014
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xo_config.h"
+#include "xo.h"
+#include "xo_encoder.h"
+
+int
+main (int argc, char **argv)
+{
+    int i, count = 10;
+    int mon = 0;
+    xo_emit_flags_t flags = XOEF_RETAIN;
+    int opt_color = 1;
+
+    xo_set_program("test_12");
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    for (argc = 1; argv[argc]; argc++) {
+	if (xo_streq(argv[argc], "xml"))
+	    xo_set_style(NULL, XO_STYLE_XML);
+	else if (xo_streq(argv[argc], "json"))
+	    xo_set_style(NULL, XO_STYLE_JSON);
+	else if (xo_streq(argv[argc], "text"))
+	    xo_set_style(NULL, XO_STYLE_TEXT);
+	else if (xo_streq(argv[argc], "html"))
+	    xo_set_style(NULL, XO_STYLE_HTML);
+	else if (xo_streq(argv[argc], "no-color"))
+	    opt_color = 0;
+	else if (xo_streq(argv[argc], "pretty"))
+	    xo_set_flags(NULL, XOF_PRETTY);
+	else if (xo_streq(argv[argc], "xpath"))
+	    xo_set_flags(NULL, XOF_XPATH);
+	else if (xo_streq(argv[argc], "info"))
+	    xo_set_flags(NULL, XOF_INFO);
+	else if (xo_streq(argv[argc], "no-retain"))
+	    flags &= ~XOEF_RETAIN;
+	else if (xo_streq(argv[argc], "big")) {
+	    if (argv[argc + 1])
+		count = atoi(argv[++argc]);
+	}
+    }
+
+    xo_set_flags(NULL, XOF_UNITS); /* Always test w/ this */
+    if (opt_color)
+	xo_set_flags(NULL, XOF_COLOR); /* Force color output */
+    xo_set_file(stdout);
+
+    xo_open_container("top");
+    xo_open_container("data");
+
+    xo_gen_emit_1(NULL);
+
+    xo_gen_emit_2(NULL
+,
+          "fish", "fish");
+
+    const char *fmt1 = "The {C:fg-red}{k:name}{C:reset} is "
+	"{C:/fg-%s}{:color}{C:reset} til {:time/%02d:%02d}\n";
+    const char *fmt2 = "My {C:fg-red}{:hand}{C:reset} hand is "
+	"{C:/fg-%s}{:color}{C:reset} til {:time/%02d:%02d}\n";
+
+    for (i = 0; i < count; i++) {
+	xo_open_instance("thing");
+	xo_emit_f(flags, fmt1, "thing", "green", "green", 2, 15);
+	xo_emit_f(flags, fmt2, "left", "blue", "blue", 3, 45);
+    }
+
+    xo_open_container("2by4");
+    xo_gen_emit_3(NULL, "truck", "tomorrow");
+    xo_close_container("2by4");
+
+
+    xo_close_container("data");
+    xo_close_container_h(NULL, "top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_13.c; do not edit.
+ * 3 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'L', 0, 0, 0, 1, 19, 3, 17, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 21 },
+    { '+', 0, 0, 0, 21, 0, 21, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 23 },
+    { 'V', 0, 0, 0, 24, 10, 25, 6, 32, 2, XO_COMPILED_NONE, 0, 35 },
+    { '\n', 0, 0, 0, 35, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{L:Failed to preload}: {:failed/%d}\n",
+    9, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0x80, 0, 0, 1, 6, 3, 4, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 8 },
+    { '+', 0, 0, 0, 8, 0, 8, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 10 },
+    { 'V', 0, 0, 0, 11, 9, 12, 5, 18, 2, XO_COMPILED_NONE, 0, 21 },
+    { '\n', 0, 0, 0, 21, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{k:name}: {:count/%u}\n",
+    9, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1, unsigned a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { 'L', 0x5, 0, 0, 1, 9, 5, 5, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 11 },
+    { 'V', 0, 0, 0, 12, 9, 13, 5, 19, 2, XO_COMPILED_NONE, 0, 22 },
+    { '+', 0, 0, 0, 22, 0, 22, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 23 },
+    { 'U', 0, 0, 0, 24, 7, 26, 5, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 32 },
+    { '\n', 0, 0, 0, 32, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "{Lwc:Total}{:total/%u} {U:items}\n",
+    11, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, unsigned a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3, a1);
+}
+
+#line 1 "../../../tests/core/test_13.c"
+/*
+ * Copyright (c) 2019, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xo_config.h"
+#include "xo.h"
+
+/*
+ * A table in the style generated by "xolint-c -F".  The last entry
+ * is broken, so the preload reports a failure for it.
+ */
+static const char *xo_format_table[] = {
+    "{T:Item}: {T:Count}\n",
+    "{k:name}: {:count/%u}\n",
+    "{Lwc:Total}{:total/%u} {U:items}\n",
+    "{:broken/%s",
+};
+static unsigned xo_format_count =
+    (sizeof(xo_format_table) / sizeof(xo_format_table[0]));
+
+int
+main (int argc, char **argv)
+{
+    static const char *names[] = { "gum", "rope", "ladder", "bolt" };
+    static unsigned counts[] = { 1412, 85, 0, 4123 };
+    unsigned i, total = 0;
+    int failed;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_flags(NULL, XOF_UNITS);
+
+    failed = xo_retain_preload(NULL, xo_format_table, xo_format_count);
+
+    xo_open_container("top");
+    xo_gen_emit_1(NULL, failed);
+
+    /* A different copy of a preloaded format still finds it */
+    char *title = strdup("{T:Item}: {T:Count}\n");
+    xo_emit(title, "Item", "Count");
+    free(title);
+
+    xo_open_list("item");
+    for (i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+	xo_open_instance("item");
+	xo_gen_emit_2(NULL,
+		  names[i], counts[i]);
+	xo_close_instance("item");
+	total += counts[i];
+    }
+    xo_close_list("item");
+
+    xo_gen_emit_3(NULL, total);
+
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_14.c; do not edit.
+ * 4 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'T', 0, 0, 0, 1, 10, 3, 3, 7, 4, XO_COMPILED_NONE, 0, 12 },
+    { 'T', 0, 0, 0, 13, 11, 15, 6, 22, 2, XO_COMPILED_NONE, 0, 25 },
+    { '\n', 0, 0, 0, 25, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{T:Row/%-6s}{T:Square/%s}\n",
+    9, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0x80, 0, 0, 1, 13, 3, 6, 10, 4, XO_COMPILED_NONE, 0, 15 },
+    { 'V', 0, 0, 0, 16, 10, 17, 6, 24, 2, XO_COMPILED_NONE, 0, 27 },
+    { '\n', 0, 0, 0, 27, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{k:number/%-6d}{:square/%d}\n",
+    9, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, int a1, int a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { '\n', 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 'L', 0, 0, 0, 2, 9, 4, 7, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 12 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "\n{L:Partial}",
+    7, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { 'V', 0, 0, 0, 1, 9, 2, 4, 7, 3, XO_COMPILED_NONE, 0, 11 },
+    { '\n', 0, 0, 0, 11, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    "{:rows/ %d}\n",
+    7, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4, a1);
+}
+
+#line 1 "../../../tests/core/test_14.c"
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test "html-chunk", which groups HTML lines into <template> chunks
+ * for xohtml.js to render on demand.  Other styles are unchanged.
+ */
+int
+main (int argc, char **argv)
+{
+    int i;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_options(NULL, "html-chunk=4");
+
+    xo_open_container("top");
+    xo_gen_emit_1(NULL);
+
+    xo_open_list("row");
+    for (i = 1; i <= 10; i++) {
+	xo_open_instance("row");
+	xo_gen_emit_2(NULL, i, i * i);
+	xo_close_instance("row");
+    }
+    xo_close_list("row");
+
+    xo_gen_emit_3(NULL);
+    xo_gen_emit_4(NULL, 10);
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
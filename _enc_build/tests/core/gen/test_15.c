@@ -0,0 +1,163 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_15.c; do not edit.
+ * 4 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'T', 0, 0, 0, 1, 11, 3, 4, 8, 4, XO_COMPILED_NONE, 0, 13 },
+    { 'T', 0, 0, 0, 14, 9, 16, 3, 20, 3, XO_COMPILED_NONE, 0, 24 },
+    { 'T', 0, 0, 0, 25, 14, 27, 7, 35, 4, XO_COMPILED_NONE, 0, 40 },
+    { '\n', 0, 0, 0, 40, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{T:Name/%-6s}{T:MTU/%6s}{T:Packets/%10s}\n",
+    11, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0x80, 0, 0, 1, 14, 3, 4, 8, 4, 13, 2, 16 },
+    { 'V', 0, 0, 0, 17, 11, 18, 3, 22, 3, 26, 2, 29 },
+    { 'V', 0, 0, 0, 30, 18, 31, 7, 39, 5, 45, 3, 49 },
+    { '\n', 0, 0, 0, 49, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{k:name/%-6s/%s}{:mtu/%6u/%u}{:packets/%10lu/%lu}\n",
+    11, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1, unsigned a2, unsigned long a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2, a3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { 'P', 0, 0, 0, 1, 8, 3, 6, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 10 },
+    { 'L', 0x5, 0, 0, 11, 10, 15, 6, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 22 },
+    { 'V', 0, 0, 0, 23, 12, 24, 7, 32, 3, XO_COMPILED_NONE, 0, 36 },
+    { 'U', 0x4, 0, 0, 37, 10, 40, 7, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 48 },
+    { '\n', 0, 0, 0, 48, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "{P:      }{Lwc:Errors}{:packets/%lu}{Uw:packets}\n",
+    13, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, unsigned long a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { 'L', 0x5, 0, 0, 1, 9, 5, 5, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 11 },
+    { 'V', 0, 0, 0, 12, 9, 13, 5, 19, 2, XO_COMPILED_NONE, 0, 22 },
+    { '\n', 0, 0, 0, 22, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    "{Lwc:Total}{:count/%u}\n",
+    9, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop, unsigned a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4, a1);
+}
+
+#line 1 "../../../tests/core/test_15.c"
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+xo_info_t info[] = {
+    { "name", "string", "Name of the interface" },
+    { "mtu", "number", "Maximum transmission unit" },
+    { "packets", "number", "Packets received" },
+};
+int info_count = (sizeof(info) / sizeof(info[0]));
+
+/*
+ * Test "html-compact" and "html-tags": short class names, XPath
+ * prefixes given once when they change, and a table of tag names.
+ * Other styles are unchanged.
+ */
+int
+main (int argc, char **argv)
+{
+    struct ifdata {
+	const char *if_name;
+	unsigned if_mtu;
+	unsigned long if_packets;
+    } ifdata[] = {
+	{ "em0", 1500, 3021 },
+	{ "em1", 9000, 14 },
+	{ "lo0", 16384, 882 },
+	{ NULL, 0, 0 }
+    }, *ip;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_options(NULL, "html-compact,html-tags");
+    xo_set_info(NULL, info, info_count);
+
+    xo_open_container("interfaces");
+    xo_gen_emit_1(NULL);
+
+    xo_open_list("interface");
+    for (ip = ifdata; ip->if_name; ip++) {
+	xo_open_instance("interface");
+	xo_gen_emit_2(NULL,
+		ip->if_name, ip->if_mtu, ip->if_packets);
+	xo_open_container("errors");
+	xo_gen_emit_3(NULL,
+		ip->if_packets / 100);
+	xo_close_container("errors");
+	xo_close_instance("interface");
+    }
+    xo_close_list("interface");
+
+    xo_gen_emit_4(NULL, 3);
+    xo_close_container("interfaces");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_16.c; do not edit.
+ * 3 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'L', 0, 0, 0, 1, 13, 3, 11, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 15 },
+    { '+', 0, 0, 0, 15, 0, 15, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 17 },
+    { 'V', 0, 0, 0, 18, 15, 19, 11, 31, 2, XO_COMPILED_NONE, 0, 34 },
+    { '\n', 0, 0, 0, 34, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{L:Bad options}: {:bad-options/%s}\n",
+    9, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0, 0, 0, 1, 15, 2, 11, 14, 2, XO_COMPILED_NONE, 0, 17 },
+    { '\n', 0, 0, 0, 17, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{:apply-error/%s}\n",
+    7, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { 'V', 0x80, 0, 0, 1, 14, 3, 9, 13, 2, XO_COMPILED_NONE, 0, 16 },
+    { '+', 0, 0, 0, 16, 0, 16, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 17 },
+    { 'V', 0, 0, 0, 18, 14, 19, 10, 30, 2, XO_COMPILED_NONE, 0, 33 },
+    { 'U', 0, 0, 0, 34, 5, XO_COMPILED_NONE, 0, 37, 2, XO_COMPILED_NONE, 0, 40 },
+    { '\n', 0, 0, 0, 40, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "{k:disk-name/%s} {:free-space/%u}{U:/MB}\n",
+    11, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, const char *a1, unsigned a2)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3, a1, a2);
+}
+
+#line 1 "../../../tests/core/test_16.c"
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test xo_options_parse and xo_options_apply: options parsed once
+ * and applied to a handle, along with the handling of bad input.
+ */
+int
+main (int argc, char **argv)
+{
+    xo_options_t *opts, *bad;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    bad = xo_options_parse("underscores,no-such-option");
+    opts = xo_options_parse("underscores, units,indent=4");
+
+    xo_open_container("top");
+
+    xo_gen_emit_1(NULL,
+	    bad ? "parsed" : "rejected");
+
+    if (xo_options_apply(NULL, opts) < 0)
+	xo_gen_emit_2(NULL, "failed");
+
+    xo_open_list("disk");
+    xo_open_instance("disk");
+    xo_gen_emit_3(NULL, "ada0", 4096);
+    xo_close_instance("disk");
+    xo_open_instance("disk");
+    xo_gen_emit_3(NULL, "ada1", 512);
+    xo_close_instance("disk");
+    xo_close_list("disk");
+
+    xo_close_container("top");
+
+    xo_options_free(opts);
+    xo_options_free(bad);
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_17.c; do not edit.
+ * 1 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'T', 0, 0, 0, 1, 11, 3, 4, 8, 4, XO_COMPILED_NONE, 0, 13 },
+    { 'T', 0, 0, 0, 14, 10, 16, 4, 21, 3, XO_COMPILED_NONE, 0, 25 },
+    { 'T', 0, 0, 0, 26, 11, 28, 5, 34, 3, XO_COMPILED_NONE, 0, 38 },
+    { 'T', 0, 0, 0, 39, 11, 41, 5, 47, 3, XO_COMPILED_NONE, 0, 51 },
+    { '+', 0, 0, 0, 51, 0, 51, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 52 },
+    { 'T', 0, 0, 0, 53, 5, 55, 3, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 59 },
+    { '\n', 0, 0, 0, 59, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{T:Item/%-8s}{T:Sold/%6s}{T:Delta/%6s}{T:Price/%9s} {T:SKU}\n",
+    15, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1);
+}
+
+#line 1 "../../../tests/core/test_17.c"
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test xo_emit_list_h: a list emitted from an array of structures,
+ * using member descriptors in place of arguments.
+ */
+typedef struct item_s {
+    const char *i_title;
+    uint32_t i_sold;
+    int16_t i_delta;
+    double i_price;
+    char i_sku[16];
+} item_t;
+
+static item_t items[] = {
+    { "gum", 1412, -3, 0.25, "GRO-000-415" },
+    { "rope", 85, 12, 12.50, "HRD-000-212" },
+    { "ladder", 0, 0, 129.99, "HRD-000-517" },
+    { "bolt", 4123, -144, 0.05, "HRD-000-632" },
+};
+
+static const xo_member_t item_members[] = {
+    { XO_MT_STRING, offsetof(item_t, i_title) },
+    { XO_MT_UINT32, offsetof(item_t, i_sold) },
+    { XO_MT_INT16, offsetof(item_t, i_delta) },
+    { XO_MT_DOUBLE, offsetof(item_t, i_price) },
+    { XO_MT_CHARS, offsetof(item_t, i_sku) },
+};
+
+/* A zero xc_version means the format is parsed, not compiled */
+static const xo_compiled_t item_format = {
+    0, "{k:name/%-8s}{:sold/%6u}{:delta/%+5d} "
+    "{:price/%8.2f} {:sku/%s}\n", 0, NULL
+};
+
+static const xo_compiled_t short_format = {
+    0, "{k:name/%s}: {:sold/%u} {:in-stock/%u}\n", 0, NULL
+};
+
+int
+main (int argc, char **argv)
+{
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_flags(NULL, XOF_KEYS);
+
+    xo_open_container("top");
+    xo_open_container("data");
+
+    xo_gen_emit_1(NULL);
+
+    xo_emit_list("item", &item_format, item_members,
+		 sizeof(item_members) / sizeof(item_members[0]),
+		 items, sizeof(items[0]), sizeof(items) / sizeof(items[0]));
+
+    /* An empty list, and a list with too few members for its format */
+    xo_emit_list("none", &item_format, item_members,
+		 sizeof(item_members) / sizeof(item_members[0]),
+		 items, sizeof(items[0]), 0);
+
+    xo_emit_list("short", &short_format, item_members, 2,
+		 items, sizeof(items[0]), 2);
+
+    xo_close_container("data");
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
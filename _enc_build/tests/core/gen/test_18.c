@@ -0,0 +1,116 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_18.c; do not edit.
+ * 0 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+#line 1 "../../../tests/core/test_18.c"
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test xo_emit_rows_h: a list emitted from a row function that
+ * returns typed values, including values that need converting.
+ */
+typedef struct iface_s {
+    int if_index;
+    unsigned if_left;
+} iface_t;
+
+static const char *names[] = { "em0", "em1", "lo0", "bridge0", "tap3" };
+
+static int
+iface_row (void *opaque, xo_value_t *vals, unsigned max)
+{
+    iface_t *ifp = opaque;
+    int i = ifp->if_index;
+
+    if (ifp->if_left == 0 || max < 5)
+	return -1;
+
+    vals[0].xv_type = XO_VT_STRING;
+    vals[0].xv_u.xv_string = names[i % 5];
+    vals[1].xv_type = XO_VT_INT;
+    vals[1].xv_u.xv_int = i + 1;
+    vals[2].xv_type = XO_VT_UINT;
+    vals[2].xv_u.xv_uint = 1500ULL * (i + 1) * 1000000ULL;
+    vals[3].xv_type = XO_VT_DOUBLE;
+    vals[3].xv_u.xv_double = 99.5 - i * 12.25;
+
+    /* A string value given to a numeric format is converted */
+    vals[4].xv_type = XO_VT_STRING;
+    vals[4].xv_u.xv_string = (i & 1) ? "0x10" : "-7";
+
+    ifp->if_index += 1;
+    ifp->if_left -= 1;
+
+    return 5;
+}
+
+static int
+empty_row (void *opaque, xo_value_t *vals, unsigned max)
+{
+    unsigned *leftp = opaque;
+
+    (void) vals;
+    (void) max;
+
+    if (*leftp == 0)
+	return -1;
+
+    *leftp -= 1;
+    return 0;
+}
+
+/* A zero xc_version means the format is parsed, not compiled */
+static const xo_compiled_t iface_format = {
+    0, "{k:name/%-8s} {:index/%3d} {:bytes/%12llu} "
+    "{:load/%6.2f}{U:pct} {:adjust/%+d}\n", 0, NULL
+};
+
+static const xo_compiled_t empty_format = {
+    0, "{L:tick}\n", 0, NULL
+};
+
+int
+main (int argc, char **argv)
+{
+    iface_t iface = { 0, 5 };
+    unsigned ticks = 2;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_flags(NULL, XOF_FLUSH);
+
+    xo_open_container("top");
+
+    xo_emit_rows("interface", &iface_format, iface_row, &iface);
+
+    /* Rows may have no values */
+    xo_emit_rows("tick", &empty_format, empty_row, &ticks);
+
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
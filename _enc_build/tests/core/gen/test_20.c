@@ -0,0 +1,177 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_20.c; do not edit.
+ * 3 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'T', 0, 0, 0, 1, 6, 3, 4, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 8 },
+    { '+', 0, 0, 0, 8, 0, 8, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 10 },
+    { 'V', 0, 0, 0, 11, 8, 12, 4, 17, 2, XO_COMPILED_NONE, 0, 20 },
+    { '\n', 0, 0, 0, 20, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{T:Data}: {:data/%s}\n",
+    9, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, const char *a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0, 0, 0, 1, 9, 2, 4, 7, 3, XO_COMPILED_NONE, 0, 11 },
+    { '\n', 0, 0, 0, 11, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{:size/%zu}\n",
+    7, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, size_t a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { 'V', 0x80, 0, 0, 1, 9, 3, 4, 8, 2, XO_COMPILED_NONE, 0, 11 },
+    { '+', 0, 0, 0, 11, 0, 11, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 13 },
+    { 'V', 0, 0, 0, 14, 10, 15, 5, 21, 3, XO_COMPILED_NONE, 0, 25 },
+    { '+', 0, 0, 0, 25, 0, 25, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 26 },
+    { 'V', 0, 0, 0, 27, 10, 28, 4, 33, 4, XO_COMPILED_NONE, 0, 38 },
+    { '+', 0, 0, 0, 38, 0, 38, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 39 },
+    { 'V', 0, 0, 0, 40, 8, 41, 7, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 49 },
+    { '\n', 0, 0, 0, 49, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "{k:name/%s}: {:bytes/%zu} {:hash/%08x} {:chunked}\n",
+    13, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, const char *a1, size_t a2, unsigned a3, const char *a4)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3, a1, a2, a3, a4);
+}
+
+#line 1 "../../../tests/core/test_20.c"
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "xo.h"
+
+/*
+ * Test streaming of large string values: each style's output for a
+ * large value (with characters that need escaping, and multi-byte
+ * UTF-8 characters) is sent to a writer that records its size, a
+ * hash of its contents, and whether any single write was large.
+ */
+typedef struct sink_s {
+    size_t s_bytes;		/* Total bytes written */
+    uint32_t s_hash;		/* FNV-1a hash of the output */
+    size_t s_max;		/* Largest single write */
+} sink_t;
+
+static xo_ssize_t
+sink_write (void *opaque, const char *data)
+{
+    sink_t *sp = opaque;
+    size_t len = strlen(data);
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+	sp->s_hash ^= (unsigned char) data[i];
+	sp->s_hash *= 16777619;
+    }
+
+    sp->s_bytes += len;
+    if (len > sp->s_max)
+	sp->s_max = len;
+
+    return len;
+}
+
+static const char *styles[] = { "text", "xml", "json", "html", NULL };
+
+int
+main (int argc, char **argv)
+{
+    static const char pattern[] = "ab<c>&d\"e\\f\tg\xc3\xa9h\xe2\x82\xac ";
+    size_t len = 200000, plen = sizeof(pattern) - 1, i;
+    char *big;
+    int s;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    big = malloc(len + 1);
+    if (big == NULL)
+	return 1;
+
+    for (i = 0; i < len; i++)
+	big[i] = pattern[i % plen];
+    while (len > 0 && (big[len - 1] & 0x80)) /* Don't end mid-character */
+	len -= 1;
+    big[len] = '\0';
+
+    xo_open_container("top");
+    xo_open_list("style");
+
+    for (s = 0; styles[s]; s++) {
+	sink_t sink = { 0, 2166136261U, 0 };
+	xo_handle_t *xop = xo_create(XO_STYLE_TEXT, XOF_UTF8);
+
+	xo_set_options(xop, styles[s]);
+	xo_set_writer(xop, &sink, sink_write, NULL, NULL);
+
+	xo_open_container_h(xop, "top");
+	xo_gen_emit_1(xop, big);
+	xo_gen_emit_2(xop, len);
+	xo_close_container_h(xop, "top");
+	xo_finish_h(xop);
+	xo_destroy(xop);
+
+	xo_open_instance("style");
+	xo_gen_emit_3(NULL,
+		styles[s], sink.s_bytes, sink.s_hash,
+		(sink.s_max < 65536) ? "yes" : "no");
+	xo_close_instance("style");
+    }
+
+    xo_close_list("style");
+    xo_close_container("top");
+
+    xo_finish();
+
+    free(big);
+    return 0;
+}
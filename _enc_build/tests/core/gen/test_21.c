@@ -0,0 +1,198 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_21.c; do not edit.
+ * 5 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'V', 0, 0, 0, 1, 12, 2, 6, 9, 4, XO_COMPILED_NONE, 0, 14 },
+    { '\n', 0, 0, 0, 14, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { '[', 0, 0, 0, 16, 4, 18, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 21 },
+    { 'V', 0, 0, 0, 22, 7, 23, 3, 27, 2, XO_COMPILED_NONE, 0, 30 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{:filler/%.*s}\n{[:30}{:min/%d}",
+    11, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, int a1, const char *a2, int a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1, a2, a3);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 'V', 0, 0, 0, 2, 7, 3, 3, 7, 2, XO_COMPILED_NONE, 0, 10 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "/{:cur/%d}",
+    5, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_3[] = {
+    { '+', 0, 0, 0, 0, 0, 0, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 1 },
+    { 'V', 0, 0, 0, 2, 7, 3, 3, 7, 2, XO_COMPILED_NONE, 0, 10 },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_3 = {
+    XO_COMPILED_VERSION,
+    "/{:max/%d}",
+    5, xo_gen_fields_3
+};
+
+static xo_ssize_t
+xo_gen_emit_3 (xo_handle_t *xop, int a1)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_3, a1);
+}
+
+static const xo_compiled_field_t xo_gen_fields_4[] = {
+    { ']', 0, 0, 0, 1, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 4 },
+    { '+', 0, 0, 0, 4, 0, 4, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 5 },
+    { '\n', 0, 0, 0, 5, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_4 = {
+    XO_COMPILED_VERSION,
+    "{]:}|\n",
+    7, xo_gen_fields_4
+};
+
+static xo_ssize_t
+xo_gen_emit_4 (xo_handle_t *xop)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_4);
+}
+
+static const xo_compiled_field_t xo_gen_fields_5[] = {
+    { 'V', 0x80, 0, 0, 1, 9, 3, 4, 8, 2, XO_COMPILED_NONE, 0, 11 },
+    { '+', 0, 0, 0, 11, 0, 11, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 13 },
+    { 'V', 0, 0, 0, 14, 10, 15, 5, 21, 3, XO_COMPILED_NONE, 0, 25 },
+    { '+', 0, 0, 0, 25, 0, 25, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 26 },
+    { 'V', 0, 0, 0, 27, 6, 28, 5, XO_COMPILED_DEFAULT, 2, XO_COMPILED_NONE, 0, 34 },
+    { '\n', 0, 0, 0, 34, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_5 = {
+    XO_COMPILED_VERSION,
+    "{k:name/%s}: {:bytes/%zu} {:early}\n",
+    11, xo_gen_fields_5
+};
+
+static xo_ssize_t
+xo_gen_emit_5 (xo_handle_t *xop, const char *a1, size_t a2, const char *a3)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_5, a1, a2, a3);
+}
+
+#line 1 "../../../tests/core/test_21.c"
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test an anchor that stays open across several xo_emit calls,
+ * started by a call that makes enough output to pass the buffer's
+ * high-water mark.  The output before the anchor is written without
+ * waiting for the anchor to close, and the total output (including
+ * the anchor's padding) is the same size.  All we need from the
+ * writer is how much it was given, and how often.
+ */
+typedef struct counter_s {
+    size_t c_bytes;		/* Total bytes written */
+    unsigned c_writes;		/* Number of writes */
+} counter_t;
+
+static xo_ssize_t
+counter_write (void *opaque, const char *data)
+{
+    counter_t *cp = opaque;
+    size_t len = strlen(data);
+
+    cp->c_bytes += len;
+    cp->c_writes += 1;
+
+    return len;
+}
+
+static const char *styles[] = { "text", "html", NULL };
+
+int
+main (int argc, char **argv)
+{
+    char filler[12001];
+    int s;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    memset(filler, 'x', sizeof(filler) - 1);
+    filler[sizeof(filler) - 1] = '\0';
+
+    xo_open_container("top");
+    xo_open_list("style");
+
+    for (s = 0; styles[s]; s++) {
+	counter_t counter = { 0, 0 };
+	unsigned before_close;
+	xo_handle_t *xop = xo_create(XO_STYLE_TEXT, 0);
+
+	xo_set_options(xop, styles[s]);
+	xo_set_writer(xop, &counter, counter_write, NULL, NULL);
+
+	xo_gen_emit_1(xop,
+		  (int) sizeof(filler) - 1, filler, 1);
+	xo_gen_emit_2(xop, 4);
+	xo_gen_emit_3(xop, 15);
+	before_close = counter.c_writes;
+	xo_gen_emit_4(xop);
+
+	xo_finish_h(xop);
+	xo_destroy(xop);
+
+	xo_open_instance("style");
+	xo_gen_emit_5(NULL,
+		styles[s], counter.c_bytes, (before_close > 0) ? "yes" : "no");
+	xo_close_instance("style");
+    }
+
+    xo_close_list("style");
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Generated by xolint-c -G from ../../../tests/core/test_22.c; do not edit.
+ * 2 compiled, 0 interpreted format strings
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <wchar.h>
+#include <libxo/xo.h>
+
+static const xo_compiled_field_t xo_gen_fields_1[] = {
+    { 'V', 0x80, 0, 0, 1, 11, 3, 5, 9, 3, XO_COMPILED_NONE, 0, 13 },
+    { '+', 0, 0, 0, 13, 0, 13, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 15 },
+    { 'V', 0x8000, 0, 0, 16, 11, 18, 5, 24, 3, XO_COMPILED_NONE, 0, 28 },
+    { '+', 0, 0, 0, 28, 0, 28, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 29 },
+    { 'V', 0x8000, 0, 0, 30, 15, 32, 10, 43, 2, XO_COMPILED_NONE, 0, 46 },
+    { '+', 0, 0, 0, 46, 0, 46, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 48 },
+    { 'V', 0x18000, 0, 0, 49, 20, 60, 5, 66, 3, XO_COMPILED_NONE, 0, 70 },
+    { '+', 0, 0, 0, 70, 0, 70, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 71 },
+    { 'V', 0x18000, 0, 0, 72, 24, 83, 10, 94, 2, XO_COMPILED_NONE, 0, 97 },
+    { '+', 0, 0, 0, 97, 0, 97, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 99 },
+    { 'V', 0x28000, 0, 0, 100, 24, 113, 7, 121, 3, XO_COMPILED_NONE, 0, 125 },
+    { '+', 0, 0, 0, 125, 0, 125, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 126 },
+    { 'V', 0x28000, 0, 0, 127, 28, 140, 12, 153, 2, XO_COMPILED_NONE, 0, 156 },
+    { '+', 0, 0, 0, 156, 0, 156, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 158 },
+    { 'V', 0x48000, 0, 0, 159, 16, 169, 2, 172, 3, XO_COMPILED_NONE, 0, 176 },
+    { '+', 0, 0, 0, 176, 0, 176, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 177 },
+    { 'V', 0x48000, 0, 0, 178, 20, 188, 7, 196, 2, XO_COMPILED_NONE, 0, 199 },
+    { '+', 0, 0, 0, 199, 0, 199, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 201 },
+    { 'V', 0x68000, 0, 0, 202, 35, 223, 10, 234, 3, XO_COMPILED_NONE, 0, 238 },
+    { '+', 0, 0, 0, 238, 0, 238, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 239 },
+    { 'V', 0x68000, 0, 0, 240, 39, 261, 15, 277, 2, XO_COMPILED_NONE, 0, 280 },
+    { '\n', 0, 0, 0, 280, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_1 = {
+    XO_COMPILED_VERSION,
+    "{k:value/%ju}: {h:plain/%ju} {h:plain-text/%s}, " "{h,hn-space:space/%ju} {h,hn-space:space-text/%s}, " "{h,hn-decimal:decimal/%ju} {h,hn-decimal:decimal-text/%s}, " "{h,hn-1000:si/%ju} {h,hn-1000:si-text/%s}, " "{h,hn-decimal,hn-1000:si-decimal/%ju} " "{h,hn-decimal,hn-1000:si-decimal-text/%s}\n",
+    27, xo_gen_fields_1
+};
+
+static xo_ssize_t
+xo_gen_emit_1 (xo_handle_t *xop, uintmax_t a1, uintmax_t a2, const char *a3, uintmax_t a4, const char *a5, uintmax_t a6, const char *a7, uintmax_t a8, const char *a9, uintmax_t a10, const char *a11)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_1, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11);
+}
+
+static const xo_compiled_field_t xo_gen_fields_2[] = {
+    { 'V', 0x80, 0, 0, 1, 12, 3, 5, 9, 4, XO_COMPILED_NONE, 0, 14 },
+    { '+', 0, 0, 0, 14, 0, 14, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 16 },
+    { 'V', 0x8000, 0, 0, 17, 12, 19, 5, 25, 4, XO_COMPILED_NONE, 0, 30 },
+    { '+', 0, 0, 0, 30, 0, 30, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 31 },
+    { 'V', 0x8000, 0, 0, 32, 15, 34, 10, 45, 2, XO_COMPILED_NONE, 0, 48 },
+    { '+', 0, 0, 0, 48, 0, 48, 2, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 50 },
+    { 'V', 0x68000, 0, 0, 51, 36, 72, 10, 83, 4, XO_COMPILED_NONE, 0, 88 },
+    { '+', 0, 0, 0, 88, 0, 88, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, 89 },
+    { 'V', 0x68000, 0, 0, 90, 39, 111, 15, 127, 2, XO_COMPILED_NONE, 0, 130 },
+    { '\n', 0, 0, 0, 130, 1, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE, 0, XO_COMPILED_NONE },
+    { 0 }
+};
+
+static const xo_compiled_t xo_gen_format_2 = {
+    XO_COMPILED_VERSION,
+    "{k:value/%lld}: {h:plain/%lld} {h:plain-text/%s}, " "{h,hn-decimal,hn-1000:si-decimal/%lld} " "{h,hn-decimal,hn-1000:si-decimal-text/%s}\n",
+    15, xo_gen_fields_2
+};
+
+static xo_ssize_t
+xo_gen_emit_2 (xo_handle_t *xop, long long a1, long long a2, const char *a3, long long a4, const char *a5)
+{
+    return xo_emit_compiled_h(xop, &xo_gen_format_2, a1, a2, a3, a4, a5);
+}
+
+#line 1 "../../../tests/core/test_22.c"
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "xo.h"
+
+/*
+ * Test humanized integer fields.  Text output humanizes "%ju" and
+ * "%lld" arguments directly, while "%s" goes through the formatted
+ * text, so each line shows both, and they should always match.  The
+ * values sit on either side of the powers of 1024 and 1000, and of
+ * the 9.95 edge where rounding to one decimal place gives "10".
+ */
+static const uintmax_t values[] = {
+    0, 1, 999, 1000, 1001, 1023, 1024, 1025,
+    9948, 9949, 9950, 9951, 9999, 10000,
+    10187, 10188, 10189, 10239, 10240,
+    999999, 1000000, 1048575, 1048576, 1048577,
+    10433331, 10433332, 999999999, 1000000000,
+    1073741823, 1073741824, 1099511627775ULL, 1099511627776ULL,
+    1125899906842624ULL, 1152921504606846976ULL, UINTMAX_MAX,
+};
+
+static const long long negatives[] = { -1, -1000, -1024, -10188 };
+
+int
+main (int argc, char **argv)
+{
+    char buf[32];
+    unsigned i;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_open_container("top");
+
+    xo_open_list("value");
+    for (i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+	snprintf(buf, sizeof(buf), "%ju", values[i]);
+
+	xo_open_instance("value");
+	xo_gen_emit_1(NULL
+
+
+
+
+,
+		values[i], values[i], buf, values[i], buf,
+		values[i], buf, values[i], buf, values[i], buf);
+	xo_close_instance("value");
+    }
+    xo_close_list("value");
+
+    xo_open_list("negative");
+    for (i = 0; i < sizeof(negatives) / sizeof(negatives[0]); i++) {
+	snprintf(buf, sizeof(buf), "%lld", negatives[i]);
+
+	xo_open_instance("negative");
+	xo_gen_emit_2(NULL
+
+,
+		negatives[i], negatives[i], buf, negatives[i], buf);
+	xo_close_instance("negative");
+    }
+    xo_close_list("negative");
+
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -48,6 +48,7 @@
 #include "xo_encoder.h"
 #include "xo_buf.h"
 #include "xo_explicit.h"
+#include "xo_parse.h"
 
 /*
  * We ask wcwidth() to do an impossible job, really.  It's supposed to
@@ -153,6 +154,7 @@ typedef unsigned xo_xsf_flags_t; /* XSF_* flags */
 #define XSF_EMIT	(1<<5)	/* Some field has been emitted */
 #define XSF_EMIT_KEY	(1<<6)	/* A key has been emitted */
 #define XSF_EMIT_LEAF_LIST (1<<7) /* A leaf-list field has been emitted */
+#define XSF_NAME_SHARED	(1<<8)	/* xs_name belongs to the caller */
 
 /* These are the flags we propagate between markers and their parents */
 #define XSF_MARKER_FLAGS \
@@ -172,8 +174,11 @@ typedef unsigned xo_xsf_flags_t; /* XSF_* flags */
 typedef struct xo_stack_s {
     xo_xsf_flags_t xs_flags;	/* Flags for this frame */
     xo_state_t xs_state;	/* State for this stack frame */
-    char *xs_name;		/* Name (for XPath value) */
-    char *xs_keys;		/* XPath predicate for any key fields */
+    const char *xs_name;	/* Name (for XPath value) */
+    char *xs_name_copy;		/* Our copy of xs_name, unless shared */
+    xo_buffer_t xs_keys;	/* XPath predicate for any key fields */
+    ssize_t xs_xpath_nokeys;	/* End of our XPath in xo_xpath, sans keys */
+    ssize_t xs_xpath_end;	/* End of our XPath in xo_xpath */
 } xo_stack_t;
 
 /*
@@ -249,7 +254,11 @@ struct xo_handle_s {
     int xo_stack_size;		/* Size of the stack */
     xo_info_t *xo_info;		/* Info fields for all elements */
     int xo_info_count;		/* Number of info entries */
+    struct xo_info_index_s *xo_info_index; /* Hash index over xo_info */
     va_list xo_vap;		/* Variable arguments (stdargs) */
+    const xo_value_t *xo_values; /* Typed values (in place of xo_vap) */
+    unsigned xo_values_num;	/* Number of typed values */
+    unsigned xo_values_cur;	/* Next typed value to use */
     char *xo_leading_xpath;	/* A leading XPath expression */
     mbstate_t xo_mbstate;	/* Multi-byte character conversion state */
     ssize_t xo_anchor_offset;	/* Start of anchored text */
@@ -266,8 +275,20 @@ struct xo_handle_s {
     char *xo_version;		/* Version string */
     int xo_errno;		/* Saved errno for "%m" */
     char *xo_gt_domain;		/* Gettext domain, suitable for dgettext(3) */
+    struct xo_gt_memo_s **xo_gt_memo; /* Memo of gettext field lookups */
+    unsigned xo_gt_memo_count;	/* Number of entries in xo_gt_memo */
+    unsigned xo_gt_memo_gen;	/* Value of xo_gt_generation for xo_gt_memo */
+    char *xo_gt_memo_locale;	/* LC_MESSAGES locale of xo_gt_memo */
     xo_encoder_func_t xo_encoder; /* Encoding function */
     void *xo_private;		/* Private data for external encoders */
+    xo_failure_func_t xo_failure_func; /* Failure callback (for tools) */
+    void *xo_failure_opaque;	/* Opaque data for failure callback */
+    unsigned xo_chunk_lines;	/* HTML: lines per <template> chunk (or 0) */
+    unsigned long xo_chunk_line; /* HTML: number of lines emitted */
+    xo_buffer_t xo_xpath_last;	/* HTML: last XPath prefix emitted */
+    xo_buffer_t xo_xpath;	/* HTML: XPath of the current stack frame */
+    int xo_xpath_valid;		/* HTML: frames whose xs_xpath_* are valid */
+    struct xo_tagdict_s *xo_tagdict; /* HTML: table of tag names */
 };
 
 /* Flag operations */
@@ -284,7 +305,7 @@ struct xo_handle_s {
 #define XOIF_CLEAR(_xop, _bit) XOF_BIT_CLEAR(_xop->xo_iflags, _bit)
 
 /* Internal flags */
-#define XOIF_REORDER	XOF_BIT(0) /* Reordering fields; record field info */
+#define XOIF_FMT_STABLE	XOF_BIT(0) /* Format is retained or compiled */
 #define XOIF_DIV_OPEN	XOF_BIT(1) /* A <div> is open */
 #define XOIF_TOP_EMITTED XOF_BIT(2) /* The top JSON braces have been emitted */
 #define XOIF_ANCHOR	XOF_BIT(3) /* An anchor is in place  */
@@ -292,6 +313,9 @@ struct xo_handle_s {
 #define XOIF_UNITS_PENDING XOF_BIT(4) /* We have a units-insertion pending */
 #define XOIF_INIT_IN_PROGRESS XOF_BIT(5) /* Init of handle is in progress */
 #define XOIF_MADE_OUTPUT XOF_BIT(6)	 /* Have already made output */
+#define XOIF_CHUNK_OPEN XOF_BIT(7)	 /* An HTML chunk <template> is open */
+#define XOIF_VALUES	XOF_BIT(8) /* Arguments are xo_values, not xo_vap */
+#define XOIF_STREAM	XOF_BIT(9) /* Large strings can be streamed out */
 
 /*
  * Normal printf has width and precision, which for strings operate as
@@ -357,31 +381,6 @@ typedef struct xo_format_s {
     unsigned char xf_star[XF_WIDTH_NUM]; /* Seen one or more '*'s */
 } xo_format_t;
 
-/*
- * This structure represents the parsed field information, suitable for
- * processing by xo_do_emit and anything else that needs to parse fields.
- * Note that all pointers point to the main format string.
- *
- * XXX This is a first step toward compilable or cachable format
- * strings.  We can also cache the results of dgettext when no format
- * is used, assuming the 'p' modifier has _not_ been set.
- */
-typedef struct xo_field_info_s {
-    xo_xff_flags_t xfi_flags;	/* Flags for this field */
-    unsigned xfi_ftype;		/* Field type, as character (e.g. 'V') */
-    const char *xfi_start;   /* Start of field in the format string */
-    const char *xfi_content;	/* Field's content */
-    const char *xfi_format;	/* Field's Format */
-    const char *xfi_encoding;	/* Field's encoding format */
-    const char *xfi_next;	/* Next character in format string */
-    ssize_t xfi_len;		/* Length of field */
-    ssize_t xfi_clen;		/* Content length */
-    ssize_t xfi_flen;		/* Format length */
-    ssize_t xfi_elen;		/* Encoding length */
-    unsigned xfi_fnum;		/* Field number (if used; 0 otherwise) */
-    unsigned xfi_renum;		/* Reordered number (0 == no renumbering) */
-} xo_field_info_t;
-
 /*
  * We keep a 'default' handle to allow callers to avoid having to
  * allocate one.  Passing NULL to any of our functions will use
@@ -419,9 +418,34 @@ xo_buf_append_div (xo_handle_t *xop, const char *class, xo_xff_flags_t flags,
 		   const char *fmt, ssize_t flen,
 		   const char *encoding, ssize_t elen);
 
+static void
+xo_tagdict_free (xo_handle_t *xop);
+
+static void
+xo_info_index_free (xo_handle_t *xop);
+
+static void
+xo_gettext_cache_clear (void);
+
+static void
+xo_colors_cache_clear (void);
+
+static void
+xo_options_cache_clear (void);
+
+static void
+xo_gettext_memo_free (xo_handle_t *xop);
+
 static void
 xo_anchor_clear (xo_handle_t *xop);
 
+static int
+xo_do_open_instance (xo_handle_t *xop, xo_xof_flags_t flags, const char *name,
+		     xo_xsf_flags_t xsf);
+
+static int
+xo_do_close_instance (xo_handle_t *xop, const char *name);
+
 /*
  * xo_style is used to retrieve the current style.  When we're built
  * for "text only" mode, we use this function to drive the removal
@@ -525,6 +549,17 @@ xo_printable (const char *str)
     return res;
 }
 
+/*
+ * Forget the cached XPath (see xo_html_xpath_prefix) of any frames
+ * at or below the given depth.
+ */
+static inline void
+xo_xpath_invalidate (xo_handle_t *xop, int depth)
+{
+    if (xop->xo_xpath_valid > depth)
+	xop->xo_xpath_valid = depth;
+}
+
 static int
 xo_depth_check (xo_handle_t *xop, int depth)
 {
@@ -761,7 +796,7 @@ xo_escape_xml (xo_buffer_t *xbp, ssize_t len, xo_xff_flags_t flags)
     if (delta == 0)		/* Nothing to escape; bail */
 	return len;
 
-    if (!xo_buf_has_room(xbp, delta)) /* No room; bail, but don't append */
+    if (!xo_buf_has_room(xbp, len + delta)) /* No room; bail */
 	return 0;
 
     ep = xbp->xb_curp;
@@ -809,7 +844,7 @@ xo_escape_json (xo_buffer_t *xbp, ssize_t len, xo_xff_flags_t flags UNUSED)
     if (delta == 0)		/* Nothing to escape; bail */
 	return len;
 
-    if (!xo_buf_has_room(xbp, delta)) /* No room; bail, but don't append */
+    if (!xo_buf_has_room(xbp, len + delta)) /* No room; bail */
 	return 0;
 
     ep = xbp->xb_curp;
@@ -855,7 +890,7 @@ xo_escape_sdparams (xo_buffer_t *xbp, ssize_t len, xo_xff_flags_t flags UNUSED)
     if (delta == 0)		/* Nothing to escape; bail */
 	return len;
 
-    if (!xo_buf_has_room(xbp, delta)) /* No room; bail, but don't append */
+    if (!xo_buf_has_room(xbp, len + delta)) /* No room; bail */
 	return 0;
 
     ep = xbp->xb_curp;
@@ -928,6 +963,330 @@ xo_write (xo_handle_t *xop)
     return rc;
 }
 
+/*
+ * Write the first 'len' bytes of the data buffer, keeping the rest
+ * (and the offsets that point into it) for later.
+ */
+static ssize_t
+xo_write_prefix (xo_handle_t *xop, ssize_t len)
+{
+    ssize_t rc = 0;
+    xo_buffer_t *xbp = &xop->xo_data;
+    ssize_t left = xo_buf_offset(xbp) - len;
+
+    if (len <= 0 || left < 0)
+	return 0;
+
+    char save = xbp->xb_bufp[len];
+    xbp->xb_bufp[len] = '\0';
+    if (xop->xo_write)
+	rc = xop->xo_write(xop->xo_opaque, xbp->xb_bufp);
+    xbp->xb_bufp[len] = save;
+
+    memmove(xbp->xb_bufp, xbp->xb_bufp + len, left);
+    xbp->xb_curp = xbp->xb_bufp + left;
+
+    if (XOIF_ISSET(xop, XOIF_ANCHOR))
+	xop->xo_anchor_offset -= len;
+
+    if (xop->xo_units_offset >= len)
+	xop->xo_units_offset -= len;
+    else
+	XOIF_CLEAR(xop, XOIF_UNITS_PENDING);
+
+    return rc;
+}
+
+/*
+ * When emitting typed values (XOIF_VALUES), arguments come from
+ * xo_values instead of xo_vap.  Running past the end of the values
+ * gives XO_VT_NONE values, and the caller reports the shortfall.
+ */
+static const xo_value_t xo_value_none;
+
+#define XO_VALUE_BUFSIZ	64	/* Room for a number as a string */
+
+static const xo_value_t *
+xo_value_peek (xo_handle_t *xop, unsigned off)
+{
+    unsigned cur = xop->xo_values_cur + off;
+
+    return (cur < xop->xo_values_num) ? &xop->xo_values[cur] : &xo_value_none;
+}
+
+static const xo_value_t *
+xo_value_next (xo_handle_t *xop)
+{
+    const xo_value_t *xvp = xo_value_peek(xop, 0);
+
+    xop->xo_values_cur += 1;
+    return xvp;
+}
+
+static long long
+xo_value_int (const xo_value_t *xvp)
+{
+    switch (xvp->xv_type) {
+    case XO_VT_INT:
+	return xvp->xv_u.xv_int;
+    case XO_VT_UINT:
+	return (long long) xvp->xv_u.xv_uint;
+    case XO_VT_DOUBLE:
+	return (long long) xvp->xv_u.xv_double;
+    case XO_VT_STRING:
+	return xvp->xv_u.xv_string ? strtoll(xvp->xv_u.xv_string, NULL, 0) : 0;
+    case XO_VT_POINTER:
+	return (long long) (uintptr_t) xvp->xv_u.xv_pointer;
+    default:
+	return 0;
+    }
+}
+
+static unsigned long long
+xo_value_uint (const xo_value_t *xvp)
+{
+    switch (xvp->xv_type) {
+    case XO_VT_UINT:
+	return xvp->xv_u.xv_uint;
+    case XO_VT_STRING:
+	return xvp->xv_u.xv_string ? strtoull(xvp->xv_u.xv_string, NULL, 0) : 0;
+    case XO_VT_POINTER:
+	return (uintptr_t) xvp->xv_u.xv_pointer;
+    default:
+	return (unsigned long long) xo_value_int(xvp);
+    }
+}
+
+static double
+xo_value_double (const xo_value_t *xvp)
+{
+    switch (xvp->xv_type) {
+    case XO_VT_DOUBLE:
+	return xvp->xv_u.xv_double;
+    case XO_VT_UINT:
+	return (double) xvp->xv_u.xv_uint;
+    case XO_VT_STRING:
+	return xvp->xv_u.xv_string ? strtod(xvp->xv_u.xv_string, NULL) : 0;
+    default:
+	return (double) xo_value_int(xvp);
+    }
+}
+
+/*
+ * Return a value as a string, using "buf" (of XO_VALUE_BUFSIZ bytes)
+ * for values that aren't strings already.
+ */
+static const char *
+xo_value_string (const xo_value_t *xvp, char *buf)
+{
+    switch (xvp->xv_type) {
+    case XO_VT_STRING:
+	return xvp->xv_u.xv_string;
+    case XO_VT_INT:
+	snprintf(buf, XO_VALUE_BUFSIZ, "%lld", xvp->xv_u.xv_int);
+	return buf;
+    case XO_VT_UINT:
+	snprintf(buf, XO_VALUE_BUFSIZ, "%llu", xvp->xv_u.xv_uint);
+	return buf;
+    case XO_VT_DOUBLE:
+	snprintf(buf, XO_VALUE_BUFSIZ, "%g", xvp->xv_u.xv_double);
+	return buf;
+    case XO_VT_POINTER:
+	snprintf(buf, XO_VALUE_BUFSIZ, "%p", xvp->xv_u.xv_pointer);
+	return buf;
+    default:
+	return NULL;
+    }
+}
+
+/*
+ * Fetch the next "int" or string argument, from either xo_values or
+ * xo_vap.  Only strings can be used as content (XFF_ARGUMENT).
+ */
+static int
+xo_next_int (xo_handle_t *xop)
+{
+    if (XOIF_ISSET(xop, XOIF_VALUES))
+	return (int) xo_value_int(xo_value_next(xop));
+
+    return va_arg(xop->xo_vap, int);
+}
+
+static const char *
+xo_next_string (xo_handle_t *xop)
+{
+    if (XOIF_ISSET(xop, XOIF_VALUES)) {
+	const xo_value_t *xvp = xo_value_next(xop);
+	return (xvp->xv_type == XO_VT_STRING) ? xvp->xv_u.xv_string : NULL;
+    }
+
+    return va_arg(xop->xo_vap, char *);
+}
+
+#define XO_VALUE_PRINT(_val) \
+    ((stars > 1) ? snprintf(buf, bufsiz, nfmt, width[0], width[1], _val) \
+     : stars ? snprintf(buf, bufsiz, nfmt, width[0], _val) \
+     : snprintf(buf, bufsiz, nfmt, _val))
+
+/*
+ * Format a single printf-style conversion using the typed values at
+ * the cursor.  Like vsnprintf, this doesn't consume the values;
+ * xo_do_format_field does that.  Length modifiers are replaced by
+ * those for the type we actually pass, and plain "%d", "%u", and "%s"
+ * are handled without snprintf.
+ */
+static ssize_t
+xo_value_snprintf (xo_handle_t *xop, char *buf, ssize_t bufsiz,
+		   const char *fmt)
+{
+    char nfmt[XO_VALUE_BUFSIZ], tmp[XO_VALUE_BUFSIZ];
+    char *np = nfmt, *ep = nfmt + sizeof(nfmt) - 4, *dp;
+    const char *cp, *str;
+    int width[2] = { 0, 0 }, stars = 0, simple;
+    const xo_value_t *xvp;
+    unsigned long long uval;
+    long long ival;
+    ssize_t len;
+
+    *np++ = '%';
+    for (cp = fmt + 1; *cp; cp++) {
+	if (strchr("hljtzqL", *cp) != NULL)
+	    continue;
+	if (strchr("diouxXDOUeEfFgGaAcCsSp", *cp) != NULL)
+	    break;
+	if (np >= ep)
+	    return -1;
+	if (*cp == '*') {
+	    if (stars >= 2)
+		return -1;
+	    width[stars] = (int) xo_value_int(xo_value_peek(xop, stars));
+	    stars += 1;
+	}
+	*np++ = *cp;
+    }
+
+    simple = (np == nfmt + 1);
+    xvp = xo_value_peek(xop, stars);
+
+    switch (*cp) {
+    case 'd':
+    case 'i':
+    case 'D':
+	ival = xo_value_int(xvp);
+	if (simple) {
+	    uval = (ival < 0) ? -(unsigned long long) ival
+		: (unsigned long long) ival;
+	    dp = tmp + sizeof(tmp);
+	    do {
+		*--dp = '0' + (uval % 10);
+		uval /= 10;
+	    } while (uval);
+	    if (ival < 0)
+		*--dp = '-';
+	    str = dp;
+	    len = tmp + sizeof(tmp) - str;
+	    goto copy;
+	}
+
+	strcpy(np, "lld");
+	return XO_VALUE_PRINT(ival);
+
+    case 'u':
+    case 'U':
+	uval = xo_value_uint(xvp);
+	if (simple) {
+	    dp = tmp + sizeof(tmp);
+	    do {
+		*--dp = '0' + (uval % 10);
+		uval /= 10;
+	    } while (uval);
+	    str = dp;
+	    len = tmp + sizeof(tmp) - str;
+	    goto copy;
+	}
+
+	strcpy(np, "llu");
+	return XO_VALUE_PRINT(uval);
+
+    case 'o':
+    case 'O':
+    case 'x':
+    case 'X':
+	np[0] = np[1] = 'l';
+	np[2] = (*cp == 'O') ? 'o' : *cp;
+	np[3] = '\0';
+	return XO_VALUE_PRINT(xo_value_uint(xvp));
+
+    case 'e': case 'E': case 'f': case 'F':
+    case 'g': case 'G': case 'a': case 'A':
+	np[0] = *cp;
+	np[1] = '\0';
+	return XO_VALUE_PRINT(xo_value_double(xvp));
+
+    case 'c':
+    case 'C':
+	/* A string gives its first character */
+	strcpy(np, "c");
+	if (xvp->xv_type == XO_VT_STRING)
+	    return XO_VALUE_PRINT(xvp->xv_u.xv_string ? *xvp->xv_u.xv_string : 0);
+	return XO_VALUE_PRINT((int) xo_value_int(xvp));
+
+    case 'p':
+	strcpy(np, "p");
+	if (xvp->xv_type == XO_VT_POINTER)
+	    return XO_VALUE_PRINT(xvp->xv_u.xv_pointer);
+	return XO_VALUE_PRINT((void *) (uintptr_t) xo_value_uint(xvp));
+
+    case 's':
+    case 'S':
+	str = xo_value_string(xvp, tmp);
+	if (str == NULL)
+	    str = "(null)";
+	if (simple) {
+	    len = strlen(str);
+	    goto copy;
+	}
+
+	strcpy(np, "s");
+	return XO_VALUE_PRINT(str);
+
+    default:
+	return 0;
+    }
+
+ copy:
+    /* snprintf semantics: truncate to fit, but return the full length */
+    if (bufsiz > 0) {
+	ssize_t n = (len < bufsiz) ? len : bufsiz - 1;
+	memcpy(buf, str, n);
+	buf[n] = '\0';
+    }
+
+    return len;
+}
+
+#undef XO_VALUE_PRINT
+
+/*
+ * Format typed values into our buffer; see xo_vsnprintf
+ */
+static ssize_t
+xo_value_format (xo_handle_t *xop, xo_buffer_t *xbp, const char *fmt)
+{
+    ssize_t left = xbp->xb_size - (xbp->xb_curp - xbp->xb_bufp);
+    ssize_t rc = xo_value_snprintf(xop, xbp->xb_curp, left, fmt);
+
+    if (rc >= left) {
+	if (!xo_buf_has_room(xbp, rc))
+	    return -1;
+
+	left = xbp->xb_size - (xbp->xb_curp - xbp->xb_bufp);
+	rc = xo_value_snprintf(xop, xbp->xb_curp, left, fmt);
+    }
+
+    return rc;
+}
+
 /*
  * Format arguments into our buffer.  If a custom formatter has been set,
  * we use that to do the work; otherwise we vsnprintf().
@@ -1289,6 +1648,35 @@ xo_data_escape (xo_handle_t *xop, const char *str, ssize_t len)
     xo_buf_escape(xop, &xop->xo_data, str, len, 0);
 }
 
+/*
+ * Process-wide tables that are filled in lazily (the preloaded
+ * formats and the option name indexes) are published with release
+ * stores and read with acquire loads, so a reader never sees a
+ * table before its contents.  XO_ATOMIC_CLAIM changes a zero value
+ * to _val, returning non-zero if this caller made the change.
+ */
+#ifdef __ATOMIC_ACQUIRE
+#define XO_ATOMIC_LOAD(_p) __atomic_load_n(_p, __ATOMIC_ACQUIRE)
+#define XO_ATOMIC_STORE(_p, _val) __atomic_store_n(_p, _val, __ATOMIC_RELEASE)
+#define XO_ATOMIC_CLAIM(_p, _val) \
+    ({ __typeof__(*(_p)) _zero = 0; \
+       __atomic_compare_exchange_n(_p, &_zero, _val, 0, \
+		__ATOMIC_ACQUIRE, __ATOMIC_RELAXED); })
+#define XO_ATOMIC_PUSH(_headp, _new) \
+    do { \
+	(_new)->xpe_next = __atomic_load_n(_headp, __ATOMIC_RELAXED); \
+    } while (!__atomic_compare_exchange_n(_headp, &(_new)->xpe_next, \
+		_new, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+#define XO_ATOMIC_INC(_p) __atomic_add_fetch(_p, 1, __ATOMIC_RELEASE)
+#else /* __ATOMIC_ACQUIRE */
+#define XO_ATOMIC_LOAD(_p) (*(_p))
+#define XO_ATOMIC_STORE(_p, _val) (*(_p) = (_val))
+#define XO_ATOMIC_CLAIM(_p, _val) (*(_p) == 0 ? (*(_p) = (_val), 1) : 0)
+#define XO_ATOMIC_PUSH(_headp, _new) \
+    do { (_new)->xpe_next = *(_headp); *(_headp) = (_new); } while (0)
+#define XO_ATOMIC_INC(_p) (*(_p) += 1)
+#endif /* __ATOMIC_ACQUIRE */
+
 #ifdef LIBXO_NO_RETAIN
 /*
  * Empty implementations of the retain logic
@@ -1297,13 +1685,15 @@ xo_data_escape (xo_handle_t *xop, const char *str, ssize_t len)
 void
 xo_retain_clear_all (void)
 {
-    return;
+    xo_gettext_cache_clear();
+    xo_colors_cache_clear();
+    xo_options_cache_clear();
 }
 
 void
 xo_retain_clear (const char *fmt UNUSED)
 {
-    return;
+    xo_colors_cache_clear();
 }
 static void
 xo_retain_add (const char *fmt UNUSED, xo_field_info_t *fields UNUSED,
@@ -1319,6 +1709,20 @@ xo_retain_find (const char *fmt UNUSED, xo_field_info_t **valp UNUSED,
     return -1;
 }
 
+int
+xo_retain_preload (xo_handle_t *xop UNUSED, const char * const *fmts UNUSED,
+		   unsigned count UNUSED)
+{
+    return 0;
+}
+
+static int
+xo_preload_find (const char *fmt UNUSED, xo_field_info_t **valp UNUSED,
+		 unsigned *nump UNUSED)
+{
+    return -1;
+}
+
 #else /* !LIBXO_NO_RETAIN */
 /*
  * Retain: We retain parsed field definitions to enhance performance,
@@ -1403,6 +1807,10 @@ xo_retain_clear_all (void)
 	xo_retain.xr_bucket[i] = NULL;
     }
     xo_retain_count = 0;
+
+    xo_gettext_cache_clear();
+    xo_colors_cache_clear();
+    xo_options_cache_clear();
 }
 
 /*
@@ -1414,6 +1822,9 @@ xo_retain_clear (const char *fmt)
     xo_retain_entry_t **xrepp;
     unsigned hash = xo_retain_hash(fmt);
 
+    /* The format may be about to go away, along with its {C:} fields */
+    xo_colors_cache_clear();
+
     for (xrepp = &xo_retain.xr_bucket[hash]; *xrepp;
 	 xrepp = &(*xrepp)->xre_next) {
 	if ((*xrepp)->xre_format == fmt) {
@@ -1476,6 +1887,136 @@ xo_retain_add (const char *fmt, xo_field_info_t *fields, unsigned num_fields)
     xo_retain_count += 1;
 }
 
+/*
+ * Preload: Since the retain information is thread-specific and keyed
+ * by the address of the format string, it's only useful after the
+ * first call in each thread.  To avoid paying the parsing cost on
+ * those first calls, an application can preload a table of format
+ * strings (typically generated by "xolint-c -F") at startup.  These
+ * are parsed once and kept in a process-wide table, keyed by the
+ * content of the format string, and are never freed.  Entries are
+ * added atomically, so xo_retain_preload can be called from a
+ * background thread while other threads are emitting.
+ */
+typedef struct xo_preload_entry_s {
+    struct xo_preload_entry_s *xpe_next; /* Next entry in the bucket */
+    uint32_t xpe_hash;		/* Hash of xpe_format */
+    unsigned xpe_num_fields;	/* Number of fields */
+    xo_field_info_t *xpe_fields; /* Parsed fields (point into xpe_format) */
+    const char *xpe_format;	/* Our copy of the format string */
+} xo_preload_entry_t;
+
+#ifndef XO_PRELOAD_SIZE
+#define XO_PRELOAD_SIZE 8
+#endif /* XO_PRELOAD_SIZE */
+#define PRELOAD_HASH_SIZE (1<<XO_PRELOAD_SIZE)
+
+static xo_preload_entry_t *xo_preload_bucket[PRELOAD_HASH_SIZE];
+static unsigned xo_preload_count;
+
+/*
+ * FNV-1a; we're hashing the content here, not the address
+ */
+static uint32_t
+xo_preload_hash (const char *fmt)
+{
+    uint32_t hash = 2166136261U;
+
+    for (; *fmt; fmt++) {
+	hash ^= (uint8_t) *fmt;
+	hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+static xo_preload_entry_t *
+xo_preload_lookup (const char *fmt, uint32_t hash)
+{
+    xo_preload_entry_t *xpep;
+
+    for (xpep = XO_ATOMIC_LOAD(&xo_preload_bucket[hash & (PRELOAD_HASH_SIZE - 1)]);
+	 xpep; xpep = xpep->xpe_next)
+	if (xpep->xpe_hash == hash && strcmp(xpep->xpe_format, fmt) == 0)
+	    return xpep;
+
+    return NULL;
+}
+
+/*
+ * Search the preloaded formats for one matching the content of 'fmt'
+ */
+static int
+xo_preload_find (const char *fmt, xo_field_info_t **valp, unsigned *nump)
+{
+    if (XO_ATOMIC_LOAD(&xo_preload_count) == 0)
+	return -1;
+
+    xo_preload_entry_t *xpep = xo_preload_lookup(fmt, xo_preload_hash(fmt));
+    if (xpep == NULL)
+	return -1;
+
+    *valp = xpep->xpe_fields;
+    *nump = xpep->xpe_num_fields;
+    return 0;
+}
+
+/*
+ * Parse and record a set of format strings.  Returns the number of
+ * format strings that could not be parsed (after reporting them via
+ * xo_failure).
+ */
+int
+xo_retain_preload (xo_handle_t *xop, const char * const *fmts, unsigned count)
+{
+    xo_preload_entry_t *xpep;
+    unsigned i, max_fields;
+    uint32_t hash;
+    size_t len;
+    char *fmt;
+    int failed = 0;
+
+    xop = xo_default(xop);
+
+    for (i = 0; i < count; i++) {
+	if (fmts[i] == NULL)
+	    continue;
+
+	hash = xo_preload_hash(fmts[i]);
+	if (xo_preload_lookup(fmts[i], hash))
+	    continue;
+
+	/* One allocation holds the entry, fields, and format string */
+	max_fields = xo_count_fields(xop, fmts[i]);
+	len = strlen(fmts[i]) + 1;
+	xpep = xo_realloc(NULL, sizeof(*xpep)
+			  + max_fields * sizeof(xo_field_info_t) + len);
+	if (xpep == NULL)
+	    return failed + count - i;
+
+	bzero(xpep, sizeof(*xpep) + max_fields * sizeof(xo_field_info_t));
+	xpep->xpe_hash = hash;
+	xpep->xpe_num_fields = max_fields;
+	xpep->xpe_fields = (xo_field_info_t *) &xpep[1];
+	fmt = (char *) &xpep->xpe_fields[max_fields];
+	memcpy(fmt, fmts[i], len);
+	xpep->xpe_format = fmt;
+
+	if (xo_parse_fields(xop, xpep->xpe_fields, max_fields,
+			    xpep->xpe_format)) {
+	    xo_free(xpep);
+	    failed += 1;
+	    continue;
+	}
+
+	XO_ATOMIC_PUSH(&xo_preload_bucket[hash & (PRELOAD_HASH_SIZE - 1)],
+		       xpep);
+	XO_ATOMIC_INC(&xo_preload_count);
+    }
+
+    return failed;
+}
+
 #endif /* !LIBXO_NO_RETAIN */
 
 /*
@@ -1849,6 +2390,17 @@ xo_failure (xo_handle_t *xop, const char *fmt, ...)
     va_list vap;
 
     va_start(vap, fmt);
+
+    if (xop->xo_failure_func) {
+	char buf[BUFSIZ];
+
+	vsnprintf(buf, sizeof(buf), fmt, vap);
+	va_end(vap);
+
+	xop->xo_failure_func(xop->xo_failure_opaque, fmt, buf);
+	return;
+    }
+
     xo_warn_hcv(xop, -1, 1, fmt, vap);
     va_end(vap);
 }
@@ -1958,12 +2510,24 @@ xo_destroy (xo_handle_t *xop_arg)
     if (xop->xo_close && XOF_ISSET(xop, XOF_CLOSE_FP))
 	xop->xo_close(xop->xo_opaque);
 
+    int i;
+    for (i = 0; i < xop->xo_stack_size; i++)
+	xo_buf_cleanup(&xop->xo_stack[i].xs_keys);
+
     xo_free(xop->xo_stack);
     xo_buf_cleanup(&xop->xo_data);
     xo_buf_cleanup(&xop->xo_fmt);
     xo_buf_cleanup(&xop->xo_predicate);
     xo_buf_cleanup(&xop->xo_attrs);
     xo_buf_cleanup(&xop->xo_color_buf);
+    xo_buf_cleanup(&xop->xo_xpath_last);
+    xo_buf_cleanup(&xop->xo_xpath);
+    xo_tagdict_free(xop);
+    xo_info_index_free(xop);
+    xo_gettext_memo_free(xop);
+
+    if (xop->xo_gt_memo_locale)
+	xo_free(xop->xo_gt_memo_locale);
 
     if (xop->xo_version)
 	xo_free(xop->xo_version);
@@ -2047,8 +2611,69 @@ typedef struct xo_mapping_s {
     const char *xm_name;	/* String name */
 } xo_mapping_t;
 
+/*
+ * A perfect hash index over a mapping table, built on first use.  We
+ * try seeds until we find one where each name lands in its own slot.
+ * If none is found (or another thread is building it), the lookup
+ * falls back to the linear walk, which also handles the abbreviations
+ * (e.g. "warn" for "warn-xml") it's always allowed.  The builder
+ * claims the index by setting xmi_seed to -1, and publishes the seed
+ * only after the slots are filled, so a reader that sees a seed also
+ * sees its slots.
+ */
+#define XO_MAPPING_INDEX_SIZE 128 /* Must be a power of two */
+#define XO_MAPPING_MAX_SEED 1024
+
+typedef struct xo_mapping_index_s {
+    int xmi_seed;		/* 0 = not built; -1 = building or no seed */
+    uint8_t xmi_slot[XO_MAPPING_INDEX_SIZE]; /* Map index + 1 (0 == empty) */
+} xo_mapping_index_t;
+
+static unsigned
+xo_mapping_hash (int seed, const char *name, ssize_t len)
+{
+    uint32_t hash = 2166136261U + (uint32_t) seed;
+
+    for ( ; len > 0; name++, len--) {
+	hash ^= (uint8_t) *name;
+	hash *= 16777619U;
+    }
+
+    return (hash ^ (hash >> 16)) & (XO_MAPPING_INDEX_SIZE - 1);
+}
+
+static void
+xo_mapping_index_build (xo_mapping_t *map, xo_mapping_index_t *xmip)
+{
+    uint8_t slot[XO_MAPPING_INDEX_SIZE];
+    xo_mapping_t *xmp;
+    unsigned hash;
+    int seed;
+
+    if (!XO_ATOMIC_CLAIM(&xmip->xmi_seed, -1))
+	return;			/* Built, or being built, elsewhere */
+
+    for (seed = 1; seed < XO_MAPPING_MAX_SEED; seed++) {
+	bzero(slot, sizeof(slot));
+
+	for (xmp = map; xmp->xm_name; xmp++) {
+	    hash = xo_mapping_hash(seed, xmp->xm_name, strlen(xmp->xm_name));
+	    if (slot[hash] || xmp - map >= UINT8_MAX)
+		break;
+	    slot[hash] = (xmp - map) + 1;
+	}
+
+	if (xmp->xm_name == NULL) {
+	    memcpy(xmip->xmi_slot, slot, sizeof(slot));
+	    XO_ATOMIC_STORE(&xmip->xmi_seed, seed);
+	    return;
+	}
+    }
+}
+
 static xo_xff_flags_t
-xo_name_lookup (xo_mapping_t *map, const char *value, ssize_t len)
+xo_name_lookup_index (xo_mapping_t *map, xo_mapping_index_t *xmip,
+		      const char *value, ssize_t len)
 {
     if (len == 0)
 	return 0;
@@ -2067,6 +2692,28 @@ xo_name_lookup (xo_mapping_t *map, const char *value, ssize_t len)
     if (*value == '\0')
 	return 0;
 
+    if (xmip) {
+	int seed = XO_ATOMIC_LOAD(&xmip->xmi_seed);
+
+	if (seed == 0) {
+	    xo_mapping_index_build(map, xmip);
+	    seed = XO_ATOMIC_LOAD(&xmip->xmi_seed);
+	}
+
+	if (seed > 0) {
+	    unsigned hash = xo_mapping_hash(seed, value, len);
+	    unsigned idx = xmip->xmi_slot[hash];
+
+	    if (idx) {
+		xo_mapping_t *xmp = &map[idx - 1];
+
+		if (strncmp(xmp->xm_name, value, len) == 0
+			&& xmp->xm_name[len] == '\0')
+		    return xmp->xm_value;
+	    }
+	}
+    }
+
     for ( ; map->xm_name; map++)
 	if (strncmp(map->xm_name, value, len) == 0)
 	    return map->xm_value;
@@ -2074,6 +2721,12 @@ xo_name_lookup (xo_mapping_t *map, const char *value, ssize_t len)
     return 0;
 }
 
+static xo_xff_flags_t
+xo_name_lookup (xo_mapping_t *map, const char *value, ssize_t len)
+{
+    return xo_name_lookup_index(map, NULL, value, len);
+}
+
 #ifdef NOT_NEEDED_YET
 static const char *
 xo_value_lookup (xo_mapping_t *map, xo_xff_flags_t value)
@@ -2096,6 +2749,8 @@ static xo_mapping_t xo_xof_names[] = {
     { XOF_DTRT, "dtrt" },
     { XOF_FLUSH, "flush" },
     { XOF_FLUSH_LINE, "flush-line" },
+    { XOF_HTML_COMPACT, "html-compact" },
+    { XOF_HTML_TAGS, "html-tags" },
     { XOF_IGNORE_CLOSE, "ignore-close" },
     { XOF_INFO, "info" },
     { XOF_KEYS, "keys" },
@@ -2115,6 +2770,7 @@ static xo_mapping_t xo_xof_names[] = {
     { XOF_XPATH, "xpath" },
     { 0, NULL }
 };
+static xo_mapping_index_t xo_xof_names_index;
 
 /* Options available via the environment variable ($LIBXO_OPTIONS) */
 static xo_mapping_t xo_xof_simple_names[] = {
@@ -2130,15 +2786,17 @@ static xo_mapping_t xo_xof_simple_names[] = {
     { XOF_WARN, "warn" },
     { 0, NULL }
 };
+static xo_mapping_index_t xo_xof_simple_names_index;
 
 /*
  * Convert string name to XOF_* flag value.
  * Not all are useful.  Or safe.  Or sane.
  */
-static unsigned
+static xo_xof_flags_t
 xo_name_to_flag (const char *name)
 {
-    return (unsigned) xo_name_lookup(xo_xof_names, name, -1);
+    return (xo_xof_flags_t) xo_name_lookup_index(xo_xof_names,
+					   &xo_xof_names_index, name, -1);
 }
 
 /**
@@ -2163,12 +2821,36 @@ xo_set_style_name (xo_handle_t *xop, const char *name)
     return 0;
 }
 
+/*
+ * xo_options_t holds a parsed set of options, ready to be applied to
+ * any number of handles.  The strings (encoder names) point into our
+ * own copy of the input, which lives in the same allocation.
+ */
+struct xo_options_s {
+    xo_xof_flags_t xos_set;	/* Flags to set */
+    xo_xof_flags_t xos_clear;	/* Flags to clear */
+    int xos_style;		/* Style to use (or -1) */
+    int xos_indent_by;		/* Indentation level (or -1) */
+    int xos_chunk_lines;	/* Lines per HTML chunk (or -1) */
+    int xos_color_map_num;	/* Colors given in the map (or -1 for none) */
+    xo_color_t xos_color_map_fg[XO_NUM_COLORS]; /* Foreground mappings */
+    xo_color_t xos_color_map_bg[XO_NUM_COLORS]; /* Background mappings */
+    unsigned xos_flags;		/* XOSF_* flags */
+    unsigned xos_num_encoders;	/* Number of encoders */
+    const char **xos_encoders;	/* Encoder names (and options) */
+    const char *xos_input;	/* Unmodified copy of the input */
+};
+
+/* Flags for xos_flags */
+#define XOSF_SIMPLE	(1<<0)	/* Parsed as simple (LIBXO_OPTIONS) options */
+#define XOSF_WARNED	(1<<1)	/* A warning was issued while parsing */
+
 /*
  * Fill in the color map, based on the input string; currently unimplemented
  * Look for something like "colors=red/blue+green/yellow" as fg/bg pairs.
  */
 static void
-xo_set_color_map (xo_handle_t *xop, char *value)
+xo_options_color_map (xo_options_t *xoop, char *value)
 {
     if (xo_text_only())
 	return;
@@ -2189,183 +2871,175 @@ xo_set_color_map (xo_handle_t *xop, char *value)
 	fg = *cp ? xo_color_find(cp) : -1;
 	bg = (vp && *vp) ? xo_color_find(vp) : -1;
 
-#ifndef LIBXO_TEXT_ONLY
-	xop->xo_color_map_fg[num] = (fg < 0) ? num : fg;
-	xop->xo_color_map_bg[num] = (bg < 0) ? num : bg;
-#endif /* LIBXO_TEXT_ONLY */
+	xoop->xos_color_map_fg[num] = (fg < 0) ? num : fg;
+	xoop->xos_color_map_bg[num] = (bg < 0) ? num : bg;
 
-	if (++num > XO_NUM_COLORS)
+	if (++num >= XO_NUM_COLORS)
 	    break;
     }
 
-    /* If no color initialization happened, then we don't need the map */
-    if (num > 1)
-	XOF_SET(xop, XOF_COLOR_MAP);
-    else
-	XOF_CLEAR(xop, XOF_COLOR_MAP);
+    xoop->xos_color_map_num = num;
 
-#ifndef LIBXO_TEXT_ONLY
     /* Fill in the rest of the colors with the defaults */
     for ( ; num < XO_NUM_COLORS; num++)
-	xop->xo_color_map_fg[num] = xop->xo_color_map_bg[num] = num;
-#endif /* LIBXO_TEXT_ONLY */
+	xoop->xos_color_map_fg[num] = xoop->xos_color_map_bg[num] = num;
 }
 
-static int
-xo_set_options_simple (xo_handle_t *xop, const char *input)
+static void
+xo_options_set_flag (xo_options_t *xoop, xo_xof_flags_t flag)
 {
-    xo_xof_flags_t new_flag;
-    char *cp, *ep, *vp, *np, *bp;
-    ssize_t len = strlen(input) + 1;
-
-    bp = alloca(len);
-    memcpy(bp, input, len);
-
-    for (cp = bp, ep = cp + len - 1; cp && cp < ep; cp = np) {
-	np = strchr(cp, ',');
-	if (np)
-	    *np++ = '\0';
-
-	vp = strchr(cp, '=');
-	if (vp)
-	    *vp++ = '\0';
-
-	if (xo_streq("colors", cp)) {
-	    xo_set_color_map(xop, vp);
-	    continue;
-	}
-
-	new_flag = xo_name_lookup(xo_xof_simple_names, cp, -1);
-	if (new_flag != 0) {
-	    XOF_SET(xop, new_flag);
-	} else if (xo_streq(cp, "no-color")) {
-	    XOF_CLEAR(xop, XOF_COLOR_ALLOWED);
-	} else {
-	    xo_failure(xop, "unknown simple option: %s", cp);
-	    return -1;
-	}
-    }
+    xoop->xos_set |= flag;
+    xoop->xos_clear &= ~flag;
+}
 
-    return 0;
+static void
+xo_options_clear_flag (xo_options_t *xoop, xo_xof_flags_t flag)
+{
+    xoop->xos_clear |= flag;
+    xoop->xos_set &= ~flag;
 }
 
-/**
- * Set the options for a handle using a string of options
- * passed in.  The input is a comma-separated set of names
- * and optional values: "xml,pretty,indent=4"
- *
- * @param xop XO handle
- * @param input Comma-separated set of option values
- * @return 0 on success, non-zero on failure
+/*
+ * The old-school style of giving options, using a single character
+ * for each option.  It's ideal for lazy people, such as myself.
  */
-int
-xo_set_options (xo_handle_t *xop, const char *input)
+static void
+xo_options_parse_chars (xo_options_t *xoop, const char *input)
 {
-    char *cp, *ep, *vp, *np, *bp;
-    int style = -1, new_style, rc = 0;
-    ssize_t len;
-    xo_xof_flags_t new_flag;
-
-    if (input == NULL)
-	return 0;
+    ssize_t sz;
 
-    xop = xo_default(xop);
+    for ( ; *input; input++) {
+	switch (*input) {
+	case 'c':
+	    xo_options_set_flag(xoop, XOF_COLOR_ALLOWED);
+	    break;
 
-#ifdef LIBXO_COLOR_ON_BY_DEFAULT
-    /* If the installer used --enable-color-on-by-default, then we allow it */
-    XOF_SET(xop, XOF_COLOR_ALLOWED);
-#endif /* LIBXO_COLOR_ON_BY_DEFAULT */
+	case 'f':
+	    xo_options_set_flag(xoop, XOF_FLUSH);
+	    break;
 
-    /*
-     * We support a simpler, old-school style of giving option
-     * also, using a single character for each option.  It's
-     * ideal for lazy people, such as myself.
-     */
-    if (*input == ':') {
-	ssize_t sz;
+	case 'F':
+	    xo_options_set_flag(xoop, XOF_FLUSH_LINE);
+	    break;
 
-	for (input++ ; *input; input++) {
-	    switch (*input) {
-	    case 'c':
-		XOF_SET(xop, XOF_COLOR_ALLOWED);
-		break;
+	case 'g':
+	    xo_options_set_flag(xoop, XOF_LOG_GETTEXT);
+	    break;
 
-	    case 'f':
-		XOF_SET(xop, XOF_FLUSH);
-		break;
+	case 'H':
+	    xoop->xos_style = XO_STYLE_HTML;
+	    break;
 
-	    case 'F':
-		XOF_SET(xop, XOF_FLUSH_LINE);
-		break;
+	case 'I':
+	    xo_options_set_flag(xoop, XOF_INFO);
+	    break;
 
-	    case 'g':
-		XOF_SET(xop, XOF_LOG_GETTEXT);
-		break;
+	case 'i':
+	    sz = strspn(input + 1, "0123456789");
+	    if (sz > 0) {
+		xoop->xos_indent_by = atoi(input + 1);
+		input += sz - 1;	/* Skip value */
+	    }
+	    break;
 
-	    case 'H':
-		xop->xo_style = XO_STYLE_HTML;
-		break;
+	case 'J':
+	    xoop->xos_style = XO_STYLE_JSON;
+	    break;
 
-	    case 'I':
-		XOF_SET(xop, XOF_INFO);
-		break;
+	case 'k':
+	    xo_options_set_flag(xoop, XOF_KEYS);
+	    break;
 
-	    case 'i':
-		sz = strspn(input + 1, "0123456789");
-		if (sz > 0) {
-		    xop->xo_indent_by = atoi(input + 1);
-		    input += sz - 1;	/* Skip value */
-		}
-		break;
+	case 'n':
+	    xo_options_set_flag(xoop, XOF_NO_HUMANIZE);
+	    break;
 
-	    case 'J':
-		xop->xo_style = XO_STYLE_JSON;
-		break;
+	case 'P':
+	    xo_options_set_flag(xoop, XOF_PRETTY);
+	    break;
 
-	    case 'k':
-		XOF_SET(xop, XOF_KEYS);
-		break;
+	case 'T':
+	    xoop->xos_style = XO_STYLE_TEXT;
+	    break;
 
-	    case 'n':
-		XOF_SET(xop, XOF_NO_HUMANIZE);
-		break;
+	case 'U':
+	    xo_options_set_flag(xoop, XOF_UNITS);
+	    break;
 
-	    case 'P':
-		XOF_SET(xop, XOF_PRETTY);
-		break;
+	case 'u':
+	    xo_options_set_flag(xoop, XOF_UNDERSCORES);
+	    break;
 
-	    case 'T':
-		xop->xo_style = XO_STYLE_TEXT;
-		break;
+	case 'W':
+	    xo_options_set_flag(xoop, XOF_WARN);
+	    break;
 
-	    case 'U':
-		XOF_SET(xop, XOF_UNITS);
-		break;
+	case 'X':
+	    xoop->xos_style = XO_STYLE_XML;
+	    break;
 
-	    case 'u':
-		XOF_SET(xop, XOF_UNDERSCORES);
-		break;
+	case 'x':
+	    xo_options_set_flag(xoop, XOF_XPATH);
+	    break;
+	}
+    }
+}
 
-	    case 'W':
-		XOF_SET(xop, XOF_WARN);
-		break;
+/*
+ * Parse a string of options into a new xo_options_t.  The input is a
+ * comma-separated set of names and optional values: "xml,pretty,indent=4".
+ * "simple" restricts us to the options allowed in $LIBXO_OPTIONS.
+ * Warnings are made using "xop".  Problems with the input are reported
+ * via "rcp", but we still return what we could parse, so the caller
+ * can use the rest of the options.
+ */
+static xo_options_t *
+xo_options_build (xo_handle_t *xop, const char *input, int simple, int *rcp)
+{
+    xo_options_t *xoop;
+    char *cp, *ep, *vp, *np, *bp;
+    int style = -1, new_style, rc = 0;
+    ssize_t len = strlen(input) + 1;
+    unsigned max_encoders = 1;
+    xo_xof_flags_t new_flag;
 
-	    case 'X':
-		xop->xo_style = XO_STYLE_XML;
-		break;
+    for (cp = strchr(input, ','); cp; cp = strchr(cp + 1, ','))
+	max_encoders += 1;
 
-	    case 'x':
-		XOF_SET(xop, XOF_XPATH);
-		break;
-	    }
-	}
-	return 0;
+    xoop = xo_realloc(NULL, sizeof(*xoop)
+		      + max_encoders * sizeof(xoop->xos_encoders[0])
+		      + len * 2);
+    if (xoop == NULL) {
+	*rcp = -1;
+	return NULL;
     }
 
-    len = strlen(input) + 1;
-    bp = alloca(len);
+    bzero(xoop, sizeof(*xoop));
+    xoop->xos_style = xoop->xos_indent_by = xoop->xos_chunk_lines = -1;
+    xoop->xos_color_map_num = -1;
+    xoop->xos_encoders = (const char **) &xoop[1];
+
+    bp = (char *) &xoop->xos_encoders[max_encoders];
+    memcpy(bp, input, len);
+    xoop->xos_input = bp;
+    bp += len;
     memcpy(bp, input, len);
 
+    if (simple) {
+	xoop->xos_flags |= XOSF_SIMPLE;
+    } else {
+#ifdef LIBXO_COLOR_ON_BY_DEFAULT
+	/* If the installer used --enable-color-on-by-default, we allow it */
+	xo_options_set_flag(xoop, XOF_COLOR_ALLOWED);
+#endif /* LIBXO_COLOR_ON_BY_DEFAULT */
+
+	if (*input == ':') {
+	    xo_options_parse_chars(xoop, input + 1);
+	    *rcp = 0;
+	    return xoop;
+	}
+    }
+
     for (cp = bp, ep = cp + len - 1; cp && cp < ep; cp = np) {
 	np = strchr(cp, ',');
 	if (np)
@@ -2376,16 +3050,14 @@ xo_set_options (xo_handle_t *xop, const char *input)
 	 * chiefly by a desire to make pluggable encoders not appear
 	 * so distinct from built-in encoders.
 	 */
-	if (*cp == '@') {
+	if (*cp == '@' && !simple) {
 	    vp = cp + 1;
 
-	    if (*vp == '\0')
+	    if (*vp == '\0') {
 		xo_failure(xop, "missing value for encoder option");
-	    else {
-		rc = xo_encoder_init(xop, vp);
-		if (rc)
-		    xo_warnx("error initializing encoder: %s", vp);
-	    }
+		xoop->xos_flags |= XOSF_WARNED;
+	    } else
+		xoop->xos_encoders[xoop->xos_num_encoders++] = vp;
 
 	    continue;
 	}
@@ -2395,7 +3067,23 @@ xo_set_options (xo_handle_t *xop, const char *input)
 	    *vp++ = '\0';
 
 	if (xo_streq("colors", cp)) {
-	    xo_set_color_map(xop, vp);
+	    xo_options_color_map(xoop, vp);
+	    continue;
+	}
+
+	if (simple) {
+	    new_flag = xo_name_lookup_index(xo_xof_simple_names,
+					    &xo_xof_simple_names_index, cp, -1);
+	    if (new_flag != 0) {
+		xo_options_set_flag(xoop, new_flag);
+	    } else if (xo_streq(cp, "no-color")) {
+		xo_options_clear_flag(xoop, XOF_COLOR_ALLOWED);
+	    } else {
+		xo_failure(xop, "unknown simple option: %s", cp);
+		xoop->xos_flags |= XOSF_WARNED;
+		rc = -1;
+		break;
+	    }
 	    continue;
 	}
 
@@ -2405,39 +3093,237 @@ xo_set_options (xo_handle_t *xop, const char *input)
 	 */
 	new_style = xo_name_to_style(cp);
 	if (new_style >= 0 && new_style != XO_STYLE_ENCODER) {
-	    if (style >= 0)
+	    if (style >= 0) {
 		xo_warnx("ignoring multiple styles: '%s'", cp);
-	    else
+		xoop->xos_flags |= XOSF_WARNED;
+	    } else
 		style = new_style;
 	} else {
 	    new_flag = xo_name_to_flag(cp);
 	    if (new_flag != 0)
-		XOF_SET(xop, new_flag);
+		xo_options_set_flag(xoop, new_flag);
 	    else if (xo_streq(cp, "no-color"))
-		XOF_CLEAR(xop, XOF_COLOR_ALLOWED);
+		xo_options_clear_flag(xoop, XOF_COLOR_ALLOWED);
 	    else if (xo_streq(cp, "indent")) {
 		if (vp)
-		    xop->xo_indent_by = atoi(vp);
-		else
+		    xoop->xos_indent_by = atoi(vp);
+		else {
 		    xo_failure(xop, "missing value for indent option");
-	    } else if (xo_streq(cp, "encoder")) {
-		if (vp == NULL)
-		    xo_failure(xop, "missing value for encoder option");
+		    xoop->xos_flags |= XOSF_WARNED;
+		}
+	    } else if (xo_streq(cp, "html-chunk")) {
+		if (vp)
+		    xoop->xos_chunk_lines = atoi(vp);
 		else {
-		    rc = xo_encoder_init(xop, vp);
-		    if (rc)
-			xo_warnx("error initializing encoder: %s", vp);
+		    xo_failure(xop, "missing value for html-chunk option");
+		    xoop->xos_flags |= XOSF_WARNED;
 		}
+	    } else if (xo_streq(cp, "encoder")) {
+		if (vp == NULL) {
+		    xo_failure(xop, "missing value for encoder option");
+		    xoop->xos_flags |= XOSF_WARNED;
+		} else
+		    xoop->xos_encoders[xoop->xos_num_encoders++] = vp;
 		
 	    } else {
 		xo_warnx("unknown libxo option value: '%s'", cp);
+		xoop->xos_flags |= XOSF_WARNED;
 		rc = -1;
 	    }
 	}
     }
 
     if (style > 0)
-	xop->xo_style= style;
+	xoop->xos_style = style;
+
+    *rcp = rc;
+    return xoop;
+}
+
+/*
+ * Since handles are often made with the same options (e.g. from
+ * $LIBXO_OPTIONS), we keep the last options parsed from each kind
+ * of input, so applying them again is cheap.  Options that gave
+ * warnings aren't kept, so the warnings are repeated.
+ */
+static THREAD_LOCAL(xo_options_t *) xo_options_last[2];
+
+static xo_options_t *
+xo_options_cached (xo_handle_t *xop, const char *input, int simple, int *rcp)
+{
+    xo_options_t *xoop = xo_options_last[simple ? 1 : 0];
+
+    if (xoop && xo_streq(xoop->xos_input, input)) {
+	*rcp = 0;
+	return xoop;
+    }
+
+    xoop = xo_options_build(xop, input, simple, rcp);
+    if (xoop && *rcp == 0 && !(xoop->xos_flags & XOSF_WARNED)) {
+	if (xo_options_last[simple ? 1 : 0])
+	    xo_free(xo_options_last[simple ? 1 : 0]);
+	xo_options_last[simple ? 1 : 0] = xoop;
+    }
+
+    return xoop;
+}
+
+/*
+ * Free this thread's saved options (via xo_retain_clear_all)
+ */
+static void
+xo_options_cache_clear (void)
+{
+    int i;
+
+    for (i = 0; i < 2; i++) {
+	if (xo_options_last[i]) {
+	    xo_free(xo_options_last[i]);
+	    xo_options_last[i] = NULL;
+	}
+    }
+}
+
+static void
+xo_options_release (xo_options_t *xoop)
+{
+    if (xoop && xoop != xo_options_last[0] && xoop != xo_options_last[1])
+	xo_free(xoop);
+}
+
+/**
+ * Parse a string of options (as for xo_set_options) into an options
+ * object that can be applied to any number of handles using
+ * xo_options_apply.
+ *
+ * @param input Comma-separated set of option values
+ * @return Options object, or NULL if the input had problems
+ */
+xo_options_t *
+xo_options_parse (const char *input)
+{
+    xo_options_t *xoop;
+    int rc;
+
+    if (input == NULL)
+	return NULL;
+
+    xoop = xo_options_build(xo_default(NULL), input, FALSE, &rc);
+    if (xoop && rc < 0) {
+	xo_free(xoop);
+	xoop = NULL;
+    }
+
+    return xoop;
+}
+
+/**
+ * Apply a parsed set of options to a handle
+ *
+ * @param xop XO handle
+ * @param xoop Options, from xo_options_parse
+ * @return 0 on success, non-zero on failure
+ */
+int
+xo_options_apply (xo_handle_t *xop, const xo_options_t *xoop)
+{
+    unsigned i;
+    int rc = 0;
+
+    if (xoop == NULL)
+	return 0;
+
+    xop = xo_default(xop);
+
+    if (xoop->xos_color_map_num >= 0) {
+#ifndef LIBXO_TEXT_ONLY
+	memcpy(xop->xo_color_map_fg, xoop->xos_color_map_fg,
+	       sizeof(xop->xo_color_map_fg));
+	memcpy(xop->xo_color_map_bg, xoop->xos_color_map_bg,
+	       sizeof(xop->xo_color_map_bg));
+#endif /* LIBXO_TEXT_ONLY */
+
+	/* If no color initialization happened, then we don't need the map */
+	if (xoop->xos_color_map_num > 1)
+	    XOF_SET(xop, XOF_COLOR_MAP);
+	else
+	    XOF_CLEAR(xop, XOF_COLOR_MAP);
+    }
+
+    XOF_CLEAR(xop, xoop->xos_clear);
+    XOF_SET(xop, xoop->xos_set);
+
+    if (xoop->xos_indent_by >= 0)
+	xop->xo_indent_by = xoop->xos_indent_by;
+    if (xoop->xos_chunk_lines >= 0)
+	xop->xo_chunk_lines = xoop->xos_chunk_lines;
+
+    for (i = 0; i < xoop->xos_num_encoders; i++) {
+	if (xo_encoder_init(xop, xoop->xos_encoders[i])) {
+	    xo_warnx("error initializing encoder: %s", xoop->xos_encoders[i]);
+	    rc = -1;
+	}
+    }
+
+    if (xoop->xos_style >= 0)
+	xop->xo_style = xoop->xos_style;
+
+    return rc;
+}
+
+/**
+ * Free an options object
+ *
+ * @param xoop Options, from xo_options_parse
+ */
+void
+xo_options_free (xo_options_t *xoop)
+{
+    if (xoop)
+	xo_free(xoop);
+}
+
+static int
+xo_set_options_simple (xo_handle_t *xop, const char *input)
+{
+    xo_options_t *xoop;
+    int rc;
+
+    xoop = xo_options_cached(xop, input, TRUE, &rc);
+    if (xoop) {
+	xo_options_apply(xop, xoop);
+	xo_options_release(xoop);
+    }
+
+    return rc;
+}
+
+/**
+ * Set the options for a handle using a string of options
+ * passed in.  The input is a comma-separated set of names
+ * and optional values: "xml,pretty,indent=4"
+ *
+ * @param xop XO handle
+ * @param input Comma-separated set of option values
+ * @return 0 on success, non-zero on failure
+ */
+int
+xo_set_options (xo_handle_t *xop, const char *input)
+{
+    xo_options_t *xoop;
+    int rc;
+
+    if (input == NULL)
+	return 0;
+
+    xop = xo_default(xop);
+
+    xoop = xo_options_cached(xop, input, FALSE, &rc);
+    if (xoop) {
+	if (xo_options_apply(xop, xoop))
+	    rc = -1;
+	xo_options_release(xoop);
+    }
 
     return rc;
 }
@@ -2501,6 +3387,8 @@ xo_set_leading_xpath (xo_handle_t *xop, const char *path)
 {
     xop = xo_default(xop);
 
+    xo_xpath_invalidate(xop, 0);
+
     if (xop->xo_leading_xpath) {
 	xo_free(xop->xo_leading_xpath);
 	xop->xo_leading_xpath = NULL;
@@ -2512,15 +3400,94 @@ xo_set_leading_xpath (xo_handle_t *xop, const char *path)
     xop->xo_leading_xpath = xo_strndup(path, -1);
 }
 
-/**
- * Record the info data for a set of tags
- *
- * @param xop XO handle to alter (or NULL for default handle)
- * @param info Info data (xo_info_t) to be recorded (or NULL) (MUST BE SORTED)
- * @pararm count Number of entries in info (or -1 to count them ourselves)
+/*
+ * The info data is indexed by a hash table built by xo_set_info, so
+ * we can find the entry for a field's name (which isn't NUL
+ * terminated) without copying it.  Chains are kept in table order,
+ * so the first entry wins if names are repeated.
  */
-void
-xo_set_info (xo_handle_t *xop, xo_info_t *infop, int count)
+typedef struct xo_info_index_s {
+    unsigned xii_mask;		/* Number of buckets, minus one */
+    unsigned *xii_bucket;	/* First entry in each bucket (plus one) */
+    unsigned *xii_next;		/* Next entry in bucket (plus one) */
+    uint32_t *xii_hash;		/* Hash of each entry's name */
+} xo_info_index_t;
+
+static uint32_t
+xo_info_hash (const char *name, ssize_t nlen)
+{
+    uint32_t hash = 2166136261U;
+
+    for ( ; nlen > 0; name++, nlen--) {
+	hash ^= (uint8_t) *name;
+	hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+static void
+xo_info_index_free (xo_handle_t *xop)
+{
+    if (xop->xo_info_index) {
+	xo_free(xop->xo_info_index);
+	xop->xo_info_index = NULL;
+    }
+}
+
+static void
+xo_info_index_build (xo_handle_t *xop)
+{
+    xo_info_index_t *xiip;
+    unsigned nbuckets = 16, i, b;
+    int count = xop->xo_info_count;
+
+    if (xop->xo_info == NULL || count <= 0)
+	return;
+
+    while (nbuckets < (unsigned) count)
+	nbuckets <<= 1;
+
+    /* One allocation holds the index and its arrays */
+    xiip = xo_realloc(NULL, sizeof(*xiip)
+		      + (nbuckets + count) * sizeof(unsigned)
+		      + count * sizeof(uint32_t));
+    if (xiip == NULL)
+	return;			/* We'll walk the table instead */
+
+    xiip->xii_mask = nbuckets - 1;
+    xiip->xii_bucket = (unsigned *) &xiip[1];
+    xiip->xii_next = xiip->xii_bucket + nbuckets;
+    xiip->xii_hash = (uint32_t *) (xiip->xii_next + count);
+    bzero(xiip->xii_bucket, nbuckets * sizeof(unsigned));
+
+    /* Add them in reverse, so each chain is in table order */
+    for (i = count; i-- > 0; ) {
+	const char *name = xop->xo_info[i].xi_name;
+
+	xiip->xii_hash[i] = name ? xo_info_hash(name, strlen(name)) : 0;
+	if (name == NULL) {
+	    xiip->xii_next[i] = 0;
+	    continue;
+	}
+
+	b = xiip->xii_hash[i] & xiip->xii_mask;
+	xiip->xii_next[i] = xiip->xii_bucket[b];
+	xiip->xii_bucket[b] = i + 1;
+    }
+
+    xop->xo_info_index = xiip;
+}
+
+/**
+ * Record the info data for a set of tags
+ *
+ * @param xop XO handle to alter (or NULL for default handle)
+ * @param info Info data (xo_info_t) to be recorded (or NULL)
+ * @pararm count Number of entries in info (or -1 to count them ourselves)
+ */
+void
+xo_set_info (xo_handle_t *xop, xo_info_t *infop, int count)
 {
     xop = xo_default(xop);
 
@@ -2533,6 +3500,9 @@ xo_set_info (xo_handle_t *xop, xo_info_t *infop, int count)
 
     xop->xo_info = infop;
     xop->xo_info_count = count;
+
+    xo_info_index_free(xop);
+    xo_info_index_build(xop);
 }
 
 /**
@@ -2592,11 +3562,56 @@ xo_state_name (xo_state_t state)
     return "unknown";
 }
 
+/*
+ * With "html-chunk=N", HTML lines are grouped into <template>
+ * elements of N lines each.  The browser parses template contents
+ * but doesn't render them, so xohtml.js can build an index of the
+ * chunks (by their "data-line" numbers) and render only the ones in
+ * view, keeping huge outputs usable.
+ */
+static void
+xo_html_chunk_check (xo_handle_t *xop)
+{
+    static char chunk_close[] = "</template>";
+
+    if (xop->xo_chunk_line++ % xop->xo_chunk_lines != 0)
+	return;
+
+    if (XOIF_ISSET(xop, XOIF_CHUNK_OPEN)) {
+	xo_data_append(xop, chunk_close, sizeof(chunk_close) - 1);
+	if (XOF_ISSET(xop, XOF_PRETTY))
+	    xo_data_append(xop, "\n", 1);
+    }
+
+    XOIF_SET(xop, XOIF_CHUNK_OPEN);
+    xo_printf(xop, "<template class=\"xo-chunk\" data-line=\"%lu\">",
+	      xop->xo_chunk_line);
+    if (XOF_ISSET(xop, XOF_PRETTY))
+	xo_data_append(xop, "\n", 1);
+}
+
+static void
+xo_html_chunk_close (xo_handle_t *xop)
+{
+    static char chunk_close[] = "</template>";
+
+    if (!XOIF_ISSET(xop, XOIF_CHUNK_OPEN) || XOIF_ISSET(xop, XOIF_DIV_OPEN))
+	return;
+
+    XOIF_CLEAR(xop, XOIF_CHUNK_OPEN);
+    xop->xo_chunk_line = 0;
+    xo_data_append(xop, chunk_close, sizeof(chunk_close) - 1);
+    if (XOF_ISSET(xop, XOF_PRETTY))
+	xo_data_append(xop, "\n", 1);
+}
+
 static void
 xo_line_ensure_open (xo_handle_t *xop, xo_xff_flags_t flags UNUSED)
 {
     static char div_open[] = "<div class=\"line\">";
     static char div_open_blank[] = "<div class=\"blank-line\">";
+    static char div_open_compact[] = "<div class=\"ln\">";
+    static char div_open_blank_compact[] = "<div class=\"bl\">";
 
     if (XOF_ISSET(xop, XOF_CONTINUATION)) {
 	XOF_CLEAR(xop, XOF_CONTINUATION);
@@ -2610,8 +3625,17 @@ xo_line_ensure_open (xo_handle_t *xop, xo_xff_flags_t flags UNUSED)
     if (xo_style(xop) != XO_STYLE_HTML)
 	return;
 
+    if (xop->xo_chunk_lines)
+	xo_html_chunk_check(xop);
+
     XOIF_SET(xop, XOIF_DIV_OPEN);
-    if (flags & XFF_BLANK_LINE)
+    if (XOF_ISSET(xop, XOF_HTML_COMPACT)) {
+	if (flags & XFF_BLANK_LINE)
+	    xo_data_append(xop, div_open_blank_compact,
+			   sizeof(div_open_blank_compact) - 1);
+	else
+	    xo_data_append(xop, div_open_compact, sizeof(div_open_compact) - 1);
+    } else if (flags & XFF_BLANK_LINE)
 	xo_data_append(xop, div_open_blank, sizeof(div_open_blank) - 1);
     else
 	xo_data_append(xop, div_open, sizeof(div_open) - 1);
@@ -2643,28 +3667,42 @@ xo_line_close (xo_handle_t *xop)
     }
 }
 
-static int
-xo_info_compare (const void *key, const void *data)
+/*
+ * Does the info entry's name match the given (counted) name?
+ */
+static inline int
+xo_info_match (const xo_info_t *xip, const char *name, ssize_t nlen)
 {
-    const char *name = key;
-    const xo_info_t *xip = data;
-
-    return strcmp(name, xip->xi_name);
+    return xip->xi_name && strncmp(xip->xi_name, name, nlen) == 0
+	&& xip->xi_name[nlen] == '\0';
 }
 
-
 static xo_info_t *
 xo_info_find (xo_handle_t *xop, const char *name, ssize_t nlen)
 {
+    xo_info_index_t *xiip = xop->xo_info_index;
     xo_info_t *xip;
-    char *cp = alloca(nlen + 1); /* Need local copy for NUL termination */
+    unsigned num;
+    int i;
+
+    if (xiip == NULL) {
+	/* No index (allocation failed); walk the table */
+	for (i = 0, xip = xop->xo_info; i < xop->xo_info_count; i++, xip++)
+	    if (xo_info_match(xip, name, nlen))
+		return xip;
+	return NULL;
+    }
+
+    uint32_t hash = xo_info_hash(name, nlen);
 
-    memcpy(cp, name, nlen);
-    cp[nlen] = '\0';
+    for (num = xiip->xii_bucket[hash & xiip->xii_mask]; num;
+	 num = xiip->xii_next[num - 1]) {
+	xip = &xop->xo_info[num - 1];
+	if (xiip->xii_hash[num - 1] == hash && xo_info_match(xip, name, nlen))
+	    return xip;
+    }
 
-    xip = bsearch(cp, xop->xo_info, xop->xo_info_count,
-		  sizeof(xop->xo_info[0]), xo_info_compare);
-    return xip;
+    return NULL;
 }
 
 #define CONVERT(_have, _need) (((_have) << 8) | (_need))
@@ -2896,6 +3934,62 @@ xo_needed_encoding (xo_handle_t *xop)
     return XF_ENC_UTF8;		/* Otherwise, we love UTF-8 */
 }
 
+/*
+ * Large string values (such as a config blob or a log excerpt) aren't
+ * built up in xo_data.  Instead we write out any pending output, then
+ * escape the value and write it in chunks, so memory use is bounded
+ * no matter how large the value is.  This is only safe while
+ * formatting a value (XOIF_STREAM) when nothing will revisit the
+ * buffer (anchors, units, columns, encoders).  Returns -1 if the
+ * value can't be streamed.
+ */
+#define XO_STREAM_MIN	(64 * 1024) /* Smallest string worth streaming */
+#define XO_STREAM_CHUNK	XO_BUFSIZ   /* Bytes escaped per write */
+
+static ssize_t
+xo_stream_string (xo_handle_t *xop, xo_buffer_t *xbp, xo_xff_flags_t flags,
+		  const char *cp, int need_enc, int enc)
+{
+    ssize_t len, clen;
+    const char *ep;
+
+    if (!XOIF_ISSET(xop, XOIF_STREAM) || xbp != &xop->xo_data
+	    || XOIF_ISSET(xop, XOIF_ANCHOR | XOIF_UNITS_PENDING)
+	    || XOF_ISSET(xop, XOF_COLUMNS)
+	    || xo_style(xop) == XO_STYLE_ENCODER
+	    || xo_style(xop) == XO_STYLE_SDPARAMS)
+	return -1;
+
+    len = strlen(cp);
+    if (len < XO_STREAM_MIN)
+	return -1;
+
+    xo_write(xop);
+
+    for (ep = cp + len; cp < ep; cp += clen) {
+	clen = ep - cp;
+	if (clen > XO_STREAM_CHUNK) {
+	    clen = XO_STREAM_CHUNK;
+
+	    /* Don't split a UTF-8 character */
+	    if (enc == XF_ENC_UTF8) {
+		while (clen > 1 && (cp[clen] & 0xc0) == 0x80)
+		    clen -= 1;
+	    }
+	}
+
+	if (enc == need_enc)
+	    xo_buf_escape(xop, xbp, cp, clen, flags);
+	else if (xo_format_string_direct(xop, xbp, flags, NULL, cp, clen,
+					 -1, need_enc, enc) < 0)
+	    break;
+
+	xo_write(xop);
+    }
+
+    return 0;
+}
+
 static ssize_t
 xo_format_string (xo_handle_t *xop, xo_buffer_t *xbp, xo_xff_flags_t flags,
 		  xo_format_t *xfp)
@@ -2903,7 +3997,7 @@ xo_format_string (xo_handle_t *xop, xo_buffer_t *xbp, xo_xff_flags_t flags,
     static char null[] = "(null)";
     static char null_no_quotes[] = "null";
 
-    char *cp = NULL;
+    const char *cp = NULL;
     wchar_t *wcp = NULL;
     ssize_t len;
     ssize_t cols = 0, rc = 0;
@@ -2921,6 +4015,13 @@ xo_format_string (xo_handle_t *xop, xo_buffer_t *xbp, xo_xff_flags_t flags,
 	    len = cp ? strlen(cp) : 0;
 	goto normal_string;
 
+    } else if (XOIF_ISSET(xop, XOIF_VALUES)) {
+	/* Typed values are always UTF-8 (see xo_do_format_field) */
+	char *vbuf = alloca(XO_VALUE_BUFSIZ);
+
+	cp = xo_value_string(xo_value_next(xop), vbuf);
+	goto normal_string;
+
     } else if (xfp->xf_enc == XF_ENC_WIDE) {
 	wcp = va_arg(xop->xo_vap, wchar_t *);
 	if (xfp->xf_skip)
@@ -2953,14 +4054,21 @@ xo_format_string (xo_handle_t *xop, xo_buffer_t *xbp, xo_xff_flags_t flags,
 	    }
 	}
 
+	int plain = (xfp->xf_width[XF_WIDTH_MIN] < 0
+		     && xfp->xf_width[XF_WIDTH_SIZE] < 0
+		     && xfp->xf_width[XF_WIDTH_MAX] < 0);
+
+	/* Large values are streamed out, leaving xo_data empty */
+	if (plain && (xfp->xf_enc == need_enc || xfp->xf_enc == XF_ENC_UTF8)
+		&& xo_stream_string(xop, xbp, flags, cp,
+				    need_enc, xfp->xf_enc) == 0)
+	    return 0;
+
 	/*
 	 * Optimize the most common case, which is "%s".  We just
 	 * need to copy the complete string to the output buffer.
 	 */
-	if (xfp->xf_enc == need_enc
-		&& xfp->xf_width[XF_WIDTH_MIN] < 0
-		&& xfp->xf_width[XF_WIDTH_SIZE] < 0
-		&& xfp->xf_width[XF_WIDTH_MAX] < 0
+	if (xfp->xf_enc == need_enc && plain
 	        && !(XOIF_ISSET(xop, XOIF_ANCHOR)
 		     || XOF_ISSET(xop, XOF_COLUMNS))) {
 	    len = strlen(cp);
@@ -2999,6 +4107,8 @@ xo_format_string (xo_handle_t *xop, xo_buffer_t *xbp, xo_xff_flags_t flags,
 	 * but if we did the work ourselves, then we need to do it.
 	 */
 	int delta = xfp->xf_width[XF_WIDTH_MIN] - cols;
+	char *pad;
+
 	if (!xo_buf_has_room(xbp, xfp->xf_width[XF_WIDTH_MIN]))
 	    goto bail;
 
@@ -3007,14 +4117,14 @@ xo_format_string (xo_handle_t *xop, xo_buffer_t *xbp, xo_xff_flags_t flags,
 	 * we can pad on the left.
 	 */
 	if (xfp->xf_seen_minus) {
-	    cp = xbp->xb_curp + rc;
+	    pad = xbp->xb_curp + rc;
 	} else {
-	    cp = xbp->xb_curp;
+	    pad = xbp->xb_curp;
 	    memmove(xbp->xb_curp + delta, xbp->xb_curp, rc);
 	}
 
 	/* Set the padding */
-	memset(cp, (xfp->xf_leading_zero > 0) ? '0' : ' ', delta);
+	memset(pad, (xfp->xf_leading_zero > 0) ? '0' : ' ', delta);
 	rc += delta;
 	cols += delta;
     }
@@ -3092,6 +4202,29 @@ xo_count_utf8_cols (const char *str, ssize_t len)
     return cols;
 }
 
+/*
+ * Translating a field ({g:} or {p:}) means a catalog search and a
+ * re-count of the result's width on every call, so each handle keeps
+ * a memo of its lookups, keyed by the domain, the msgid, and for
+ * plural forms, the msgid_plural and count.  We can't see the
+ * catalog's plural rules, so the count itself is the key, and only
+ * small counts are memoized.  Entries are single allocations.
+ */
+typedef struct xo_gt_memo_s {
+    struct xo_gt_memo_s *xgm_next; /* Next entry in the bucket */
+    uint32_t xgm_hash;		/* Hash of the key */
+    int xgm_cached;		/* Entry is held in the handle's memo */
+    int xgm_first;		/* Result is the msgid itself */
+    int xgm_plain;		/* Result needs no escaping in any style */
+    unsigned long xgm_n;	/* Count (for plural lookups) */
+    ssize_t xgm_len;		/* Length of the result */
+    ssize_t xgm_cols;		/* Width of the result, in columns */
+    const char *xgm_domain;	/* Our copy of the domain name */
+    const char *xgm_msgid;	/* Our copy of the msgid */
+    const char *xgm_plural;	/* Our copy of the msgid_plural (or NULL) */
+    const char *xgm_str;	/* Our copy of the result */
+} xo_gt_memo_t;
+
 #ifdef HAVE_GETTEXT
 static inline const char *
 xo_dgettext (xo_handle_t *xop, const char *str)
@@ -3127,6 +4260,219 @@ xo_dngettext (xo_handle_t *xop, const char *sing, const char *plural,
 
     return res;
 }
+
+#define XO_GT_HASH_INIT 2166136261U
+
+/*
+ * FNV-1a, continuing from 'hash'.  We include the trailing NUL, so
+ * that consecutive strings hash differently than their concatenation.
+ */
+static uint32_t
+xo_gettext_hash (uint32_t hash, const char *str)
+{
+    do {
+	hash ^= (uint8_t) *str;
+	hash *= 16777619U;
+    } while (*str++);
+
+    return hash;
+}
+
+/*
+ * Return non-zero if the LC_MESSAGES locale isn't the one recorded
+ * in *savedp, recording the current one.
+ */
+static int
+xo_gettext_locale_changed (char **savedp)
+{
+#ifdef LC_MESSAGES
+    const char *locale = setlocale(LC_MESSAGES, NULL);
+#else /* LC_MESSAGES */
+    const char *locale = setlocale(LC_ALL, NULL);
+#endif /* LC_MESSAGES */
+
+    if (locale == NULL)
+	locale = "";
+
+    if (*savedp && xo_streq(*savedp, locale))
+	return 0;
+
+    if (*savedp)
+	xo_free(*savedp);
+    *savedp = xo_strndup(locale, -1);
+
+    return 1;
+}
+
+#ifndef XO_GT_MEMO_SIZE
+#define XO_GT_MEMO_SIZE 6
+#endif /* XO_GT_MEMO_SIZE */
+#define GT_MEMO_HASH_SIZE (1<<XO_GT_MEMO_SIZE)
+
+#ifndef XO_GT_MEMO_MAX
+#define XO_GT_MEMO_MAX 512	/* Flush the memo when it's this full */
+#endif /* XO_GT_MEMO_MAX */
+
+#ifndef XO_GT_MEMO_MAX_N
+#define XO_GT_MEMO_MAX_N 256	/* Largest plural count we memoize */
+#endif /* XO_GT_MEMO_MAX_N */
+
+/*
+ * Bumped when this thread's format cache is cleared, which includes
+ * calls to xo_retain_clear_all, telling handles to discard their
+ * memos also.  The cache is thread-specific, so the generation is too.
+ */
+static THREAD_LOCAL(unsigned) xo_gt_generation;
+
+static void
+xo_gettext_memo_free (xo_handle_t *xop)
+{
+    int i;
+    xo_gt_memo_t *xgmp, *next;
+
+    if (xop->xo_gt_memo == NULL)
+	return;
+
+    for (i = 0; i < GT_MEMO_HASH_SIZE; i++) {
+	for (xgmp = xop->xo_gt_memo[i]; xgmp; xgmp = next) {
+	    next = xgmp->xgm_next;
+	    xo_free(xgmp);
+	}
+    }
+
+    xo_free(xop->xo_gt_memo);
+    xop->xo_gt_memo = NULL;
+    xop->xo_gt_memo_count = 0;
+}
+
+/*
+ * Record the length and width of the result, and whether it holds
+ * anything that some style would need to escape (or that isn't
+ * valid UTF-8).  The width is counted as xo_format_string_direct
+ * does.
+ */
+static void
+xo_gettext_memo_measure (xo_gt_memo_t *xgmp)
+{
+    const char *cp = xgmp->xgm_str;
+    ssize_t tlen, width;
+    wchar_t wc;
+
+    xgmp->xgm_len = strlen(cp);
+    xgmp->xgm_cols = 0;
+    xgmp->xgm_plain = 1;
+
+    for (; *cp; cp += tlen) {
+	tlen = xo_utf8_to_wc_len(cp);
+	if (tlen < 0 || (wc = xo_utf8_char(cp, tlen)) == (wchar_t) -1) {
+	    xgmp->xgm_plain = 0;
+	    return;
+	}
+
+	if (wc < 0x20 || wc == 0x7f || strchr("<>&\"\\]%", (int) wc))
+	    xgmp->xgm_plain = 0;
+
+	width = xo_wcwidth(wc);
+	if (width < 0)
+	    width = iswcntrl(wc) ? 0 : 1;
+
+	xgmp->xgm_cols += width;
+    }
+}
+
+/*
+ * Translate 'msgid' (or 'msgid'/'plural' for count 'n') using the
+ * handle's memo.  The caller must free the result unless xgm_cached
+ * is set.  NULL means the memo isn't in use (or we couldn't allocate
+ * an entry), and the caller should call xo_dgettext or xo_dngettext.
+ */
+static xo_gt_memo_t *
+xo_gettext_memo (xo_handle_t *xop, const char *msgid,
+		 const char *plural, unsigned long n)
+{
+    /* Logging wants to see every lookup, so it bypasses the memo */
+    if (XOF_ISSET(xop, XOF_RETAIN_NONE | XOF_LOG_GETTEXT)
+	    || (plural && n > XO_GT_MEMO_MAX_N))
+	return NULL;
+
+    const char *domain = xop->xo_gt_domain ?: textdomain(NULL);
+    if (domain == NULL)
+	domain = "";
+
+    uint32_t hash = xo_gettext_hash(xo_gettext_hash(XO_GT_HASH_INIT, domain),
+				    msgid);
+    if (plural) {
+	hash = xo_gettext_hash(hash, plural);
+	hash = (hash ^ (uint32_t) n) * 16777619U;
+    }
+
+    unsigned bucket = hash & (GT_MEMO_HASH_SIZE - 1);
+    xo_gt_memo_t *xgmp;
+
+    if (xo_gettext_locale_changed(&xop->xo_gt_memo_locale)
+	|| xop->xo_gt_memo_gen != xo_gt_generation) {
+	xo_gettext_memo_free(xop);
+	xop->xo_gt_memo_gen = xo_gt_generation;
+    }
+
+    if (xop->xo_gt_memo) {
+	for (xgmp = xop->xo_gt_memo[bucket]; xgmp; xgmp = xgmp->xgm_next)
+	    if (xgmp->xgm_hash == hash
+		&& xgmp->xgm_n == (plural ? n : 0)
+		&& xo_streq(xgmp->xgm_msgid, msgid)
+		&& (plural ? (xgmp->xgm_plural
+			      && xo_streq(xgmp->xgm_plural, plural))
+		    : xgmp->xgm_plural == NULL)
+		&& xo_streq(xgmp->xgm_domain, domain))
+		return xgmp;
+    }
+
+    const char *res = plural ? xo_dngettext(xop, msgid, plural, n)
+	: xo_dgettext(xop, msgid);
+
+    ssize_t dlen = strlen(domain) + 1, mlen = strlen(msgid) + 1;
+    ssize_t plen = plural ? strlen(plural) + 1 : 0, rlen = strlen(res) + 1;
+
+    xgmp = xo_realloc(NULL, sizeof(*xgmp) + dlen + mlen + plen + rlen);
+    if (xgmp == NULL)
+	return NULL;
+
+    bzero(xgmp, sizeof(*xgmp));
+    xgmp->xgm_hash = hash;
+    xgmp->xgm_n = plural ? n : 0;
+    xgmp->xgm_first = (res == msgid);
+
+    char *cp = (char *) &xgmp[1];
+    xgmp->xgm_domain = memcpy(cp, domain, dlen);
+    cp += dlen;
+    xgmp->xgm_msgid = memcpy(cp, msgid, mlen);
+    cp += mlen;
+    if (plural) {
+	xgmp->xgm_plural = memcpy(cp, plural, plen);
+	cp += plen;
+    }
+    xgmp->xgm_str = memcpy(cp, res, rlen);
+
+    xo_gettext_memo_measure(xgmp);
+
+    if (xop->xo_gt_memo_count >= XO_GT_MEMO_MAX)
+	xo_gettext_memo_free(xop);
+
+    if (xop->xo_gt_memo == NULL) {
+	ssize_t sz = GT_MEMO_HASH_SIZE * sizeof(xop->xo_gt_memo[0]);
+	xop->xo_gt_memo = xo_realloc(NULL, sz);
+	if (xop->xo_gt_memo == NULL)
+	    return xgmp;
+	bzero(xop->xo_gt_memo, sz);
+    }
+
+    xgmp->xgm_cached = 1;
+    xgmp->xgm_next = xop->xo_gt_memo[bucket];
+    xop->xo_gt_memo[bucket] = xgmp;
+    xop->xo_gt_memo_count += 1;
+
+    return xgmp;
+}
 #else /* HAVE_GETTEXT */
 static inline const char *
 xo_dgettext (xo_handle_t *xop UNUSED, const char *str)
@@ -3140,6 +4486,19 @@ xo_dngettext (xo_handle_t *xop UNUSED, const char *singular,
 {
     return (n == 1) ? singular : plural;
 }
+
+static void
+xo_gettext_memo_free (xo_handle_t *xop UNUSED)
+{
+    return;
+}
+
+static xo_gt_memo_t *
+xo_gettext_memo (xo_handle_t *xop UNUSED, const char *msgid UNUSED,
+		 const char *plural UNUSED, unsigned long n UNUSED)
+{
+    return NULL;
+}
 #endif /* HAVE_GETTEXT */
 
 /*
@@ -3164,6 +4523,7 @@ xo_format_gettext (xo_handle_t *xop, xo_xff_flags_t flags,
     char *cp = xbp->xb_bufp + start_offset;
     ssize_t len = xbp->xb_curp - cp;
     const char *newstr = NULL;
+    xo_gt_memo_t *xgmp = NULL;
 
     /*
      * The plural flag asks us to look backwards at the last numeric
@@ -3191,7 +4551,11 @@ xo_format_gettext (xo_handle_t *xop, xo_xff_flags_t flags,
 
 	*two++ = '\0';
 	if (flags & XFF_GT_FIELD) {
-	    newstr = xo_dngettext(xop, cp, two, n);
+	    xgmp = xo_gettext_memo(xop, cp, two, n);
+	    if (xgmp)
+		newstr = xgmp->xgm_first ? cp : xgmp->xgm_str;
+	    else
+		newstr = xo_dngettext(xop, cp, two, n);
 	} else {
 	    /* Don't do a gettext() look up, just get the plural form */
 	    newstr = (n == 1) ? cp : two;
@@ -3207,21 +4571,48 @@ xo_format_gettext (xo_handle_t *xop, xo_xff_flags_t flags,
 	     * If the caller wanted UTF8, we're done; nothing changed,
 	     * but we need to count the columns used.
 	     */
-	    if (need_enc == XF_ENC_UTF8)
-		return xo_count_utf8_cols(cp, xbp->xb_curp - cp);
+	    if (need_enc == XF_ENC_UTF8) {
+		cols = xo_count_utf8_cols(cp, xbp->xb_curp - cp);
+		goto done;
+	    }
 	}
 
     } else {
 	/* The simple case (singular) */
-	newstr = xo_dgettext(xop, cp);
+	xgmp = xo_gettext_memo(xop, cp, NULL, 0);
+	if (xgmp)
+	    newstr = xgmp->xgm_first ? cp : xgmp->xgm_str;
+	else
+	    newstr = xo_dgettext(xop, cp);
 
 	if (newstr == cp) {
 	    /* If the caller wanted UTF8, we're done; nothing changed */
 	    if (need_enc == XF_ENC_UTF8)
-		return cols;
+		goto done;
 	}
     }
 
+    if (xgmp && newstr == xgmp->xgm_str) {
+	/*
+	 * The memo holds its own copy of the string, along with its
+	 * width, so we can use it in place.  If there's nothing to
+	 * escape, we don't even need to walk it.
+	 */
+	xbp->xb_curp = xbp->xb_bufp + start_offset; /* Reset the buffer */
+
+	if (xgmp->xgm_plain && need_enc == XF_ENC_UTF8) {
+	    if (xo_buf_has_room(xbp, xgmp->xgm_len)) {
+		memcpy(xbp->xb_curp, xgmp->xgm_str, xgmp->xgm_len);
+		xbp->xb_curp += xgmp->xgm_len;
+		cols = xgmp->xgm_cols;
+	    }
+	} else
+	    cols = xo_format_string_direct(xop, xbp, flags, NULL,
+					   xgmp->xgm_str, xgmp->xgm_len, 0,
+					   need_enc, XF_ENC_UTF8);
+	goto done;
+    }
+
     /*
      * Since the new string string might be in gettext's buffer or
      * in the buffer (as the plural form), we make a copy.
@@ -3231,8 +4622,14 @@ xo_format_gettext (xo_handle_t *xop, xo_xff_flags_t flags,
     memcpy(newcopy, newstr, nlen + 1);
 
     xbp->xb_curp = xbp->xb_bufp + start_offset; /* Reset the buffer */
-    return xo_format_string_direct(xop, xbp, flags, NULL, newcopy, nlen, 0,
+    cols = xo_format_string_direct(xop, xbp, flags, NULL, newcopy, nlen, 0,
 				   need_enc, XF_ENC_UTF8);
+
+ done:
+    if (xgmp && !xgmp->xgm_cached)
+	xo_free(xgmp);
+
+    return cols;
 }
 
 static void
@@ -3302,39 +4699,236 @@ xo_trim_ws (xo_buffer_t *xbp, ssize_t len)
 }
 
 /*
- * Interface to format a single field.  The arguments are in xo_vap,
- * and the format is in 'fmt'.  If 'xbp' is null, we use xop->xo_data;
- * this is the most common case.
+ * Parse the flags, widths, and size modifiers of a single printf-style
+ * conversion into 'xfp', starting at the '%' at 'cp'.  Returns a
+ * pointer to the conversion character, or NULL on error.
  */
-static ssize_t
-xo_do_format_field (xo_handle_t *xop, xo_buffer_t *xbp,
-		const char *fmt, ssize_t flen, xo_xff_flags_t flags)
-{
-    xo_format_t xf;
-    const char *cp, *ep, *sp, *xp = NULL;
-    ssize_t rc, cols;
-    int style = (flags & XFF_XML) ? XO_STYLE_XML : xo_style(xop);
-    unsigned make_output = !(flags & XFF_NO_OUTPUT) ? 1 : 0;
-    int need_enc = xo_needed_encoding(xop);
-    int real_need_enc = need_enc;
-    ssize_t old_cols = xop->xo_columns;
+static const char *
+xo_format_parse (xo_handle_t *xop, xo_format_t *xfp,
+		 const char *cp, const char *ep, const char *fmt)
+{
+    for (cp += 1; cp < ep; cp++) {
+	if (*cp == 'l')
+	    xfp->xf_lflag += 1;
+	else if (*cp == 'h')
+	    xfp->xf_hflag += 1;
+	else if (*cp == 'j')
+	    xfp->xf_jflag += 1;
+	else if (*cp == 't')
+	    xfp->xf_tflag += 1;
+	else if (*cp == 'z')
+	    xfp->xf_zflag += 1;
+	else if (*cp == 'q')
+	    xfp->xf_qflag += 1;
+	else if (*cp == '.') {
+	    if (++xfp->xf_dots >= XF_WIDTH_NUM) {
+		xo_failure(xop, "Too many dots in format: '%s'", fmt);
+		return NULL;
+	    }
+	} else if (*cp == '-')
+	    xfp->xf_seen_minus = 1;
+	else if (isdigit((int) *cp)) {
+	    if (xfp->xf_leading_zero < 0)
+		xfp->xf_leading_zero = (*cp == '0');
+	    xo_bump_width(xfp, *cp - '0');
+	} else if (*cp == '*') {
+	    xfp->xf_stars += 1;
+	    xfp->xf_star[xfp->xf_dots] = 1;
+	} else if (strchr("diouxXDOUeEfFgGaAcCsSpm", *cp) != NULL)
+	    break;
+	else if (*cp == 'n' || *cp == 'v') {
+	    xo_failure(xop, "unsupported format: '%s'", fmt);
+	    return NULL;
+	}
+    }
 
-    /* The gettext interface is UTF-8, so we'll need that for now */
-    if (flags & XFF_GT_FIELD)
-	need_enc = XF_ENC_UTF8;
+    if (cp == ep)
+	xo_failure(xop, "field format missing format character: %s",
+		      fmt);
 
-    if (xbp == NULL)
-	xbp = &xop->xo_data;
+    xfp->xf_fc = *cp;
+    return cp;
+}
 
-    ssize_t start_offset = xo_buf_offset(xbp);
+/*
+ * Now for the tricky part: we need to move the argument pointer
+ * along by the amount needed for a conversion.  Star widths for
+ * strings have already been consumed, as have strings that were
+ * formatted (by xo_format_string).
+ */
+static void
+xo_format_skip_arg (xo_handle_t *xop, xo_format_t *xfp)
+{
+    if (XOIF_ISSET(xop, XOIF_VALUES)) {
+	/* Strings were used by xo_format_string, unless skipped */
+	if (xfp->xf_fc == 's' || xfp->xf_fc == 'S') {
+	    if (xfp->xf_skip)
+		xop->xo_values_cur += 1;
+	} else if (xfp->xf_fc != 'm')
+	    xop->xo_values_cur += xfp->xf_stars + 1;
 
-    for (cp = fmt, ep = fmt + flen; cp < ep; cp++) {
-	/*
-	 * Since we're starting a new field, save the starting offset.
-	 * We'll need this later for field-related operations.
-	 */
+    } else if (!XOF_ISSET(xop, XOF_NO_VA_ARG)) {
 
-	if (*cp != '%') {
+	if (xfp->xf_fc == 's' ||xfp->xf_fc == 'S') {
+	    /*
+	     * The 'S' and 's' formats are normally handled in
+	     * xo_format_string, but if we skipped it, then we
+	     * need to pop it.
+	     */
+	    if (xfp->xf_skip)
+		xo_next_string(xop);
+
+	} else if (xfp->xf_fc == 'm') {
+	    /* Nothing on the stack for "%m" */
+
+	} else {
+	    int s;
+	    for (s = 0; s < XF_WIDTH_NUM; s++) {
+		if (xfp->xf_star[s])
+		    va_arg(xop->xo_vap, int);
+	    }
+
+	    if (strchr("diouxXDOU", xfp->xf_fc) != NULL) {
+		if (xfp->xf_hflag > 1) {
+		    va_arg(xop->xo_vap, int);
+
+		} else if (xfp->xf_hflag > 0) {
+		    va_arg(xop->xo_vap, int);
+
+		} else if (xfp->xf_lflag > 1) {
+		    va_arg(xop->xo_vap, unsigned long long);
+
+		} else if (xfp->xf_lflag > 0) {
+		    va_arg(xop->xo_vap, unsigned long);
+
+		} else if (xfp->xf_jflag > 0) {
+		    va_arg(xop->xo_vap, intmax_t);
+
+		} else if (xfp->xf_tflag > 0) {
+		    va_arg(xop->xo_vap, ptrdiff_t);
+
+		} else if (xfp->xf_zflag > 0) {
+		    va_arg(xop->xo_vap, size_t);
+
+		} else if (xfp->xf_qflag > 0) {
+		    va_arg(xop->xo_vap, quad_t);
+
+		} else {
+		    va_arg(xop->xo_vap, int);
+		}
+	    } else if (strchr("eEfFgGaA", xfp->xf_fc) != NULL)
+		if (xfp->xf_lflag)
+		    va_arg(xop->xo_vap, long double);
+		else
+		    va_arg(xop->xo_vap, double);
+
+	    else if (xfp->xf_fc == 'C' || (xfp->xf_fc == 'c' && xfp->xf_lflag))
+		va_arg(xop->xo_vap, wint_t);
+
+	    else if (xfp->xf_fc == 'c')
+		va_arg(xop->xo_vap, int);
+
+	    else if (xfp->xf_fc == 'p')
+		va_arg(xop->xo_vap, void *);
+	}
+    }
+}
+
+/*
+ * Move past the arguments used by a format, without formatting
+ * anything.  Fields that make no output in the current style (such
+ * as encode-only fields in text) only need their arguments consumed,
+ * so we just walk the conversions, using the same rules as
+ * xo_do_format_field.
+ */
+static ssize_t
+xo_skip_format_args (xo_handle_t *xop, const char *fmt, ssize_t flen)
+{
+    xo_format_t xf;
+    const char *cp, *ep;
+    int s;
+
+    for (cp = fmt, ep = fmt + flen; cp < ep; cp++) {
+	if (*cp != '%') {
+	    if (*cp == '\\' && cp[1] != '\0')
+		cp += 1;
+	    continue;
+
+	} else if (cp + 1 < ep && cp[1] == '%') {
+	    cp += 1;
+	    continue;
+	}
+
+	bzero(&xf, sizeof(xf));
+	xf.xf_leading_zero = -1;
+	xf.xf_skip = 1;
+
+	/* "%@...@" flags, with a '*' using an argument */
+	if (cp[1] == '@') {
+	    for (cp += 2; cp < ep && *cp != '@'; cp++) {
+		if (*cp == '*' && !XOF_ISSET(xop, XOF_NO_VA_ARG))
+		    xo_next_int(xop);
+	    }
+	}
+
+	cp = xo_format_parse(xop, &xf, cp, ep, fmt);
+	if (cp == NULL)
+	    return -1;
+
+	if ((xf.xf_fc == 's' || xf.xf_fc == 'S')
+		&& !XOF_ISSET(xop, XOF_NO_VA_ARG)) {
+	    for (s = 0; s < XF_WIDTH_NUM; s++)
+		if (xf.xf_star[s])
+		    xo_next_int(xop);
+	}
+
+	if (xf.xf_fc == 'D' || xf.xf_fc == 'O' || xf.xf_fc == 'U')
+	    xf.xf_lflag = 1;
+
+	xo_format_skip_arg(xop, &xf);
+    }
+
+    return 0;
+}
+
+/*
+ * Interface to format a single field.  The arguments are in xo_vap,
+ * and the format is in 'fmt'.  If 'xbp' is null, we use xop->xo_data;
+ * this is the most common case.
+ */
+static ssize_t
+xo_do_format_field (xo_handle_t *xop, xo_buffer_t *xbp,
+		const char *fmt, ssize_t flen, xo_xff_flags_t flags)
+{
+    xo_format_t xf;
+    const char *cp, *ep, *sp, *xp = NULL;
+    ssize_t rc, cols;
+    int style = (flags & XFF_XML) ? XO_STYLE_XML : xo_style(xop);
+    unsigned make_output = !(flags & XFF_NO_OUTPUT) ? 1 : 0;
+    int need_enc = xo_needed_encoding(xop);
+    int real_need_enc = need_enc;
+    ssize_t old_cols = xop->xo_columns;
+
+    /* The gettext interface is UTF-8, so we'll need that for now */
+    if (flags & XFF_GT_FIELD)
+	need_enc = XF_ENC_UTF8;
+
+    /* Without output, we only need to consume our arguments */
+    if (!make_output)
+	return xo_skip_format_args(xop, fmt, flen);
+
+    if (xbp == NULL)
+	xbp = &xop->xo_data;
+
+    ssize_t start_offset = xo_buf_offset(xbp);
+
+    for (cp = fmt, ep = fmt + flen; cp < ep; cp++) {
+	/*
+	 * Since we're starting a new field, save the starting offset.
+	 * We'll need this later for field-related operations.
+	 */
+
+	if (*cp != '%') {
 	add_one:
 	    if (xp == NULL)
 		xp = cp;
@@ -3381,7 +4975,7 @@ xo_do_format_field (xo_handle_t *xop, xo_buffer_t *xbp,
 		     * we want to ignore
 		     */
 		    if (!XOF_ISSET(xop, XOF_NO_VA_ARG))
-			va_arg(xop->xo_vap, int);
+			xo_next_int(xop);
 		}
 	    }
 	}
@@ -3407,46 +5001,9 @@ xo_do_format_field (xo_handle_t *xop, xo_buffer_t *xbp,
 	 * Note that 'n', 'v', and '$' are not supported.
 	 */
 	sp = cp;		/* Save start pointer */
-	for (cp += 1; cp < ep; cp++) {
-	    if (*cp == 'l')
-		xf.xf_lflag += 1;
-	    else if (*cp == 'h')
-		xf.xf_hflag += 1;
-	    else if (*cp == 'j')
-		xf.xf_jflag += 1;
-	    else if (*cp == 't')
-		xf.xf_tflag += 1;
-	    else if (*cp == 'z')
-		xf.xf_zflag += 1;
-	    else if (*cp == 'q')
-		xf.xf_qflag += 1;
-	    else if (*cp == '.') {
-		if (++xf.xf_dots >= XF_WIDTH_NUM) {
-		    xo_failure(xop, "Too many dots in format: '%s'", fmt);
-		    return -1;
-		}
-	    } else if (*cp == '-')
-		xf.xf_seen_minus = 1;
-	    else if (isdigit((int) *cp)) {
-		if (xf.xf_leading_zero < 0)
-		    xf.xf_leading_zero = (*cp == '0');
-		xo_bump_width(&xf, *cp - '0');
-	    } else if (*cp == '*') {
-		xf.xf_stars += 1;
-		xf.xf_star[xf.xf_dots] = 1;
-	    } else if (strchr("diouxXDOUeEfFgGaAcCsSpm", *cp) != NULL)
-		break;
-	    else if (*cp == 'n' || *cp == 'v') {
-		xo_failure(xop, "unsupported format: '%s'", fmt);
-		return -1;
-	    }
-	}
-
-	if (cp == ep)
-	    xo_failure(xop, "field format missing format character: %s",
-			  fmt);
-
-	xf.xf_fc = *cp;
+	cp = xo_format_parse(xop, &xf, cp, ep, fmt);
+	if (cp == NULL)
+	    return -1;
 
 	if (!XOF_ISSET(xop, XOF_NO_VA_ARG)) {
 	    if (*cp == 's' || *cp == 'S') {
@@ -3454,7 +5011,7 @@ xo_do_format_field (xo_handle_t *xop, xo_buffer_t *xbp,
 		int s;
 		for (s = 0; s < XF_WIDTH_NUM; s++) {
 		    if (xf.xf_star[s]) {
-			xf.xf_width[s] = va_arg(xop->xo_vap, int);
+			xf.xf_width[s] = xo_next_int(xop);
 			
 			/* Normalize a negative width value */
 			if (xf.xf_width[s] < 0) {
@@ -3492,11 +5049,12 @@ xo_do_format_field (xo_handle_t *xop, xo_buffer_t *xbp,
 	     * functions won't handle field widths for wide characters
 	     * correctly.  So we have to handle this ourselves.
 	     */
-	    if (xop->xo_formatter == NULL
+	    if ((xop->xo_formatter == NULL || XOIF_ISSET(xop, XOIF_VALUES))
 		    && (xf.xf_fc == 's' || xf.xf_fc == 'S'
 			|| xf.xf_fc == 'm')) {
 
 		xf.xf_enc = (xf.xf_fc == 'm') ? XF_ENC_UTF8
+		    : XOIF_ISSET(xop, XOIF_VALUES) ? XF_ENC_UTF8
 		    : (xf.xf_lflag || (xf.xf_fc == 'S')) ? XF_ENC_WIDE
 		    : xf.xf_hflag ? XF_ENC_LOCALE : XF_ENC_UTF8;
 
@@ -3506,8 +5064,9 @@ xo_do_format_field (xo_handle_t *xop, xo_buffer_t *xbp,
 		    rc = xo_trim_ws(xbp, rc);
 
 	    } else {
-		ssize_t columns = rc = xo_vsnprintf(xop, xbp, newfmt,
-						    xop->xo_vap);
+		ssize_t columns = rc = XOIF_ISSET(xop, XOIF_VALUES)
+		    ? xo_value_format(xop, xbp, newfmt)
+		    : xo_vsnprintf(xop, xbp, newfmt, xop->xo_vap);
 
 		if (rc > 0) {
 		    /*
@@ -3559,75 +5118,7 @@ xo_do_format_field (xo_handle_t *xop, xo_buffer_t *xbp,
 		xbp->xb_curp += rc;
 	}
 
-	/*
-	 * Now for the tricky part: we need to move the argument pointer
-	 * along by the amount needed.
-	 */
-	if (!XOF_ISSET(xop, XOF_NO_VA_ARG)) {
-
-	    if (xf.xf_fc == 's' ||xf.xf_fc == 'S') {
-		/*
-		 * The 'S' and 's' formats are normally handled in
-		 * xo_format_string, but if we skipped it, then we
-		 * need to pop it.
-		 */
-		if (xf.xf_skip)
-		    va_arg(xop->xo_vap, char *);
-
-	    } else if (xf.xf_fc == 'm') {
-		/* Nothing on the stack for "%m" */
-
-	    } else {
-		int s;
-		for (s = 0; s < XF_WIDTH_NUM; s++) {
-		    if (xf.xf_star[s])
-			va_arg(xop->xo_vap, int);
-		}
-
-		if (strchr("diouxXDOU", xf.xf_fc) != NULL) {
-		    if (xf.xf_hflag > 1) {
-			va_arg(xop->xo_vap, int);
-
-		    } else if (xf.xf_hflag > 0) {
-			va_arg(xop->xo_vap, int);
-
-		    } else if (xf.xf_lflag > 1) {
-			va_arg(xop->xo_vap, unsigned long long);
-
-		    } else if (xf.xf_lflag > 0) {
-			va_arg(xop->xo_vap, unsigned long);
-
-		    } else if (xf.xf_jflag > 0) {
-			va_arg(xop->xo_vap, intmax_t);
-
-		    } else if (xf.xf_tflag > 0) {
-			va_arg(xop->xo_vap, ptrdiff_t);
-
-		    } else if (xf.xf_zflag > 0) {
-			va_arg(xop->xo_vap, size_t);
-
-		    } else if (xf.xf_qflag > 0) {
-			va_arg(xop->xo_vap, quad_t);
-
-		    } else {
-			va_arg(xop->xo_vap, int);
-		    }
-		} else if (strchr("eEfFgGaA", xf.xf_fc) != NULL)
-		    if (xf.xf_lflag)
-			va_arg(xop->xo_vap, long double);
-		    else
-			va_arg(xop->xo_vap, double);
-
-		else if (xf.xf_fc == 'C' || (xf.xf_fc == 'c' && xf.xf_lflag))
-		    va_arg(xop->xo_vap, wint_t);
-
-		else if (xf.xf_fc == 'c')
-		    va_arg(xop->xo_vap, int);
-
-		else if (xf.xf_fc == 'p')
-		    va_arg(xop->xo_vap, void *);
-	    }
-	}
+	xo_format_skip_arg(xop, &xf);
     }
 
     if (xp) {
@@ -3800,210 +5291,721 @@ xo_format_humanize (xo_handle_t *xop, xo_buffer_t *xbp,
 }
 
 /*
- * Convenience function that either append a fixed value (if one is
- * given) or formats a field using a format string.  If it's
- * encode_only, then we can't skip formatting the field, since it may
- * be pulling arguments off the stack.
+ * Return the number of significant bits in a value (zero for zero)
  */
-static inline void
-xo_simple_field (xo_handle_t *xop, unsigned encode_only,
-		      const char *value, ssize_t vlen,
-		      const char *fmt, ssize_t flen, xo_xff_flags_t flags)
+static inline unsigned
+xo_humanize_bits (uint64_t value)
 {
-    if (encode_only)
-	flags |= XFF_NO_OUTPUT;
+#ifdef __GNUC__
+    return value ? 64 - __builtin_clzll(value) : 0;
+#else /* __GNUC__ */
+    unsigned bits = 0;
 
-    if (vlen == 0)
-	xo_do_format_field(xop, NULL, fmt, flen, flags);
-    else if (!encode_only)
-	xo_data_append_content(xop, value, vlen, flags);
+    for ( ; value; value >>= 1)
+	bits += 1;
+    return bits;
+#endif /* __GNUC__ */
 }
 
 /*
- * Html mode: append a <div> to the output buffer contain a field
- * along with all the supporting information indicated by the flags.
+ * Write a value's decimal digits into "buf", returning the length
  */
-static void
-xo_buf_append_div (xo_handle_t *xop, const char *class, xo_xff_flags_t flags,
-		   const char *name, ssize_t nlen,
-		   const char *value, ssize_t vlen,
-		   const char *fmt, ssize_t flen,
-		   const char *encoding, ssize_t elen)
+static ssize_t
+xo_humanize_digits (char *buf, uint64_t value)
 {
-    static char div_start[] = "<div class=\"";
-    static char div_tag[] = "\" data-tag=\"";
-    static char div_xpath[] = "\" data-xpath=\"";
-    static char div_key[] = "\" data-key=\"key";
-    static char div_end[] = "\">";
-    static char div_close[] = "</div>";
+    char tmp[24], *cp = tmp + sizeof(tmp);
+    ssize_t len;
 
-    /* The encoding format defaults to the normal format */
-    if (encoding == NULL && fmt != NULL) {
-	char *enc  = alloca(flen + 1);
-	memcpy(enc, fmt, flen);
-	enc[flen] = '\0';
-	encoding = xo_fix_encoding(xop, enc);
-	elen = strlen(encoding);
+    do {
+	*--cp = '0' + (value % 10);
+	value /= 10;
+    } while (value);
+
+    len = (tmp + sizeof(tmp)) - cp;
+    memcpy(buf, cp, len);
+    return len;
+}
+
+/*
+ * Humanize an integer directly, giving the same results as
+ * xo_humanize (and humanize_number) for non-negative values that
+ * fit in an int64_t.  Instead of dividing once per scale, we find
+ * the scale from the number of significant bits, and the scaled
+ * value (times 100, for rounding) in a single step.  "buf" must
+ * have room for 32 bytes.
+ */
+static ssize_t
+xo_humanize_value (char *buf, uint64_t value, int flags)
+{
+    static const uint64_t pow1000[] = {
+	1ULL, 1000ULL, 1000000ULL, 1000000000ULL, 1000000000000ULL,
+	1000000000000000ULL, 1000000000000000000ULL,
+    };
+    static const char *prefix1024[] = { "", "K", "M", "G", "T", "P", "E" };
+    static const char *prefix1000[] = { "", "k", "M", "G", "T", "P", "E" };
+    unsigned bits = xo_humanize_bits(value);
+    unsigned scale;
+    uint64_t scaled;		/* value * 100 / divisor^scale */
+    const char *prefix;
+    char *cp = buf;
+
+    if (flags & HN_DIVISOR_1000) {
+	/* 1000^n is a bit less than 1024^n, so we may be one short */
+	scale = bits ? (bits - 1) / 10 : 0;
+	if (scale < 6 && value >= pow1000[scale + 1])
+	    scale += 1;
+	scaled = scale ? value / (pow1000[scale] / 100) : 0;
+	prefix = prefix1000[scale];
+
+    } else {
+	scale = bits ? (bits - 1) / 10 : 0;
+	if (scale) {
+	    /* value * 25 / 2^(10*scale - 2), without overflowing */
+	    unsigned shift = 10 * scale - 2;
+	    uint64_t low = value & ((1ULL << shift) - 1);
+
+	    scaled = (value >> shift) * 25 + ((low * 25) >> shift);
+	} else
+	    scaled = 0;
+	prefix = prefix1024[scale];
     }
 
-    /*
-     * To build our XPath predicate, we need to save the va_list before
-     * we format our data, and then restore it before we format the
-     * xpath expression.
-     * Display-only keys implies that we've got an encode-only key
-     * elsewhere, so we don't use them from making predicates.
-     */
-    int need_predidate = 
-	(name && (flags & XFF_KEY) && !(flags & XFF_DISPLAY_ONLY)
-	 && XOF_ISSET(xop, XOF_XPATH)) ? 1 : 0;
+    if (scale == 0) {
+	cp += xo_humanize_digits(cp, value);
 
-    if (need_predidate) {
-	va_list va_local;
+    } else if (scaled < 995 && (flags & HN_DECIMAL)) {
+	unsigned b = (scaled + 5) / 10;
+	const char *dp = localeconv()->decimal_point;
+	ssize_t dlen = strlen(dp);
 
-	va_copy(va_local, xop->xo_vap);
-	if (xop->xo_checkpointer)
-	    xop->xo_checkpointer(xop, xop->xo_vap, 0);
+	*cp++ = '0' + b / 10;
+	if (dlen > 8)		/* Should not occur */
+	    return -1;
+	memcpy(cp, dp, dlen);
+	cp += dlen;
+	*cp++ = '0' + b % 10;
 
-	/*
-	 * Build an XPath predicate expression to match this key.
-	 * We use the format buffer.
-	 */
-	xo_buffer_t *pbp = &xop->xo_predicate;
-	pbp->xb_curp = pbp->xb_bufp; /* Restart buffer */
+    } else
+	cp += xo_humanize_digits(cp, (scaled + 50) / 100);
 
-	xo_buf_append(pbp, "[", 1);
-	xo_buf_escape(xop, pbp, name, nlen, 0);
-	if (XOF_ISSET(xop, XOF_PRETTY))
-	    xo_buf_append(pbp, " = '", 4);
-	else
-	    xo_buf_append(pbp, "='", 2);
+    if (!(flags & HN_NOSPACE))
+	*cp++ = ' ';
+    if (*prefix)
+	*cp++ = *prefix;
+    *cp = '\0';
 
-	xo_xff_flags_t pflags = flags | XFF_XML | XFF_ATTR;
-	pflags &= ~(XFF_NO_OUTPUT | XFF_ENCODE_ONLY);
-	xo_do_format_field(xop, pbp, encoding, elen, pflags);
+    return cp - buf;
+}
 
-	xo_buf_append(pbp, "']", 2);
+/*
+ * The direct path for humanizing: when a field's format is a single
+ * integer conversion (e.g. "%ju"), we can pull the argument and
+ * humanize it, rather than formatting it as text, turning that text
+ * back into a number, and then humanizing that.  Returns -1 (without
+ * touching xo_vap) if the format isn't one we can handle.
+ */
+static int
+xo_format_humanize_direct (xo_handle_t *xop, xo_buffer_t *xbp,
+			   const char *fmt, ssize_t flen,
+			   xo_xff_flags_t flags)
+{
+    const char *cp = fmt, *ep = fmt + flen;
+    unsigned hflag = 0, lflag = 0, jflag = 0, tflag = 0, zflag = 0, qflag = 0;
+    uint64_t value;
+    int is_signed;
 
-	/* Now we record this predicate expression in the stack */
-	xo_stack_t *xsp = &xop->xo_stack[xop->xo_depth];
-	ssize_t olen = xsp->xs_keys ? strlen(xsp->xs_keys) : 0;
-	ssize_t dlen = pbp->xb_curp - pbp->xb_bufp;
+    if (XOF_ISSET(xop, XOF_NO_HUMANIZE | XOF_NO_VA_ARG)
+	    || XOIF_ISSET(xop, XOIF_VALUES)
+	    || xop->xo_formatter != NULL
+	    || (flags & (XFF_NO_OUTPUT | XFF_GT_FLAGS)))
+	return -1;
 
-	char *cp = xo_realloc(xsp->xs_keys, olen + dlen + 1);
-	if (cp) {
-	    memcpy(cp + olen, pbp->xb_bufp, dlen);
-	    cp[olen + dlen] = '\0';
-	    xsp->xs_keys = cp;
-	}
+    if (flen < 2 || *cp++ != '%')
+	return -1;
 
-	/* Now we reset the xo_vap as if we were never here */
-	va_end(xop->xo_vap);
-	va_copy(xop->xo_vap, va_local);
-	va_end(va_local);
-	if (xop->xo_checkpointer)
-	    xop->xo_checkpointer(xop, xop->xo_vap, 1);
-    }
+    /* Flags and widths don't survive humanizing, so we skip them */
+    for ( ; cp < ep && strchr("-+ #0123456789", *cp); cp++)
+	continue;
 
-    if (flags & XFF_ENCODE_ONLY) {
-	/*
-	 * Even if this is encode-only, we need to go through the
-	 * work of formatting it to make sure the args are cleared
-	 * from xo_vap.  This is not true when vlen is zero, since
-	 * that means our "value" isn't on the stack.
-	 */
-	xo_simple_field(xop, TRUE, NULL, 0, encoding, elen, flags);
-	return;
+    for ( ; cp < ep; cp++) {
+	if (*cp == 'h')
+	    hflag += 1;
+	else if (*cp == 'l')
+	    lflag += 1;
+	else if (*cp == 'j')
+	    jflag += 1;
+	else if (*cp == 't')
+	    tflag += 1;
+	else if (*cp == 'z')
+	    zflag += 1;
+	else if (*cp == 'q')
+	    qflag += 1;
+	else
+	    break;
     }
 
-    xo_line_ensure_open(xop, 0);
+    if (cp + 1 != ep || strchr("diuDU", *cp) == NULL)
+	return -1;
 
-    if (XOF_ISSET(xop, XOF_PRETTY))
-	xo_buf_indent(xop, xop->xo_indent_by);
+    is_signed = (*cp != 'u' && *cp != 'U');
+    if (*cp == 'D' || *cp == 'U')
+	lflag = 1;
 
-    xo_data_append(xop, div_start, sizeof(div_start) - 1);
-    xo_data_append(xop, class, strlen(class));
+    /* Pop the argument, following xo_do_format_field's lead */
+    if (hflag > 1) {
+	int val = va_arg(xop->xo_vap, int);
+	value = is_signed ? (uint64_t) (signed char) val
+	    : (uint64_t) (unsigned char) val;
 
-    /*
-     * If the color buffer has content, we add it now.  It's already
-     * prebuilt and ready, since we want to add it to every <div>.
-     */
-    if (!xo_buf_is_empty(&xop->xo_color_buf)) {
-	xo_buffer_t *xbp = &xop->xo_color_buf;
+    } else if (hflag > 0) {
+	int val = va_arg(xop->xo_vap, int);
+	value = is_signed ? (uint64_t) (short) val
+	    : (uint64_t) (unsigned short) val;
 
-	xo_data_append(xop, xbp->xb_bufp, xbp->xb_curp - xbp->xb_bufp);
-    }
+    } else if (lflag > 1) {
+	unsigned long long val = va_arg(xop->xo_vap, unsigned long long);
+	value = is_signed ? (uint64_t) (long long) val : (uint64_t) val;
 
-    if (name) {
-	xo_data_append(xop, div_tag, sizeof(div_tag) - 1);
-	xo_data_escape(xop, name, nlen);
+    } else if (lflag > 0) {
+	unsigned long val = va_arg(xop->xo_vap, unsigned long);
+	value = is_signed ? (uint64_t) (long) val : (uint64_t) val;
 
-	/*
-	 * Save the offset at which we'd place units.  See xo_format_units.
-	 */
-	if (XOF_ISSET(xop, XOF_UNITS)) {
-	    XOIF_SET(xop, XOIF_UNITS_PENDING);
-	    /*
-	     * Note: We need the '+1' here because we know we've not
-	     * added the closing quote.  We add one, knowing the quote
-	     * will be added shortly.
-	     */
-	    xop->xo_units_offset =
-		xop->xo_data.xb_curp -xop->xo_data.xb_bufp + 1;
-	}
+    } else if (jflag > 0) {
+	value = (uint64_t) va_arg(xop->xo_vap, intmax_t);
 
-	if (XOF_ISSET(xop, XOF_XPATH)) {
-	    int i;
-	    xo_stack_t *xsp;
+    } else if (tflag > 0) {
+	ptrdiff_t val = va_arg(xop->xo_vap, ptrdiff_t);
+	value = is_signed ? (uint64_t) val : (uint64_t) (size_t) val;
 
-	    xo_data_append(xop, div_xpath, sizeof(div_xpath) - 1);
-	    if (xop->xo_leading_xpath)
-		xo_data_append(xop, xop->xo_leading_xpath,
-			       strlen(xop->xo_leading_xpath));
+    } else if (zflag > 0) {
+	size_t val = va_arg(xop->xo_vap, size_t);
+	value = is_signed ? (uint64_t) (ssize_t) val : (uint64_t) val;
 
-	    for (i = 0; i <= xop->xo_depth; i++) {
-		xsp = &xop->xo_stack[i];
-		if (xsp->xs_name == NULL)
-		    continue;
+    } else if (qflag > 0) {
+	value = (uint64_t) va_arg(xop->xo_vap, quad_t);
 
-		/*
-		 * XSS_OPEN_LIST and XSS_OPEN_LEAF_LIST stack frames
-		 * are directly under XSS_OPEN_INSTANCE frames so we
-		 * don't need to put these in our XPath expressions.
-		 */
-		if (xsp->xs_state == XSS_OPEN_LIST
-			|| xsp->xs_state == XSS_OPEN_LEAF_LIST)
-		    continue;
+    } else {
+	int val = va_arg(xop->xo_vap, int);
+	value = is_signed ? (uint64_t) val : (uint64_t) (unsigned) val;
+    }
+
+    if (!xo_buf_has_room(xbp, 32))
+	return 0;
+
+    ssize_t rc;
+    int hn_flags = HN_NOSPACE; /* On by default */
+
+    if (flags & XFF_HN_SPACE)
+	hn_flags &= ~HN_NOSPACE;
+
+    if (flags & XFF_HN_DECIMAL)
+	hn_flags |= HN_DECIMAL;
+
+    if (flags & XFF_HN_1000)
+	hn_flags |= HN_DIVISOR_1000;
+
+    /*
+     * Negative values (which turn into huge unsigned ones) get the
+     * same treatment they'd get from the text path.
+     */
+    if ((int64_t) value < 0)
+	rc = xo_humanize(xbp->xb_curp, xbp->xb_size
+			 - (xbp->xb_curp - xbp->xb_bufp), value, hn_flags);
+    else
+	rc = xo_humanize_value(xbp->xb_curp, value, hn_flags);
+
+    if (rc > 0) {
+	xbp->xb_curp += rc;
+	xop->xo_columns += rc;
+	xop->xo_anchor_columns += rc;
+    }
+
+    return 0;
+}
+
+/*
+ * Convenience function that either append a fixed value (if one is
+ * given) or formats a field using a format string.  If it's
+ * encode_only, we make no output, but a format may still be pulling
+ * arguments off the stack, so we skip past them.
+ */
+static inline void
+xo_simple_field (xo_handle_t *xop, unsigned encode_only,
+		      const char *value, ssize_t vlen,
+		      const char *fmt, ssize_t flen, xo_xff_flags_t flags)
+{
+    if (encode_only) {
+	if (vlen == 0)
+	    xo_skip_format_args(xop, fmt, flen);
+    } else if (vlen == 0) {
+	/* Nothing revisits a plain value, so it can be streamed */
+	if (!(flags & (XFF_HUMANIZE | XFF_TRIM_WS | XFF_GT_FLAGS)))
+	    XOIF_SET(xop, XOIF_STREAM);
+	xo_do_format_field(xop, NULL, fmt, flen, flags);
+	XOIF_CLEAR(xop, XOIF_STREAM);
+    } else
+	xo_data_append_content(xop, value, vlen, flags);
+}
+
+/*
+ * The "html-compact" option uses short class names, since the
+ * markup is often many times the size of the data it holds.
+ * xohtml.css styles both forms.
+ */
+static const struct {
+    const char *xhc_name;	/* Normal class name */
+    const char *xhc_short;	/* Compact class name */
+} xo_html_classes[] = {
+    { "data", "d" },
+    { "decoration", "c" },
+    { "error", "e" },
+    { "label", "l" },
+    { "message", "m" },
+    { "note", "n" },
+    { "padding", "p" },
+    { "text", "x" },
+    { "title", "h" },
+    { "units", "u" },
+    { "warning", "w" },
+    { NULL, NULL }
+};
+
+static const char *
+xo_html_class (xo_handle_t *xop, const char *class)
+{
+    int i;
+
+    if (!XOF_ISSET(xop, XOF_HTML_COMPACT))
+	return class;
+
+    for (i = 0; xo_html_classes[i].xhc_name; i++)
+	if (xo_streq(xo_html_classes[i].xhc_name, class))
+	    return xo_html_classes[i].xhc_short;
+
+    return class;
+}
+
+/*
+ * With "html-tags", each tag name is given a number the first time
+ * it's seen, and fields use 'data-t="<number>"' instead of
+ * 'data-tag="<name>"'.  The name (and any data-type and data-help
+ * info) is given once, in an empty '<div class="tg">' before the
+ * first field that uses it.
+ */
+#define XO_TAGDICT_BUCKETS 64	/* Must be a power of two */
+
+typedef struct xo_tagdict_entry_s {
+    char *xte_name;		/* Tag name */
+    ssize_t xte_len;		/* Length of xte_name */
+    uint32_t xte_hash;		/* Hash of xte_name */
+    unsigned xte_next;		/* Next entry in bucket (plus one) */
+} xo_tagdict_entry_t;
+
+typedef struct xo_tagdict_s {
+    unsigned xtd_count;		/* Number of entries */
+    unsigned xtd_size;		/* Size of xtd_entries */
+    xo_tagdict_entry_t *xtd_entries; /* Entries, in order of first use */
+    unsigned xtd_bucket[XO_TAGDICT_BUCKETS]; /* First entry (plus one) */
+} xo_tagdict_t;
+
+/*
+ * Find the number for a tag name, adding it if needed, in which case
+ * "*newp" is set.  Returns -1 on failure.
+ */
+static int
+xo_tagdict_lookup (xo_handle_t *xop, const char *name, ssize_t nlen,
+		   int *newp)
+{
+    xo_tagdict_t *xtdp = xop->xo_tagdict;
+    xo_tagdict_entry_t *xtep;
+    uint32_t hash = 2166136261U;
+    unsigned num;
+    ssize_t i;
+
+    *newp = FALSE;
+
+    if (xtdp == NULL) {
+	xtdp = xo_realloc(NULL, sizeof(*xtdp));
+	if (xtdp == NULL)
+	    return -1;
+	bzero(xtdp, sizeof(*xtdp));
+	xop->xo_tagdict = xtdp;
+    }
+
+    for (i = 0; i < nlen; i++) {
+	hash ^= (uint8_t) name[i];
+	hash *= 16777619U;
+    }
+
+    for (num = xtdp->xtd_bucket[hash & (XO_TAGDICT_BUCKETS - 1)]; num;
+	 num = xtep->xte_next) {
+	xtep = &xtdp->xtd_entries[num - 1];
+	if (xtep->xte_hash == hash && xtep->xte_len == nlen
+		&& memcmp(xtep->xte_name, name, nlen) == 0)
+	    return num - 1;
+    }
+
+    if (xtdp->xtd_count >= xtdp->xtd_size) {
+	unsigned size = xtdp->xtd_size ? xtdp->xtd_size * 2 : 32;
+	xtep = xo_realloc(xtdp->xtd_entries, size * sizeof(*xtep));
+	if (xtep == NULL)
+	    return -1;
+	xtdp->xtd_entries = xtep;
+	xtdp->xtd_size = size;
+    }
+
+    char *cp = xo_strndup(name, nlen);
+    if (cp == NULL)
+	return -1;
+
+    num = xtdp->xtd_count++;
+    xtep = &xtdp->xtd_entries[num];
+    xtep->xte_name = cp;
+    xtep->xte_len = nlen;
+    xtep->xte_hash = hash;
+    xtep->xte_next = xtdp->xtd_bucket[hash & (XO_TAGDICT_BUCKETS - 1)];
+    xtdp->xtd_bucket[hash & (XO_TAGDICT_BUCKETS - 1)] = num + 1;
+
+    *newp = TRUE;
+    return num;
+}
+
+static void
+xo_tagdict_free (xo_handle_t *xop)
+{
+    xo_tagdict_t *xtdp = xop->xo_tagdict;
+    unsigned i;
+
+    if (xtdp == NULL)
+	return;
+
+    for (i = 0; i < xtdp->xtd_count; i++)
+	xo_free(xtdp->xtd_entries[i].xte_name);
+    xo_free(xtdp->xtd_entries);
+    xo_free(xtdp);
+    xop->xo_tagdict = NULL;
+}
+
+/*
+ * Append the data-type and data-help attributes for a field.  Like
+ * the other attributes, these start by closing the previous one.
+ */
+static void
+xo_html_info (xo_handle_t *xop, const char *name, ssize_t nlen)
+{
+    static char in_type[] = "\" data-type=\"";
+    static char in_help[] = "\" data-help=\"";
+
+    if (!XOF_ISSET(xop, XOF_INFO) || xop->xo_info == NULL)
+	return;
+
+    xo_info_t *xip = xo_info_find(xop, name, nlen);
+    if (xip) {
+	if (xip->xi_type) {
+	    xo_data_append(xop, in_type, sizeof(in_type) - 1);
+	    xo_data_escape(xop, xip->xi_type, strlen(xip->xi_type));
+	}
+	if (xip->xi_help) {
+	    xo_data_append(xop, in_help, sizeof(in_help) - 1);
+	    xo_data_escape(xop, xip->xi_help, strlen(xip->xi_help));
+	}
+    }
+}
+
+/*
+ * Append the XPath of the current stack frame (the part of a field's
+ * XPath before the field's name) to the given buffer.  Key fields
+ * don't include their own keys.
+ *
+ * Since each frame's XPath is its parent's plus its own name and
+ * keys, xo_xpath holds them all, and each frame records where its
+ * part ends.  Only frames opened (or given keys) since the last
+ * field need to be rendered, rather than the whole stack.
+ */
+static void
+xo_html_xpath_prefix (xo_handle_t *xop, xo_buffer_t *xbp,
+		      xo_xff_flags_t flags)
+{
+    xo_buffer_t *pbp = &xop->xo_xpath;
+    xo_stack_t *xsp;
+    int i = xop->xo_xpath_valid;
+
+    if (pbp->xb_bufp == NULL)
+	xo_buf_init(pbp);
+
+    if (i == 0) {
+	pbp->xb_curp = pbp->xb_bufp;
+	if (xop->xo_leading_xpath)
+	    xo_buf_append(pbp, xop->xo_leading_xpath,
+			  strlen(xop->xo_leading_xpath));
+    } else
+	pbp->xb_curp = pbp->xb_bufp + xop->xo_stack[i - 1].xs_xpath_end;
+
+    for (; i <= xop->xo_depth; i++) {
+	xsp = &xop->xo_stack[i];
+
+	/*
+	 * XSS_OPEN_LIST and XSS_OPEN_LEAF_LIST stack frames
+	 * are directly under XSS_OPEN_INSTANCE frames so we
+	 * don't need to put these in our XPath expressions.
+	 */
+	if (xsp->xs_name && xsp->xs_state != XSS_OPEN_LIST
+		&& xsp->xs_state != XSS_OPEN_LEAF_LIST) {
+	    xo_buf_append(pbp, "/", 1);
+	    xo_buf_escape(xop, pbp, xsp->xs_name, strlen(xsp->xs_name), 0);
+	    xsp->xs_xpath_nokeys = pbp->xb_curp - pbp->xb_bufp;
+	    xo_buf_append(pbp, xsp->xs_keys.xb_bufp,
+			  xo_buf_offset(&xsp->xs_keys));
+	} else
+	    xsp->xs_xpath_nokeys = pbp->xb_curp - pbp->xb_bufp;
+
+	xsp->xs_xpath_end = pbp->xb_curp - pbp->xb_bufp;
+    }
+
+    xop->xo_xpath_valid = xop->xo_depth + 1;
+
+    xsp = &xop->xo_stack[xop->xo_depth];
+    xo_buf_append(xbp, pbp->xb_bufp,
+		  (flags & XFF_KEY) ? xsp->xs_xpath_nokeys : xsp->xs_xpath_end);
+}
+
+/*
+ * In compact mode, fields other than keys don't carry their own
+ * data-xpath attribute.  Instead, the prefix is given in an empty
+ * '<div class="xp">' whenever it changes, and the field's XPath is
+ * that prefix plus its tag name.
+ */
+static void
+xo_html_xpath_marker (xo_handle_t *xop)
+{
+    static char div_xp[] = "<div class=\"xp\" data-xpath=\"";
+    static char div_end[] = "\"></div>";
+    xo_buffer_t *pbp = &xop->xo_predicate;
+    xo_buffer_t *lbp = &xop->xo_xpath_last;
+
+    pbp->xb_curp = pbp->xb_bufp; /* Restart buffer */
+    xo_html_xpath_prefix(xop, pbp, 0);
+
+    ssize_t len = pbp->xb_curp - pbp->xb_bufp;
+    if (lbp->xb_bufp && len == lbp->xb_curp - lbp->xb_bufp
+	    && memcmp(pbp->xb_bufp, lbp->xb_bufp, len) == 0)
+	return;
+
+    lbp->xb_curp = lbp->xb_bufp;
+    xo_buf_append(lbp, pbp->xb_bufp, len);
+
+    if (XOF_ISSET(xop, XOF_PRETTY))
+	xo_buf_indent(xop, xop->xo_indent_by);
+    xo_data_append(xop, div_xp, sizeof(div_xp) - 1);
+    xo_data_append(xop, pbp->xb_bufp, len);
+    xo_data_append(xop, div_end, sizeof(div_end) - 1);
+    if (XOF_ISSET(xop, XOF_PRETTY))
+	xo_data_append(xop, "\n", 1);
+}
+
+/*
+ * Html mode: append a <div> to the output buffer contain a field
+ * along with all the supporting information indicated by the flags.
+ */
+static void
+xo_buf_append_div (xo_handle_t *xop, const char *class, xo_xff_flags_t flags,
+		   const char *name, ssize_t nlen,
+		   const char *value, ssize_t vlen,
+		   const char *fmt, ssize_t flen,
+		   const char *encoding, ssize_t elen)
+{
+    static char div_start[] = "<div class=\"";
+    static char div_tag[] = "\" data-tag=\"";
+    static char div_tnum[] = "\" data-t=\"";
+    static char div_tdef[] = "<div class=\"tg\" data-t=\"";
+    static char div_xpath[] = "\" data-xpath=\"";
+    static char div_key[] = "\" data-key=\"key";
+    static char div_end[] = "\">";
+    static char div_close[] = "</div>";
+
+    /* The encoding format defaults to the normal format */
+    if (encoding == NULL && fmt != NULL) {
+	char *enc  = alloca(flen + 1);
+	memcpy(enc, fmt, flen);
+	enc[flen] = '\0';
+	encoding = xo_fix_encoding(xop, enc);
+	elen = strlen(encoding);
+    }
+
+    /*
+     * Display-only keys implies that we've got an encode-only key
+     * elsewhere, so we don't use them from making predicates.
+     */
+    int need_predidate = 
+	(name && (flags & XFF_KEY) && !(flags & XFF_DISPLAY_ONLY)
+	 && XOF_ISSET(xop, XOF_XPATH)) ? 1 : 0;
+
+    /*
+     * When the key's value is displayed using its encoding format,
+     * the predicate and the body of the div hold the same value, so
+     * we format it once (into xo_predicate) and use it for both.
+     */
+    ssize_t key_len = -1;
+
+    if (need_predidate) {
+	/*
+	 * Build an XPath predicate expression to match this key,
+	 * directly in the frame's key buffer.
+	 */
+	xo_stack_t *xsp = &xop->xo_stack[xop->xo_depth];
+	xo_buffer_t *kbp = &xsp->xs_keys;
 
-		xo_data_append(xop, "/", 1);
-		xo_data_escape(xop, xsp->xs_name, strlen(xsp->xs_name));
-		if (xsp->xs_keys) {
-		    /* Don't show keys for the key field */
-		    if (i != xop->xo_depth || !(flags & XFF_KEY))
-			xo_data_append(xop, xsp->xs_keys, strlen(xsp->xs_keys));
+	xo_buf_append(kbp, "[", 1);
+	xo_buf_escape(xop, kbp, name, nlen, 0);
+	if (XOF_ISSET(xop, XOF_PRETTY))
+	    xo_buf_append(kbp, " = '", 4);
+	else
+	    xo_buf_append(kbp, "='", 2);
+
+	if (vlen == 0 && fmt != NULL && flen == elen
+		&& memcmp(fmt, encoding, flen) == 0
+		&& !(flags & (XFF_ENCODE_ONLY | XFF_HUMANIZE | XFF_TRIM_WS
+			      | XFF_GT_FLAGS))) {
+	    xo_buffer_t *pbp = &xop->xo_predicate;
+	    pbp->xb_curp = pbp->xb_bufp; /* Restart buffer */
+
+	    xo_do_format_field(xop, pbp, fmt, flen, flags);
+	    key_len = pbp->xb_curp - pbp->xb_bufp;
+
+	    /* The body is escaped for HTML; attributes also need '"' */
+	    const char *cp, *sp, *ep = pbp->xb_bufp + key_len;
+	    for (cp = sp = pbp->xb_bufp; cp < ep; cp++) {
+		if (*cp == '"') {
+		    xo_buf_append(kbp, sp, cp - sp);
+		    xo_buf_append(kbp, xo_xml_quot, sizeof(xo_xml_quot) - 1);
+		    sp = cp + 1;
 		}
 	    }
+	    xo_buf_append(kbp, sp, ep - sp);
 
-	    xo_data_append(xop, "/", 1);
+	} else {
+	    /*
+	     * The value must be formatted twice, so we save the
+	     * va_list before we format the predicate, and restore
+	     * it afterwards.
+	     */
+	    va_list va_local;
+	    unsigned values_cur = xop->xo_values_cur;
+
+	    if (!XOIF_ISSET(xop, XOIF_VALUES))
+		va_copy(va_local, xop->xo_vap);
+	    if (xop->xo_checkpointer)
+		xop->xo_checkpointer(xop, xop->xo_vap, 0);
+
+	    xo_xff_flags_t pflags = flags | XFF_XML | XFF_ATTR;
+	    pflags &= ~(XFF_NO_OUTPUT | XFF_ENCODE_ONLY);
+	    xo_do_format_field(xop, kbp, encoding, elen, pflags);
+
+	    /* Now we reset the xo_vap as if we were never here */
+	    if (XOIF_ISSET(xop, XOIF_VALUES))
+		xop->xo_values_cur = values_cur;
+	    else {
+		va_end(xop->xo_vap);
+		va_copy(xop->xo_vap, va_local);
+		va_end(va_local);
+	    }
+	    if (xop->xo_checkpointer)
+		xop->xo_checkpointer(xop, xop->xo_vap, 1);
+	}
+
+	xo_buf_append(kbp, "']", 2);
+	xo_xpath_invalidate(xop, xop->xo_depth);
+    }
+
+    if (flags & XFF_ENCODE_ONLY) {
+	/*
+	 * Even if this is encode-only, we need to make sure the args
+	 * are cleared from xo_vap.
+	 */
+	xo_simple_field(xop, TRUE, NULL, 0, encoding, elen, flags);
+	return;
+    }
+
+    xo_line_ensure_open(xop, 0);
+
+    /* Compact mode: give the XPath prefix, if it's changed */
+    int xpath_marker = (name && XOF_ISSET(xop, XOF_XPATH)
+			&& XOF_ISSET(xop, XOF_HTML_COMPACT)
+			&& !(flags & XFF_KEY));
+    if (xpath_marker)
+	xo_html_xpath_marker(xop);
+
+    /* Tag table: define the tag's number on first use */
+    int tnum = -1;
+    if (name && XOF_ISSET(xop, XOF_HTML_TAGS)) {
+	int is_new;
+
+	tnum = xo_tagdict_lookup(xop, name, nlen, &is_new);
+	if (is_new) {
+	    if (XOF_ISSET(xop, XOF_PRETTY))
+		xo_buf_indent(xop, xop->xo_indent_by);
+	    xo_data_append(xop, div_tdef, sizeof(div_tdef) - 1);
+	    xo_printf(xop, "%d", tnum);
+	    xo_data_append(xop, div_tag, sizeof(div_tag) - 1);
 	    xo_data_escape(xop, name, nlen);
+	    xo_html_info(xop, name, nlen);
+	    xo_data_append(xop, "\"></div>", 8);
+	    if (XOF_ISSET(xop, XOF_PRETTY))
+		xo_data_append(xop, "\n", 1);
 	}
+    }
 
-	if (XOF_ISSET(xop, XOF_INFO) && xop->xo_info) {
-	    static char in_type[] = "\" data-type=\"";
-	    static char in_help[] = "\" data-help=\"";
+    if (XOF_ISSET(xop, XOF_PRETTY))
+	xo_buf_indent(xop, xop->xo_indent_by);
 
-	    xo_info_t *xip = xo_info_find(xop, name, nlen);
-	    if (xip) {
-		if (xip->xi_type) {
-		    xo_data_append(xop, in_type, sizeof(in_type) - 1);
-		    xo_data_escape(xop, xip->xi_type, strlen(xip->xi_type));
-		}
-		if (xip->xi_help) {
-		    xo_data_append(xop, in_help, sizeof(in_help) - 1);
-		    xo_data_escape(xop, xip->xi_help, strlen(xip->xi_help));
-		}
-	    }
+    class = xo_html_class(xop, class);
+    xo_data_append(xop, div_start, sizeof(div_start) - 1);
+    xo_data_append(xop, class, strlen(class));
+
+    /*
+     * If the color buffer has content, we add it now.  It's already
+     * prebuilt and ready, since we want to add it to every <div>.
+     */
+    if (!xo_buf_is_empty(&xop->xo_color_buf)) {
+	xo_buffer_t *xbp = &xop->xo_color_buf;
+
+	xo_data_append(xop, xbp->xb_bufp, xbp->xb_curp - xbp->xb_bufp);
+    }
+
+    if (name) {
+	if (tnum >= 0) {
+	    xo_data_append(xop, div_tnum, sizeof(div_tnum) - 1);
+	    xo_printf(xop, "%d", tnum);
+	} else {
+	    xo_data_append(xop, div_tag, sizeof(div_tag) - 1);
+	    xo_data_escape(xop, name, nlen);
+	}
+
+	/*
+	 * Save the offset at which we'd place units.  See xo_format_units.
+	 */
+	if (XOF_ISSET(xop, XOF_UNITS)) {
+	    XOIF_SET(xop, XOIF_UNITS_PENDING);
+	    /*
+	     * Note: We need the '+1' here because we know we've not
+	     * added the closing quote.  We add one, knowing the quote
+	     * will be added shortly.
+	     */
+	    xop->xo_units_offset =
+		xop->xo_data.xb_curp -xop->xo_data.xb_bufp + 1;
+	}
+
+	if (XOF_ISSET(xop, XOF_XPATH) && !xpath_marker) {
+	    xo_data_append(xop, div_xpath, sizeof(div_xpath) - 1);
+	    xo_html_xpath_prefix(xop, &xop->xo_data, flags);
+	    xo_data_append(xop, "/", 1);
+	    xo_data_escape(xop, name, nlen);
 	}
 
+	/* With a tag table, the info is given with the tag's name */
+	if (tnum < 0)
+	    xo_html_info(xop, name, nlen);
+
 	if ((flags & XFF_KEY) && XOF_ISSET(xop, XOF_KEYS))
 	    xo_data_append(xop, div_key, sizeof(div_key) - 1);
     }
@@ -4019,7 +6021,10 @@ xo_buf_append_div (xo_handle_t *xop, const char *class, xo_xff_flags_t flags,
     save.xhs_columns = xop->xo_columns;
     save.xhs_anchor_columns = xop->xo_anchor_columns;
 
-    xo_simple_field(xop, FALSE, value, vlen, fmt, flen, flags);
+    if (key_len >= 0)
+	xo_data_append(xop, xop->xo_predicate.xb_bufp, key_len);
+    else
+	xo_simple_field(xop, FALSE, value, vlen, fmt, flen, flags);
 
     if (flags & XFF_HUMANIZE) {
 	/*
@@ -4084,6 +6089,7 @@ xo_format_title (xo_handle_t *xop, xo_field_info_t *xfip,
     xo_xff_flags_t flags = xfip->xfi_flags;
 
     static char div_open[] = "<div class=\"title";
+    static char div_open_compact[] = "<div class=\"h";
     static char div_middle[] = "\">";
     static char div_close[] = "</div>";
 
@@ -4114,7 +6120,11 @@ xo_format_title (xo_handle_t *xop, xo_field_info_t *xfip,
 	xo_line_ensure_open(xop, 0);
 	if (XOF_ISSET(xop, XOF_PRETTY))
 	    xo_buf_indent(xop, xop->xo_indent_by);
-	xo_buf_append(&xop->xo_data, div_open, sizeof(div_open) - 1);
+	if (XOF_ISSET(xop, XOF_HTML_COMPACT))
+	    xo_buf_append(&xop->xo_data, div_open_compact,
+			  sizeof(div_open_compact) - 1);
+	else
+	    xo_buf_append(&xop->xo_data, div_open, sizeof(div_open) - 1);
 	xo_color_append_html(xop);
 	xo_buf_append(&xop->xo_data, div_middle, sizeof(div_middle) - 1);
     }
@@ -4363,8 +6373,14 @@ xo_format_value (xo_handle_t *xop, const char *name, ssize_t nlen,
 
     switch (xo_style(xop)) {
     case XO_STYLE_TEXT:
-	if (flags & XFF_ENCODE_ONLY)
-	    flags |= XFF_NO_OUTPUT;
+	if (flags & XFF_ENCODE_ONLY) {
+	    xo_simple_field(xop, TRUE, value, vlen, fmt, flen, flags);
+	    break;
+	}
+
+	if ((flags & XFF_HUMANIZE) && vlen == 0
+		&& xo_format_humanize_direct(xop, xbp, fmt, flen, flags) == 0)
+	    break;
 
 	save.xhs_offset = xbp->xb_curp - xbp->xb_bufp;
 	save.xhs_columns = xop->xo_columns;
@@ -4778,14 +6794,38 @@ xo_effect_find (const char *str)
     return -1;
 }
 
+/*
+ * A color specification is a series of changes to the current colors
+ * and effects, so we parse it into an xo_color_op_t that can be
+ * applied to any xo_colors_t.  The effects become "(effects & keep) |
+ * set", which is enough to express "bold", "no-bold", "normal", and
+ * "reset" in any combination.
+ */
+typedef struct xo_color_op_s {
+    xo_effect_t xco_keep;	/* Effects to keep from the current set */
+    xo_effect_t xco_set;	/* Effects to turn on */
+    uint8_t xco_flags;		/* XO_COP_* flags */
+    xo_color_t xco_col_fg;	/* New foreground color (if XO_COP_FG) */
+    xo_color_t xco_col_bg;	/* New background color (if XO_COP_BG) */
+} xo_color_op_t;
+
+#define XO_COP_FG	(1<<0)	/* Foreground color is set */
+#define XO_COP_BG	(1<<1)	/* Background color is set */
+
 static void
-xo_colors_parse (xo_handle_t *xop, xo_colors_t *xocp, char *str)
+xo_colors_parse (xo_handle_t *xop, xo_color_op_t *xcop, char *str)
 {
+    xcop->xco_keep = (xo_effect_t) ~0;
+    xcop->xco_set = 0;
+    xcop->xco_flags = 0;
+    xcop->xco_col_fg = xcop->xco_col_bg = XO_COL_DEFAULT;
+
     if (xo_text_only())
 	return;
 
     char *cp, *ep, *np, *xp;
     ssize_t len = strlen(str);
+    xo_effect_t bit;
     int rc;
 
     /*
@@ -4810,37 +6850,48 @@ xo_colors_parse (xo_handle_t *xop, xo_colors_t *xocp, char *str)
 	    if (rc < 0)
 		goto unknown;
 
-	    xocp->xoc_col_fg = rc;
+	    xcop->xco_col_fg = rc;
+	    xcop->xco_flags |= XO_COP_FG;
 
 	} else if (cp[0] == 'b' && cp[1] == 'g' && cp[2] == '-') {
 	    rc = xo_color_find(cp + 3);
 	    if (rc < 0)
 		goto unknown;
-	    xocp->xoc_col_bg = rc;
+	    xcop->xco_col_bg = rc;
+	    xcop->xco_flags |= XO_COP_BG;
 
 	} else if (cp[0] == 'n' && cp[1] == 'o' && cp[2] == '-') {
 	    rc = xo_effect_find(cp + 3);
 	    if (rc < 0)
 		goto unknown;
-	    xocp->xoc_effects &= ~(1 << rc);
+	    bit = 1 << rc;
+	    xcop->xco_keep &= ~bit;
+	    xcop->xco_set &= ~bit;
 
 	} else {
 	    rc = xo_effect_find(cp);
 	    if (rc < 0)
 		goto unknown;
-	    xocp->xoc_effects |= 1 << rc;
+	    bit = 1 << rc;
 
-	    switch (1 << rc) {
+	    switch (bit) {
 	    case XO_EFF_RESET:
-		xocp->xoc_col_fg = xocp->xoc_col_bg = 0;
-		/* Note: not "|=" since we want to wipe out the old value */
-		xocp->xoc_effects = XO_EFF_RESET;
+		/* Wipe out the old value, including the colors */
+		xcop->xco_keep = 0;
+		xcop->xco_set = XO_EFF_RESET;
+		xcop->xco_col_fg = xcop->xco_col_bg = XO_COL_DEFAULT;
+		xcop->xco_flags |= XO_COP_FG | XO_COP_BG;
 		break;
 
 	    case XO_EFF_NORMAL:
-		xocp->xoc_effects &= ~(XO_EFF_BOLD | XO_EFF_UNDERLINE
-				      | XO_EFF_INVERSE | XO_EFF_NORMAL);
+		bit = XO_EFF_BOLD | XO_EFF_UNDERLINE
+		    | XO_EFF_INVERSE | XO_EFF_NORMAL;
+		xcop->xco_keep &= ~bit;
+		xcop->xco_set &= ~bit;
 		break;
+
+	    default:
+		xcop->xco_set |= bit;
 	    }
 	}
 	continue;
@@ -4851,6 +6902,99 @@ xo_colors_parse (xo_handle_t *xop, xo_colors_t *xocp, char *str)
     }
 }
 
+/*
+ * Apply a parsed color specification to a set of colors
+ */
+static void
+xo_colors_apply (xo_colors_t *xocp, const xo_color_op_t *xcop)
+{
+    xocp->xoc_effects = (xocp->xoc_effects & xcop->xco_keep) | xcop->xco_set;
+    if (xcop->xco_flags & XO_COP_FG)
+	xocp->xoc_col_fg = xcop->xco_col_fg;
+    if (xcop->xco_flags & XO_COP_BG)
+	xocp->xoc_col_bg = xcop->xco_col_bg;
+}
+
+/*
+ * Color caches: {C:} fields with static content in a retained or
+ * compiled format are parsed once, with the result kept in a small
+ * direct-mapped table keyed by the address of the content.  The ANSI
+ * escape sequences for text output depend only on the old and new
+ * colors, so we keep them in a second table keyed by both, making
+ * each color change a single append.  Like the retained fields, both
+ * tables are thread-specific.
+ */
+#ifndef XO_COLORS_CACHE_SIZE
+#define XO_COLORS_CACHE_SIZE 6
+#endif /* XO_COLORS_CACHE_SIZE */
+#define COLORS_CACHE_HASH_SIZE (1<<XO_COLORS_CACHE_SIZE)
+
+#define XO_COLORS_ESC_MAX 24	/* Longest escape is "\e[0;0;1;4;7;39;49m" */
+
+typedef struct xo_color_spec_entry_s {
+    const char *xcs_content;	/* Address of the {C:} field's content */
+    ssize_t xcs_clen;		/* Length of that content */
+    xo_color_op_t xcs_op;	/* Parsed specification */
+} xo_color_spec_entry_t;
+
+typedef struct xo_color_esc_entry_s {
+    uint64_t xce_key;		/* Old and new colors (0 means empty) */
+    uint8_t xce_len;		/* Length of xce_esc */
+    char xce_esc[XO_COLORS_ESC_MAX]; /* Escape sequence */
+} xo_color_esc_entry_t;
+
+static THREAD_LOCAL(xo_color_spec_entry_t)
+    xo_colors_spec_cache[COLORS_CACHE_HASH_SIZE];
+static THREAD_LOCAL(xo_color_esc_entry_t)
+    xo_colors_esc_cache[COLORS_CACHE_HASH_SIZE];
+
+static void
+xo_colors_cache_clear (void)
+{
+    bzero(xo_colors_spec_cache, sizeof(xo_colors_spec_cache));
+}
+
+static unsigned
+xo_colors_cache_hash (uint64_t val)
+{
+    val ^= val >> 29;
+    val *= 0x9e3779b97f4a7c15ULL;
+    return (unsigned) (val >> (64 - XO_COLORS_CACHE_SIZE));
+}
+
+/*
+ * Parse the color specification in "value", using the cache when
+ * the content can't change underneath us.
+ */
+static void
+xo_colors_parse_field (xo_handle_t *xop, xo_field_info_t *xfip,
+		       xo_color_op_t *xcop, const char *value, ssize_t vlen)
+{
+    xo_color_spec_entry_t *xcsp = NULL;
+
+    if (XOIF_ISSET(xop, XOIF_FMT_STABLE) && value == xfip->xfi_content
+	&& !(xfip->xfi_flags & XFF_ARGUMENT)) {
+	xcsp = &xo_colors_spec_cache[
+		xo_colors_cache_hash((uintptr_t) (const void *) value)];
+	if (xcsp->xcs_content == value && xcsp->xcs_clen == vlen) {
+	    *xcop = xcsp->xcs_op;
+	    return;
+	}
+    }
+
+    char *buf = alloca(vlen + 1);
+    memcpy(buf, value, vlen);
+    buf[vlen] = '\0';
+
+    xo_colors_parse(xop, xcop, buf);
+
+    if (xcsp) {
+	xcsp->xcs_content = value;
+	xcsp->xcs_clen = vlen;
+	xcsp->xcs_op = *xcop;
+    }
+}
+
 static inline int
 xo_colors_enabled (xo_handle_t *xop UNUSED)
 {
@@ -4881,13 +7025,18 @@ xo_colors_update (xo_handle_t *xop UNUSED, xo_colors_t *newp UNUSED)
 #endif /* LIBXO_TEXT_ONLY */
 }
 
-static void
-xo_colors_handle_text (xo_handle_t *xop, xo_colors_t *newp)
+/*
+ * Build the ANSI escape sequence that moves from the "old" colors
+ * to the "new" ones, returning its length (zero if there's nothing
+ * to emit).
+ */
+static ssize_t
+xo_colors_build_text (xo_colors_t old, xo_colors_t new,
+		      char *buf, ssize_t bufsiz)
 {
-    char buf[BUFSIZ];
-    char *cp = buf, *ep = buf + sizeof(buf);
+    char *cp = buf, *ep = buf + bufsiz;
     unsigned i, bit;
-    xo_colors_t *oldp = &xop->xo_colors;
+    xo_colors_t *oldp = &old, *newp = &new;
     const char *code = NULL;
 
     /*
@@ -4918,7 +7067,7 @@ xo_colors_handle_text (xo_handle_t *xop, xo_colors_t *newp)
 
 	cp += snprintf(cp, ep - cp, ";%s", code);
 	if (cp >= ep)
-	    return;		/* Should not occur */
+	    return 0;		/* Should not occur */
 
 	if (bit == XO_EFF_RESET) {
 	    /* Mark up the old value so we can detect current values as new */
@@ -4943,8 +7092,45 @@ xo_colors_handle_text (xo_handle_t *xop, xo_colors_t *newp)
 	buf[1] = '[';		/* Overwrite leading ';' */
 	*cp++ = 'm';
 	*cp = '\0';
-	xo_buf_append(&xop->xo_data, buf, cp - buf);
+	return cp - buf;
+    }
+
+    return 0;
+}
+
+static void
+xo_colors_handle_text (xo_handle_t *xop, xo_colors_t *newp)
+{
+    xo_colors_t *oldp = &xop->xo_colors;
+    uint64_t key;
+    xo_color_esc_entry_t *xcep;
+
+    /* The high bit keeps the key from being zero (empty) */
+    key = (1ULL << 63)
+	| ((uint64_t) oldp->xoc_effects << 40)
+	| ((uint64_t) oldp->xoc_col_fg << 32)
+	| ((uint64_t) oldp->xoc_col_bg << 24)
+	| ((uint64_t) newp->xoc_effects << 16)
+	| ((uint64_t) newp->xoc_col_fg << 8)
+	| (uint64_t) newp->xoc_col_bg;
+
+    xcep = &xo_colors_esc_cache[xo_colors_cache_hash(key)];
+    if (xcep->xce_key != key) {
+	char buf[BUFSIZ];
+	ssize_t len = xo_colors_build_text(*oldp, *newp, buf, sizeof(buf));
+
+	if (len >= XO_COLORS_ESC_MAX) {	/* Should not occur */
+	    xo_buf_append(&xop->xo_data, buf, len);
+	    return;
+	}
+
+	xcep->xce_key = key;
+	xcep->xce_len = len;
+	memcpy(xcep->xce_esc, buf, len);
     }
+
+    if (xcep->xce_len)
+	xo_buf_append(&xop->xo_data, xcep->xce_esc, xcep->xce_len);
 }
 
 static void
@@ -5021,21 +7207,27 @@ xo_format_colors (xo_handle_t *xop, xo_field_info_t *xfip,
 
     xo_buf_init(&xb);
 
-    if (vlen)
-	xo_buf_append(&xb, value, vlen);
-    else if (flen)
-	xo_do_format_field(xop, &xb, fmt, flen, 0);
-    else
-	xo_buf_append(&xb, "reset", 6); /* Default if empty */
+    if (vlen == 0) {
+	if (flen)
+	    xo_do_format_field(xop, &xb, fmt, flen, 0);
+	else
+	    xo_buf_append(&xb, "reset", 6); /* Default if empty */
+    }
 
     if (xo_colors_enabled(xop)) {
 	switch (xo_style(xop)) {
 	case XO_STYLE_TEXT:
 	case XO_STYLE_HTML:
-	    xo_buf_append(&xb, "", 1);
+	    if (!vlen) {
+		value = xb.xb_bufp;
+		vlen = xo_buf_offset(&xb);
+	    }
+
+	    xo_color_op_t xco;
+	    xo_colors_parse_field(xop, xfip, &xco, value, vlen);
 
 	    xo_colors_t xoc = xop->xo_colors;
-	    xo_colors_parse(xop, &xoc, xb.xb_bufp);
+	    xo_colors_apply(&xoc, &xco);
 	    xo_colors_update(xop, &xoc);
 
 	    if (xo_style(xop) == XO_STYLE_TEXT) {
@@ -5165,10 +7357,12 @@ xo_find_width (xo_handle_t *xop, xo_field_info_t *xfip,
 	if (xop->xo_formatter == NULL && flen == 2
 	        && strncmp("%d", fmt, flen) == 0) {
 	    if (!XOF_ISSET(xop, XOF_NO_VA_ARG))
-		width = va_arg(xop->xo_vap, int);
+		width = xo_next_int(xop);
 	} else if (xop->xo_formatter == NULL && flen == 2
 		   && strncmp("%u", fmt, flen) == 0) {
-	    if (!XOF_ISSET(xop, XOF_NO_VA_ARG))
+	    if (XOIF_ISSET(xop, XOIF_VALUES))
+		width = xo_next_int(xop);
+	    else if (!XOF_ISSET(xop, XOF_NO_VA_ARG))
 		width = va_arg(xop->xo_vap, unsigned);
 	} else {
 	    /*
@@ -5367,10 +7561,6 @@ static xo_mapping_t xo_role_names[] = {
     { 0, NULL }
 };
 
-#define XO_ROLE_EBRACE	'{'	/* Escaped braces */
-#define XO_ROLE_TEXT	'+'
-#define XO_ROLE_NEWLINE	'\n'
-
 static xo_mapping_t xo_modifier_names[] = {
     { XFF_ARGUMENT, "argument" },
     { XFF_COLON, "colon" },
@@ -5414,7 +7604,7 @@ static xo_mapping_t xo_modifier_short_names[] = {
 };
 #endif /* NOT_NEEDED_YET */
 
-static int
+int
 xo_count_fields (xo_handle_t *xop UNUSED, const char *fmt)
 {
     int rc = 1;
@@ -5722,7 +7912,7 @@ xo_parse_field_numbers (xo_handle_t *xop, const char *fmt,
     return 0;
 }
 
-static int
+int
 xo_parse_fields (xo_handle_t *xop, xo_field_info_t *fields,
 		 unsigned num_fields, const char *fmt)
 {
@@ -5976,67 +8166,28 @@ xo_dump_fields (xo_field_info_t *fields)
     }
 }
 
-#ifdef HAVE_GETTEXT
-/*
- * Find the field that matches the given field number
- */
-static xo_field_info_t *
-xo_gettext_find_field (xo_field_info_t *fields, unsigned fnum)
-{
-    xo_field_info_t *xfip;
-
-    for (xfip = fields; xfip->xfi_ftype; xfip++)
-	if (xfip->xfi_fnum == fnum)
-	    return xfip;
-
-    return NULL;
-}
-
 /*
- * At this point, we need to consider if the fields have been reordered,
- * such as "The {:adjective} {:noun}" to "La {:noun} {:adjective}".
- *
- * We need to rewrite the new_fields using the old fields order,
- * so that we can render the message using the arguments as they
- * appear on the stack.  It's a lot of work, but we don't really
- * want to (eventually) fall into the standard printf code which
- * means using the arguments straight (and in order) from the
- * varargs we were originally passed.
+ * Translating a format string means simplifying it, calling
+ * dgettext(), parsing the reply, and matching its fields against the
+ * original ones, so we cache the results, keyed by the content of
+ * the format string and the gettext domain.  An entry with no
+ * xge_fields records that the format has no translation.  Entries
+ * are single allocations, holding copies of every string they point
+ * to, since format strings need not be immutable.
  */
-static void
-xo_gettext_rewrite_fields (xo_handle_t *xop UNUSED,
-			   xo_field_info_t *fields, unsigned max_fields)
-{
-    xo_field_info_t tmp[max_fields];
-    bzero(tmp, max_fields * sizeof(tmp[0]));
-
-    unsigned fnum = 0;
-    xo_field_info_t *newp, *outp, *zp;
-    for (newp = fields, outp = tmp; newp->xfi_ftype; newp++, outp++) {
-	switch (newp->xfi_ftype) {
-	case XO_ROLE_NEWLINE:	/* Don't get numbered */
-	case XO_ROLE_TEXT:
-	case XO_ROLE_EBRACE:
-	case 'G':
-	    *outp = *newp;
-	    outp->xfi_renum = 0;
-	    continue;
-	}
-
-	zp = xo_gettext_find_field(fields, ++fnum);
-	if (zp == NULL) { 	/* Should not occur */
-	    *outp = *newp;
-	    outp->xfi_renum = 0;
-	    continue;
-	}
-
-	*outp = *zp;
-	outp->xfi_renum = newp->xfi_fnum;
-    }
-
-    memcpy(fields, tmp, max_fields * sizeof(tmp[0]));
-}
+typedef struct xo_gt_entry_s {
+    struct xo_gt_entry_s *xge_next; /* Next entry in the bucket */
+    uint32_t xge_hash;		/* Hash of format and domain */
+    int xge_cached;		/* Entry is held in the cache */
+    int xge_reordered;		/* Translation reorders the fields */
+    unsigned xge_max_fields;	/* Number of translated fields */
+    xo_field_info_t *xge_fields; /* Translated fields (after a blank slot) */
+    const char *xge_format;	/* Our copy of the original format */
+    const char *xge_domain;	/* Our copy of the domain name */
+    const char *xge_new_format;	/* Our copy of the translated format */
+} xo_gt_entry_t;
 
+#ifdef HAVE_GETTEXT
 /*
  * We've got two lists of fields, the old list from the original
  * format string and the new one from the parsed gettext reply.  The
@@ -6044,14 +8195,17 @@ xo_gettext_rewrite_fields (xo_handle_t *xop UNUSED,
  * formatting information.  We need to combine them into a single list
  * (the new list).
  *
- * If the list needs to be reordered, then we've got more serious work
- * to do.
+ * If the translation reorders the fields, such as "The {:adjective}
+ * {:noun}" to "La {:noun} {:adjective}", we still render the new list
+ * in its own order, but each field needs the arguments of its match
+ * in the old list.  So we record the index of that match (plus one)
+ * in xfi_renum; see xo_do_emit_fields.
  */
 static int
 xo_gettext_combine_formats (xo_handle_t *xop, const char *fmt UNUSED,
 		    const char *gtfmt, xo_field_info_t *old_fields,
-		    xo_field_info_t *new_fields, unsigned new_max_fields,
-		    int *reorderedp)
+		    xo_field_info_t *new_fields,
+		    unsigned new_max_fields UNUSED, int *reorderedp)
 {
     int reordered = 0;
     xo_field_info_t *newp, *oldp, *startp = old_fields;
@@ -6122,6 +8276,7 @@ xo_gettext_combine_formats (xo_handle_t *xop, const char *fmt UNUSED,
 	 * Found a match; copy over appropriate fields
 	 */
     copy_it:
+	newp->xfi_renum = (oldp - old_fields) + 1;
 	newp->xfi_flags = oldp->xfi_flags;
 	newp->xfi_fnum = oldp->xfi_fnum;
 	newp->xfi_format = oldp->xfi_format;
@@ -6131,9 +8286,10 @@ xo_gettext_combine_formats (xo_handle_t *xop, const char *fmt UNUSED,
     }
 
     *reorderedp = reordered;
-    if (reordered) {
-	xo_gettext_finish_numbering_fields(xop, fmt, new_fields);
-	xo_gettext_rewrite_fields(xop, new_fields, new_max_fields);
+    if (!reordered) {
+	/* Fields are in the old order, so the arguments are too */
+	for (newp = new_fields; newp->xfi_ftype; newp++)
+	    newp->xfi_renum = 0;
     }
 
     return 0;
@@ -6156,7 +8312,7 @@ xo_gettext_combine_formats (xo_handle_t *xop, const char *fmt UNUSED,
  * format string:
  *   "cluse-a {:fd} retoorned {:test}.  Bork {:error} Bork. Bork.\n"
  * If we have to reorder fields within the message, then things get
- * complicated.  See xo_gettext_rewrite_fields.
+ * complicated.  See xo_gettext_combine_formats and xo_do_emit_fields.
  *
  * Summary: i18n aighn't cheap.
  */
@@ -6195,88 +8351,293 @@ xo_gettext_build_format (xo_handle_t *xop,
     return fmt;
 }
 
+#ifndef XO_GT_CACHE_SIZE
+#define XO_GT_CACHE_SIZE 6
+#endif /* XO_GT_CACHE_SIZE */
+#define GT_CACHE_HASH_SIZE (1<<XO_GT_CACHE_SIZE)
+
+#ifndef XO_GT_CACHE_MAX
+#define XO_GT_CACHE_MAX 256	/* Flush the cache when it's this full */
+#endif /* XO_GT_CACHE_MAX */
+
+/*
+ * Like the retained fields, the cache is thread-specific.  We record
+ * the LC_MESSAGES locale it was filled under and flush it when that
+ * changes.
+ */
+static THREAD_LOCAL(xo_gt_entry_t *) xo_gt_cache[GT_CACHE_HASH_SIZE];
+static THREAD_LOCAL(unsigned) xo_gt_cache_count;
+static THREAD_LOCAL(char *) xo_gt_cache_locale;
+
+static void
+xo_gettext_cache_clear (void)
+{
+    int i;
+    xo_gt_entry_t *xgep, *next;
+
+    for (i = 0; i < GT_CACHE_HASH_SIZE; i++) {
+	for (xgep = xo_gt_cache[i]; xgep; xgep = next) {
+	    next = xgep->xge_next;
+	    xo_free(xgep);
+	}
+	xo_gt_cache[i] = NULL;
+    }
+    xo_gt_cache_count = 0;
+    xo_gt_generation += 1;
+}
+
+/*
+ * Flush the cache if the locale has changed since it was filled
+ */
 static void
-xo_gettext_rebuild_content (xo_handle_t *xop, xo_field_info_t *fields,
-			    ssize_t *fstart, unsigned min_fstart,
-			    ssize_t *fend, unsigned max_fend)
+xo_gettext_cache_check_locale (void)
 {
-    xo_field_info_t *xfip;
-    char *buf;
-    ssize_t base = fstart[min_fstart];
-    ssize_t blen = fend[max_fend] - base;
-    xo_buffer_t *xbp = &xop->xo_data;
+    if (xo_gettext_locale_changed(&xo_gt_cache_locale))
+	xo_gettext_cache_clear();
+}
 
-    if (blen == 0)
-	return;
+/*
+ * Return the size needed to copy a string that isn't in our
+ * translated format, or zero if it's there (or NULL).
+ */
+static ssize_t
+xo_gettext_foreign_size (const char *cp, ssize_t len,
+			 const char *base, ssize_t blen)
+{
+    if (cp == NULL || (cp >= base && cp <= base + blen))
+	return 0;
+    return len + 1;
+}
 
-    buf = xo_realloc(NULL, blen);
-    if (buf == NULL)
-	return;
+/*
+ * Move a string pointer into our copy of the translated format,
+ * or copy it into the pool at *poolp.
+ */
+static const char *
+xo_gettext_rebase (const char *cp, ssize_t len, const char *base,
+		   ssize_t blen, const char *newbase, char **poolp)
+{
+    if (cp == NULL)
+	return NULL;
+
+    if (cp >= base && cp <= base + blen)
+	return newbase + (cp - base);
+
+    char *res = *poolp;
+    memcpy(res, cp, len);
+    res[len] = '\0';
+    *poolp += len + 1;
 
-    memcpy(buf, xbp->xb_bufp + fstart[min_fstart], blen); /* Copy our data */
+    return res;
+}
+
+/*
+ * Build an entry for the given format and domain, translating the
+ * portion of the format string following the {G:} field at
+ * 'this_field'.  NULL means the translation couldn't be used.
+ */
+static xo_gt_entry_t *
+xo_gettext_entry_build (xo_handle_t *xop, const char *fmt,
+			const char *domain, uint32_t hash,
+			xo_field_info_t *fields, unsigned max_fields,
+			int this_field)
+{
+    char *new_fmt = NULL;
+    xo_field_info_t *new_fields = NULL, *xfip;
+    unsigned new_max_fields = 0;
+    int reordered = 0;
+    ssize_t nlen = 0, sz;
+
+    xo_gettext_build_format(xop, fields, this_field,
+			    fields[this_field].xfi_next, &new_fmt);
+    if (new_fmt) {
+	new_max_fields = xo_count_fields(xop, new_fmt);
+
+	if (++new_max_fields < max_fields)
+	    new_max_fields = max_fields;
+
+	/* Leave a blank slot at the beginning */
+	sz = (new_max_fields + 1) * sizeof(xo_field_info_t);
+	new_fields = alloca(sz);
+	bzero(new_fields, sz);
+
+	if (xo_parse_fields(xop, new_fields + 1, new_max_fields, new_fmt)
+	    || xo_gettext_combine_formats(xop, fmt, new_fmt,
+					  fields, new_fields + 1,
+					  new_max_fields, &reordered)) {
+	    xo_free(new_fmt);
+	    return NULL;
+	}
+
+	nlen = strlen(new_fmt);
+    }
 
-    unsigned field = min_fstart, len, fnum;
-    ssize_t soff, doff = base;
-    xo_field_info_t *zp;
+    ssize_t flen = strlen(fmt), dlen = strlen(domain);
+    ssize_t fsz = new_fields ? (new_max_fields + 1) * sizeof(*new_fields) : 0;
 
     /*
-     * Be aware there are two competing views of "field number": we
-     * want the user to thing in terms of "The {1:size}" where {G:},
-     * newlines, escaped braces, and text don't have numbers.  But is
-     * also the internal view, where we have an array of
-     * xo_field_info_t and every field have an index.  fnum, fstart[]
-     * and fend[] are the latter, but xfi_renum is the former.
+     * The translated fields point into new_fmt, except for formats
+     * and encodings, which come from the original fields.
      */
-    for (xfip = fields + field; xfip->xfi_ftype; xfip++, field++) {
-	fnum = field;
-	if (xfip->xfi_renum) {
-	    zp = xo_gettext_find_field(fields, xfip->xfi_renum);
-	    fnum = zp ? zp - fields : field;
-	}
+    sz = sizeof(xo_gt_entry_t) + fsz + flen + 1 + dlen + 1;
+    if (new_fields) {
+	sz += nlen + 1;
+	for (xfip = new_fields + 1; xfip->xfi_ftype; xfip++) {
+	    sz += xo_gettext_foreign_size(xfip->xfi_start, xfip->xfi_len,
+					  new_fmt, nlen);
+	    sz += xo_gettext_foreign_size(xfip->xfi_content, xfip->xfi_clen,
+					  new_fmt, nlen);
+	    sz += xo_gettext_foreign_size(xfip->xfi_format, xfip->xfi_flen,
+					  new_fmt, nlen);
+	    sz += xo_gettext_foreign_size(xfip->xfi_encoding, xfip->xfi_elen,
+					  new_fmt, nlen);
+	}
+    }
+
+    xo_gt_entry_t *xgep = xo_realloc(NULL, sz);
+    if (xgep == NULL) {
+	xo_free(new_fmt);
+	return NULL;
+    }
 
-	soff = fstart[fnum];
-	len = fend[fnum] - soff;
+    bzero(xgep, sizeof(*xgep));
+    xgep->xge_hash = hash;
+    xgep->xge_reordered = reordered;
 
-	if (len > 0) {
-	    soff -= base;
-	    memcpy(xbp->xb_bufp + doff, buf + soff, len);
-	    doff += len;
+    char *pool = ((char *) &xgep[1]) + fsz;
+
+    memcpy(pool, fmt, flen + 1);
+    xgep->xge_format = pool;
+    pool += flen + 1;
+
+    memcpy(pool, domain, dlen + 1);
+    xgep->xge_domain = pool;
+    pool += dlen + 1;
+
+    if (new_fields) {
+	char *new_base = pool;
+	memcpy(new_base, new_fmt, nlen + 1);
+	pool += nlen + 1;
+
+	xgep->xge_new_format = new_base;
+	xgep->xge_max_fields = new_max_fields;
+	xgep->xge_fields = (xo_field_info_t *) &xgep[1];
+	memcpy(xgep->xge_fields, new_fields, fsz);
+
+	for (xfip = xgep->xge_fields + 1; xfip->xfi_ftype; xfip++) {
+	    xfip->xfi_start = xo_gettext_rebase(xfip->xfi_start,
+				xfip->xfi_len, new_fmt, nlen, new_base, &pool);
+	    xfip->xfi_content = xo_gettext_rebase(xfip->xfi_content,
+				xfip->xfi_clen, new_fmt, nlen, new_base, &pool);
+	    xfip->xfi_format = xo_gettext_rebase(xfip->xfi_format,
+				xfip->xfi_flen, new_fmt, nlen, new_base, &pool);
+	    xfip->xfi_encoding = xo_gettext_rebase(xfip->xfi_encoding,
+				xfip->xfi_elen, new_fmt, nlen, new_base, &pool);
+
+	    /* Only {G:} fields use xfi_next, and we don't revisit those */
+	    if (xfip->xfi_next < new_fmt || xfip->xfi_next > new_fmt + nlen)
+		xfip->xfi_next = NULL;
+	    else
+		xfip->xfi_next = new_base + (xfip->xfi_next - new_fmt);
 	}
+
+	xo_free(new_fmt);
+    }
+
+    return xgep;
+}
+
+/*
+ * Find (or build) the translation for the format 'fmt', whose {G:}
+ * field is at 'this_field'.  The caller must free the result unless
+ * xge_cached is set.
+ */
+static xo_gt_entry_t *
+xo_gettext_translate (xo_handle_t *xop, const char *fmt,
+		      xo_field_info_t *fields, unsigned max_fields,
+		      int this_field)
+{
+    if (xo_style_is_encoding(xop))
+	return NULL;
+
+    const char *domain = xop->xo_gt_domain ?: textdomain(NULL);
+    if (domain == NULL)
+	domain = "";
+
+    /* Logging wants to see every lookup, so it bypasses the cache */
+    int use_cache = !XOF_ISSET(xop, XOF_RETAIN_NONE | XOF_LOG_GETTEXT);
+    uint32_t hash = xo_gettext_hash(xo_gettext_hash(XO_GT_HASH_INIT, fmt),
+				    domain);
+    unsigned bucket = hash & (GT_CACHE_HASH_SIZE - 1);
+    xo_gt_entry_t *xgep;
+
+    if (use_cache) {
+	xo_gettext_cache_check_locale();
+
+	for (xgep = xo_gt_cache[bucket]; xgep; xgep = xgep->xge_next)
+	    if (xgep->xge_hash == hash && xo_streq(xgep->xge_format, fmt)
+		&& xo_streq(xgep->xge_domain, domain))
+		return xgep;
     }
 
-    xo_free(buf);
+    xgep = xo_gettext_entry_build(xop, fmt, domain, hash,
+				  fields, max_fields, this_field);
+    if (xgep == NULL || !use_cache)
+	return xgep;
+
+    if (xo_gt_cache_count >= XO_GT_CACHE_MAX)
+	xo_gettext_cache_clear();
+
+    xgep->xge_cached = 1;
+    xgep->xge_next = xo_gt_cache[bucket];
+    xo_gt_cache[bucket] = xgep;
+    xo_gt_cache_count += 1;
+
+    return xgep;
 }
+
 #else  /* HAVE_GETTEXT */
-static const char *
-xo_gettext_build_format (xo_handle_t *xop UNUSED,
-			 xo_field_info_t *fields UNUSED,
-			 int this_field UNUSED,
-			 const char *fmt UNUSED, char **new_fmtp)
+static void
+xo_gettext_cache_clear (void)
 {
-    *new_fmtp = NULL;
-    return fmt;
+    return;
 }
 
-static int
-xo_gettext_combine_formats (xo_handle_t *xop UNUSED, const char *fmt UNUSED,
-		    const char *gtfmt UNUSED,
-		    xo_field_info_t *old_fields UNUSED,
-		    xo_field_info_t *new_fields UNUSED,
-		    unsigned new_max_fields UNUSED,
-		    int *reorderedp UNUSED)
+static xo_gt_entry_t *
+xo_gettext_translate (xo_handle_t *xop UNUSED, const char *fmt UNUSED,
+		      xo_field_info_t *fields UNUSED,
+		      unsigned max_fields UNUSED, int this_field UNUSED)
 {
-    return -1;
+    return NULL;
 }
+#endif /* HAVE_GETTEXT */
 
+/*
+ * Move xo_vap past the arguments used by a field, without rendering
+ * it.  A field's format uses arguments unless the field has content
+ * (other than a value's name), which makes its format apply to that
+ * content instead.
+ */
 static void
-xo_gettext_rebuild_content (xo_handle_t *xop UNUSED,
-		    xo_field_info_t *fields UNUSED,
-		    ssize_t *fstart UNUSED, unsigned min_fstart UNUSED,
-		    ssize_t *fend UNUSED, unsigned max_fend UNUSED)
+xo_skip_field_args (xo_handle_t *xop, xo_field_info_t *xfip)
 {
-    return;
+    ssize_t clen = xfip->xfi_clen;
+
+    switch (xfip->xfi_ftype) {
+    case XO_ROLE_NEWLINE:
+    case XO_ROLE_TEXT:
+    case XO_ROLE_EBRACE:
+	return;
+    }
+
+    if (xfip->xfi_flags & XFF_ARGUMENT) {
+	const char *content = xo_next_string(xop);
+	clen = content ? strlen(content) : 0;
+    }
+
+    if (xfip->xfi_flen && (xfip->xfi_ftype == 'V' || clen == 0))
+	xo_skip_format_args(xop, xfip->xfi_format, xfip->xfi_flen);
 }
-#endif /* HAVE_GETTEXT */
 
 /*
  * Emit a set of fields.  This is really the core of libxo.
@@ -6286,47 +8647,40 @@ xo_do_emit_fields (xo_handle_t *xop, xo_field_info_t *fields,
 		   unsigned max_fields, const char *fmt)
 {
     int gettext_inuse = 0;
-    int gettext_changed = 0;
-    int gettext_reordered = 0;
     unsigned ftype;
     xo_xff_flags_t flags;
-    xo_field_info_t *new_fields = NULL;
     xo_field_info_t *xfip;
     unsigned field;
     ssize_t rc = 0;
 
     int flush = XOF_ISSET(xop, XOF_FLUSH);
     int flush_line = XOF_ISSET(xop, XOF_FLUSH_LINE);
-    char *new_fmt = NULL;
-
-    if (XOIF_ISSET(xop, XOIF_REORDER) || xo_style(xop) == XO_STYLE_ENCODER)
-	flush_line = 0;
+    xo_gt_entry_t *gtep = NULL;
 
     /*
-     * Some overhead for gettext; if the fields in the msgstr returned
-     * by gettext are reordered, then we need to record start and end
-     * for each field.  We'll go ahead and render the fields in the
-     * normal order, but later we can then reconstruct the reordered
-     * fields using these fstart/fend values.
+     * If a translation reorders the fields, we render them in the
+     * translated order, so each field needs the va_list as it stood
+     * before its arguments.  gt_args[i] holds that for the original
+     * field at index i (from gt_first, just past the {G:}), and
+     * gt_args[gt_last] is the va_list after the last one.
      */
-    unsigned flimit = max_fields * 2; /* Pessimistic limit */
-    unsigned min_fstart = flimit - 1;
-    unsigned max_fend = 0;	      /* Highest recorded fend[] entry */
-    ssize_t fstart[flimit];
-    bzero(fstart, flimit * sizeof(fstart[0]));
-    ssize_t fend[flimit];
-    bzero(fend, flimit * sizeof(fend[0]));
+    va_list *gt_args = NULL;
+    unsigned *gt_vals = NULL;	/* Same, as xo_values_cur, for XOIF_VALUES */
+    unsigned gt_first = 0, gt_last = 0;
+
+    if (xo_style(xop) == XO_STYLE_ENCODER)
+	flush_line = 0;
 
     for (xfip = fields, field = 0; field < max_fields && xfip->xfi_ftype;
 	 xfip++, field++) {
 	ftype = xfip->xfi_ftype;
 	flags = xfip->xfi_flags;
 
-	/* Record field start offset */
-	if (gettext_reordered) {
-	    fstart[field] = xo_buf_offset(&xop->xo_data);
-	    if (min_fstart > field)
-		min_fstart = field;
+	if (gt_vals && xfip->xfi_renum > gt_first)
+	    xop->xo_values_cur = gt_vals[xfip->xfi_renum - 1];
+	else if (gt_args && xfip->xfi_renum > gt_first) {
+	    va_end(xop->xo_vap);
+	    va_copy(xop->xo_vap, gt_args[xfip->xfi_renum - 1]);
 	}
 
 	const char *content = xfip->xfi_content;
@@ -6337,24 +8691,26 @@ xo_do_emit_fields (xo_handle_t *xop, xo_field_info_t *fields,
 	     * Argument flag means the content isn't given in the descriptor,
 	     * but as a UTF-8 string ('const char *') argument in xo_vap.
 	     */
-	    content = va_arg(xop->xo_vap, char *);
+	    content = xo_next_string(xop);
 	    clen = content ? strlen(content) : 0;
 	}
 
 	if (ftype == XO_ROLE_NEWLINE) {
 	    xo_line_close(xop);
-	    if (flush_line && xo_flush_h(xop) < 0)
-		return -1;
-	    goto bottom;
+	    if (flush_line && xo_flush_h(xop) < 0) {
+		rc = -1;
+		break;
+	    }
+	    continue;
 
 	} else if (ftype == XO_ROLE_EBRACE) {
 	    xo_format_text(xop, xfip->xfi_start, xfip->xfi_len);
-	    goto bottom;
+	    continue;
 
 	} else if (ftype == XO_ROLE_TEXT) {
 	    /* Normal text */
 	    xo_format_text(xop, xfip->xfi_content, xfip->xfi_clen);
-	    goto bottom;
+	    continue;
 	}
 
 	/*
@@ -6392,49 +8748,51 @@ xo_do_emit_fields (xo_handle_t *xop, xo_field_info_t *fields,
 
 	    if (!gettext_inuse) { /* Only translate once */
 		gettext_inuse = 1;
-		if (new_fmt) {
-		    xo_free(new_fmt);
-		    new_fmt = NULL;
-		}
 
-		xo_gettext_build_format(xop, fields, field,
-					xfip->xfi_next, &new_fmt);
-		if (new_fmt) {
-		    gettext_changed = 1;
-
-		    unsigned new_max_fields = xo_count_fields(xop, new_fmt);
-
-		    if (++new_max_fields < max_fields)
-			new_max_fields = max_fields;
-
-		    /* Leave a blank slot at the beginning */
-		    ssize_t sz = (new_max_fields + 1) * sizeof(xo_field_info_t);
-		    new_fields = alloca(sz);
-		    bzero(new_fields, sz);
-
-		    if (!xo_parse_fields(xop, new_fields + 1,
-					 new_max_fields, new_fmt)) {
-			gettext_reordered = 0;
-
-			if (!xo_gettext_combine_formats(xop, fmt, new_fmt,
-					fields, new_fields + 1,
-					new_max_fields, &gettext_reordered)) {
-
-			    if (gettext_reordered) {
-				if (XOF_ISSET(xop, XOF_LOG_GETTEXT))
-				    xo_failure(xop, "gettext finds reordered "
-					       "fields in '%s' and '%s'",
-					       xo_printable(fmt),
-					       xo_printable(new_fmt));
-				flush_line = 0; /* Must keep at content */
-				XOIF_SET(xop, XOIF_REORDER);
+		gtep = xo_gettext_translate(xop, fmt, fields,
+					    max_fields, field);
+		if (gtep && gtep->xge_fields) {
+		    if (gtep->xge_reordered) {
+			if (XOF_ISSET(xop, XOF_LOG_GETTEXT))
+			    xo_failure(xop, "gettext finds reordered "
+				       "fields in '%s' and '%s'",
+				       xo_printable(fmt),
+				       xo_printable(gtep->xge_new_format));
+
+			/* Walk the remaining original fields once */
+			unsigned i;
+			gt_first = field + 1;
+			gt_last = max_fields;
+			if (XOIF_ISSET(xop, XOIF_VALUES)) {
+			    gt_vals = alloca((max_fields + 1)
+					     * sizeof(unsigned));
+			    for (i = gt_first; i < max_fields
+				     && fields[i].xfi_ftype; i++) {
+				gt_vals[i] = xop->xo_values_cur;
+				xo_skip_field_args(xop, &fields[i]);
 			    }
-
-			    field = -1; /* Will be incremented at top of loop */
-			    xfip = new_fields;
-			    max_fields = new_max_fields;
+			    for (; i <= max_fields; i++)
+				gt_vals[i] = xop->xo_values_cur;
+
+			} else {
+			    gt_args = alloca((max_fields + 1)
+					     * sizeof(va_list));
+			    for (i = gt_first; i < max_fields
+				     && fields[i].xfi_ftype; i++) {
+				va_copy(gt_args[i], xop->xo_vap);
+				xo_skip_field_args(xop, &fields[i]);
+			    }
+			    for (; i <= max_fields; i++)
+				va_copy(gt_args[i], xop->xo_vap);
 			}
 		    }
+
+		    /* The translation may not outlive this call */
+		    XOIF_CLEAR(xop, XOIF_FMT_STABLE);
+
+		    field = -1; /* Will be incremented at top of loop */
+		    xfip = gtep->xge_fields;
+		    max_fields = gtep->xge_max_fields;
 		}
 	    }
 	    continue;
@@ -6459,22 +8817,21 @@ xo_do_emit_fields (xo_handle_t *xop, xo_field_info_t *fields,
 
 	if (flags & XFF_WS)
 	    xo_format_content(xop, "padding", NULL, " ", 1, NULL, 0, 0);
-
-    bottom:
-	/* Record the end-of-field offset */
-	if (gettext_reordered) {
-	    fend[field] = xo_buf_offset(&xop->xo_data);
-	    max_fend = field;
-	}
     }
 
-    if (gettext_changed && gettext_reordered) {
-	/* Final step: rebuild the content using the rendered fields */
-	xo_gettext_rebuild_content(xop, new_fields + 1, fstart, min_fstart,
-				   fend, max_fend);
-    }
+    if (gt_vals)
+	xop->xo_values_cur = gt_vals[gt_last];
+
+    if (gt_args) {
+	/* Leave xo_vap past all the arguments, as the caller expects */
+	unsigned i;
+
+	va_end(xop->xo_vap);
+	va_copy(xop->xo_vap, gt_args[gt_last]);
 
-    XOIF_CLEAR(xop, XOIF_REORDER);
+	for (i = gt_first; i <= gt_last; i++)
+	    va_end(gt_args[i]);
+    }
 
     /*
      * If we've got enough data, flush it.
@@ -6482,14 +8839,22 @@ xo_do_emit_fields (xo_handle_t *xop, xo_field_info_t *fields,
     if (xo_buf_offset(&xop->xo_data) > XO_BUF_HIGH_WATER)
 	flush = 1;
 
-    /* If we don't have an anchor, write the text out */
+    /*
+     * If we don't have an anchor, write the text out.  Otherwise,
+     * the anchored text has to stay in the buffer until the anchor
+     * is closed, but the text before it is complete and can be
+     * written, so the buffer doesn't grow without bound.
+     */
     if (flush && !XOIF_ISSET(xop, XOIF_ANCHOR)) {
 	if (xo_flush_h(xop) < 0)
 	    rc = -1;
+    } else if (flush && xop->xo_anchor_offset > 0) {
+	if (xo_write_prefix(xop, xop->xo_anchor_offset) < 0)
+	    rc = -1;
     }
 
-    if (new_fmt)
-	xo_free(new_fmt);
+    if (gtep && !gtep->xge_cached)
+	xo_free(gtep);
 
     /*
      * We've carried the gettext domainname inside our handle just for
@@ -6501,172 +8866,722 @@ xo_do_emit_fields (xo_handle_t *xop, xo_field_info_t *fields,
 	xop->xo_gt_domain = NULL;
     }
 
-    return (rc < 0) ? rc : xop->xo_columns;
+    return (rc < 0) ? rc : xop->xo_columns;
+}
+
+/*
+ * Parse and emit a set of fields
+ */
+static int
+xo_do_emit (xo_handle_t *xop, xo_emit_flags_t flags, const char *fmt)
+{
+    xop->xo_columns = 0;	/* Always reset it */
+    xop->xo_errno = errno;	/* Save for "%m" */
+
+    if (fmt == NULL)
+	return 0;
+
+    unsigned max_fields;
+    xo_field_info_t *fields = NULL;
+    ssize_t rc;
+
+    /* Adjust XOEF_RETAIN based on global flags */
+    if (XOF_ISSET(xop, XOF_RETAIN_ALL))
+	flags |= XOEF_RETAIN;
+    if (XOF_ISSET(xop, XOF_RETAIN_NONE))
+	flags &= ~XOEF_RETAIN;
+
+    /*
+     * Check for 'retain' flag, telling us to retain the field
+     * information.  If we've already saved it, then we can avoid
+     * re-parsing the format string.
+     */
+    if (!(flags & XOEF_RETAIN)
+	|| xo_retain_find(fmt, &fields, &max_fields) != 0
+	|| fields == NULL) {
+
+	if (xo_preload_find(fmt, &fields, &max_fields) == 0) {
+	    /* Preloaded; retain it under this address */
+	    if (flags & XOEF_RETAIN)
+		xo_retain_add(fmt, fields, max_fields);
+
+	    /* Preloaded fields point into our own copy of the format */
+	    XOIF_SET(xop, XOIF_FMT_STABLE);
+	    rc = xo_do_emit_fields(xop, fields, max_fields, fmt);
+	    XOIF_CLEAR(xop, XOIF_FMT_STABLE);
+	    return rc;
+	}
+
+	/* Nothing retained; parse the format string */
+	max_fields = xo_count_fields(xop, fmt);
+	fields = alloca(max_fields * sizeof(fields[0]));
+	bzero(fields, max_fields * sizeof(fields[0]));
+
+	if (xo_parse_fields(xop, fields, max_fields, fmt))
+	    return -1;		/* Warning already displayed */
+
+	if (flags & XOEF_RETAIN) {
+	    /* Retain the info */
+	    xo_retain_add(fmt, fields, max_fields);
+	}
+    }
+
+    /* Retained formats are immutable, so we can cache what's in them */
+    if (flags & XOEF_RETAIN)
+	XOIF_SET(xop, XOIF_FMT_STABLE);
+    rc = xo_do_emit_fields(xop, fields, max_fields, fmt);
+    XOIF_CLEAR(xop, XOIF_FMT_STABLE);
+
+    return rc;
+}
+
+/*
+ * Rebuild a format string in a gettext-friendly format.  This function
+ * is exposed to tools can perform this function.  See xo(1).
+ */
+char *
+xo_simplify_format (xo_handle_t *xop, const char *fmt, int with_numbers,
+		    xo_simplify_field_func_t field_cb)
+{
+    xop = xo_default(xop);
+
+    xop->xo_columns = 0;	/* Always reset it */
+    xop->xo_errno = errno;	/* Save for "%m" */
+
+    unsigned max_fields = xo_count_fields(xop, fmt);
+    xo_field_info_t fields[max_fields];
+
+    bzero(fields, max_fields * sizeof(fields[0]));
+
+    if (xo_parse_fields(xop, fields, max_fields, fmt))
+	return NULL;		/* Warning already displayed */
+
+    xo_buffer_t xb;
+    xo_buf_init(&xb);
+
+    if (with_numbers)
+	xo_gettext_finish_numbering_fields(xop, fmt, fields);
+
+    if (xo_gettext_simplify_format(xop, &xb, fields, -1, fmt, field_cb))
+	return NULL;
+
+    return xb.xb_bufp;
+}
+
+xo_ssize_t
+xo_emit_hv (xo_handle_t *xop, const char *fmt, va_list vap)
+{
+    ssize_t rc;
+
+    xop = xo_default(xop);
+    va_copy(xop->xo_vap, vap);
+    rc = xo_do_emit(xop, 0, fmt);
+    va_end(xop->xo_vap);
+    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+
+    return rc;
+}
+
+xo_ssize_t
+xo_emit_h (xo_handle_t *xop, const char *fmt, ...)
+{
+    ssize_t rc;
+
+    xop = xo_default(xop);
+    va_start(xop->xo_vap, fmt);
+    rc = xo_do_emit(xop, 0, fmt);
+    va_end(xop->xo_vap);
+    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+
+    return rc;
+}
+
+xo_ssize_t
+xo_emit (const char *fmt, ...)
+{
+    xo_handle_t *xop = xo_default(NULL);
+    ssize_t rc;
+
+    va_start(xop->xo_vap, fmt);
+    rc = xo_do_emit(xop, 0, fmt);
+    va_end(xop->xo_vap);
+    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+
+    return rc;
+}
+
+xo_ssize_t
+xo_emit_hvf (xo_handle_t *xop, xo_emit_flags_t flags,
+	     const char *fmt, va_list vap)
+{
+    ssize_t rc;
+
+    xop = xo_default(xop);
+    va_copy(xop->xo_vap, vap);
+    rc = xo_do_emit(xop, flags, fmt);
+    va_end(xop->xo_vap);
+    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+
+    return rc;
+}
+
+xo_ssize_t
+xo_emit_hf (xo_handle_t *xop, xo_emit_flags_t flags, const char *fmt, ...)
+{
+    ssize_t rc;
+
+    xop = xo_default(xop);
+    va_start(xop->xo_vap, fmt);
+    rc = xo_do_emit(xop, flags, fmt);
+    va_end(xop->xo_vap);
+    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+
+    return rc;
+}
+
+xo_ssize_t
+xo_emit_f (xo_emit_flags_t flags, const char *fmt, ...)
+{
+    xo_handle_t *xop = xo_default(NULL);
+    ssize_t rc;
+
+    va_start(xop->xo_vap, fmt);
+    rc = xo_do_emit(xop, flags, fmt);
+    va_end(xop->xo_vap);
+    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+
+    return rc;
+}
+
+/*
+ * Turn an offset from a compiled field into a pointer
+ */
+static const char *
+xo_compiled_ptr (const char *fmt, unsigned off)
+{
+    if (off == XO_COMPILED_NONE)
+	return NULL;
+    if (off == XO_COMPILED_DEFAULT)
+	return xo_default_format;
+    return fmt + off;
+}
+
+/*
+ * Fill in "fields" (of xc_max_fields entries) from a compiled format
+ */
+static void
+xo_compiled_load (const xo_compiled_t *xcp, xo_field_info_t *fields)
+{
+    const char *fmt = xcp->xc_format;
+    const xo_compiled_field_t *xcfp;
+    xo_field_info_t *xfip;
+    unsigned max_fields = xcp->xc_max_fields;
+
+    bzero(fields, max_fields * sizeof(fields[0]));
+
+    for (xcfp = xcp->xc_fields, xfip = fields;
+	 xcfp->xcf_ftype && xfip < fields + max_fields; xcfp++, xfip++) {
+	xfip->xfi_ftype = xcfp->xcf_ftype;
+	xfip->xfi_flags = xcfp->xcf_flags;
+	xfip->xfi_fnum = xcfp->xcf_fnum;
+	xfip->xfi_renum = xcfp->xcf_renum;
+	xfip->xfi_start = xo_compiled_ptr(fmt, xcfp->xcf_start);
+	xfip->xfi_len = xcfp->xcf_len;
+	xfip->xfi_content = xo_compiled_ptr(fmt, xcfp->xcf_content);
+	xfip->xfi_clen = xcfp->xcf_clen;
+	xfip->xfi_format = xo_compiled_ptr(fmt, xcfp->xcf_format);
+	xfip->xfi_flen = xcfp->xcf_flen;
+	xfip->xfi_encoding = xo_compiled_ptr(fmt, xcfp->xcf_encoding);
+	xfip->xfi_elen = xcfp->xcf_elen;
+	xfip->xfi_next = xo_compiled_ptr(fmt, xcfp->xcf_next);
+    }
+}
+
+/*
+ * Find the fields for a compiled format.  Once loaded, they're kept
+ * in the retain cache under xc_format, so later calls (in this
+ * thread) can use them directly.  Returns NULL if the caller needs
+ * to load them, using xo_compiled_retain.
+ */
+static xo_field_info_t *
+xo_compiled_find (xo_handle_t *xop, const xo_compiled_t *xcp)
+{
+    xo_field_info_t *fields = NULL;
+    unsigned num_fields;
+
+    if (XOF_ISSET(xop, XOF_RETAIN_NONE)
+	|| xo_retain_find(xcp->xc_format, &fields, &num_fields) != 0)
+	return NULL;
+
+    return fields;
+}
+
+static void
+xo_compiled_retain (xo_handle_t *xop, const xo_compiled_t *xcp,
+		    xo_field_info_t *fields)
+{
+    xo_compiled_load(xcp, fields);
+
+    if (!XOF_ISSET(xop, XOF_RETAIN_NONE))
+	xo_retain_add(xcp->xc_format, fields, xcp->xc_max_fields);
+}
+
+/*
+ * Emit using a compiled format (see "xolint-c -G"), avoiding the
+ * cost of parsing the format string.
+ */
+xo_ssize_t
+xo_emit_compiled_hv (xo_handle_t *xop, const xo_compiled_t *xcp, va_list vap)
+{
+    const char *fmt = xcp->xc_format;
+    xo_field_info_t *fields;
+    unsigned max_fields = xcp->xc_max_fields;
+    ssize_t rc;
+
+    xop = xo_default(xop);
+    va_copy(xop->xo_vap, vap);
+
+    if (xcp->xc_version != XO_COMPILED_VERSION) {
+	/* Not from our generator; parse it the old fashioned way */
+	rc = xo_do_emit(xop, XOEF_RETAIN, fmt);
+
+    } else {
+	xop->xo_columns = 0;	/* Always reset it */
+	xop->xo_errno = errno;	/* Save for "%m" */
+
+	fields = xo_compiled_find(xop, xcp);
+	if (fields == NULL) {
+	    fields = alloca(max_fields * sizeof(fields[0]));
+	    xo_compiled_retain(xop, xcp, fields);
+	}
+
+	XOIF_SET(xop, XOIF_FMT_STABLE);
+	rc = xo_do_emit_fields(xop, fields, max_fields, fmt);
+	XOIF_CLEAR(xop, XOIF_FMT_STABLE);
+    }
+
+    va_end(xop->xo_vap);
+    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+
+    return rc;
+}
+
+xo_ssize_t
+xo_emit_compiled_h (xo_handle_t *xop, const xo_compiled_t *xcp, ...)
+{
+    ssize_t rc;
+    va_list vap;
+
+    va_start(vap, xcp);
+    rc = xo_emit_compiled_hv(xop, xcp, vap);
+    va_end(vap);
+
+    return rc;
+}
+
+/*
+ * Start and finish using typed values in place of xo_vap.  Running
+ * out of values is reported when we finish, returning -1.
+ */
+static void
+xo_values_begin (xo_handle_t *xop, const xo_value_t *vals, unsigned num_vals)
+{
+    xop->xo_values = vals;
+    xop->xo_values_num = num_vals;
+    xop->xo_values_cur = 0;
+    XOIF_SET(xop, XOIF_VALUES);
+}
+
+static int
+xo_values_end (xo_handle_t *xop, const char *fmt)
+{
+    int rc = 0;
+
+    XOIF_CLEAR(xop, XOIF_VALUES);
+
+    if (xop->xo_values_cur > xop->xo_values_num) {
+	xo_failure(xop, "too few values (%u of %u) for format '%s'",
+		   xop->xo_values_num, xop->xo_values_cur,
+		   xo_printable(fmt));
+	rc = -1;
+    }
+
+    xop->xo_values = NULL;
+    xop->xo_values_num = xop->xo_values_cur = 0;
+
+    return rc;
+}
+
+/*
+ * Emit a set of parsed fields using typed values.  "stable" says the
+ * format is compiled or retained, so caches can trust its contents.
+ * Lists tolerate rows with too few values, so we don't turn that
+ * into an error here.
+ */
+static ssize_t
+xo_do_emit_values (xo_handle_t *xop, xo_field_info_t *fields,
+		   unsigned max_fields, const char *fmt, int stable,
+		   const xo_value_t *vals, unsigned num_vals)
+{
+    ssize_t rc;
+
+    xop->xo_columns = 0;	/* Always reset it */
+    xop->xo_errno = errno;	/* Save for "%m" */
+
+    xo_values_begin(xop, vals, num_vals);
+
+    if (stable)
+	XOIF_SET(xop, XOIF_FMT_STABLE);
+    rc = xo_do_emit_fields(xop, fields, max_fields, fmt);
+    XOIF_CLEAR(xop, XOIF_FMT_STABLE);
+
+    xo_values_end(xop, fmt);
+
+    return rc;
+}
+
+/*
+ * Emit using an array of typed values in place of a va_list.  The
+ * values are used in order, as printf arguments would be.  Too few
+ * values is an error, but the missing values are treated as zero
+ * (or NULL strings), so the output is still complete.
+ */
+xo_ssize_t
+xo_emit_values_hf (xo_handle_t *xop, xo_emit_flags_t flags, const char *fmt,
+		   const xo_value_t *vals, unsigned num_vals)
+{
+    ssize_t rc;
+
+    xop = xo_default(xop);
+
+    xo_values_begin(xop, vals, num_vals);
+    rc = xo_do_emit(xop, flags, fmt);
+    if (xo_values_end(xop, fmt) < 0)
+	rc = -1;
+
+    return rc;
+}
+
+xo_ssize_t
+xo_emit_values_h (xo_handle_t *xop, const char *fmt,
+		  const xo_value_t *vals, unsigned num_vals)
+{
+    return xo_emit_values_hf(xop, 0, fmt, vals, num_vals);
+}
+
+xo_ssize_t
+xo_emit_values (const char *fmt, const xo_value_t *vals, unsigned num_vals)
+{
+    return xo_emit_values_hf(NULL, 0, fmt, vals, num_vals);
+}
+
+xo_ssize_t
+xo_emit_compiled_values_h (xo_handle_t *xop, const xo_compiled_t *xcp,
+			   const xo_value_t *vals, unsigned num_vals)
+{
+    const char *fmt = xcp->xc_format;
+    xo_field_info_t *fields;
+    unsigned max_fields = xcp->xc_max_fields;
+    ssize_t rc;
+
+    xop = xo_default(xop);
+
+    if (xcp->xc_version != XO_COMPILED_VERSION)
+	return xo_emit_values_hf(xop, XOEF_RETAIN, fmt, vals, num_vals);
+
+    fields = xo_compiled_find(xop, xcp);
+    if (fields == NULL) {
+	fields = alloca(max_fields * sizeof(fields[0]));
+	xo_compiled_retain(xop, xcp, fields);
+    }
+
+    xop->xo_columns = 0;	/* Always reset it */
+    xop->xo_errno = errno;	/* Save for "%m" */
+
+    xo_values_begin(xop, vals, num_vals);
+
+    XOIF_SET(xop, XOIF_FMT_STABLE);
+    rc = xo_do_emit_fields(xop, fields, max_fields, fmt);
+    XOIF_CLEAR(xop, XOIF_FMT_STABLE);
+
+    if (xo_values_end(xop, fmt) < 0)
+	rc = -1;
+
+    return rc;
+}
+
+/*
+ * Turn one structure member into a typed value
+ */
+static void
+xo_member_value (xo_value_t *xvp, const xo_member_t *xmp, const char *base)
+{
+    const void *mp = base + xmp->xm_offset;
+
+    switch (xmp->xm_type) {
+    case XO_MT_INT8:
+	xvp->xv_type = XO_VT_INT;
+	xvp->xv_u.xv_int = *(const int8_t *) mp;
+	break;
+
+    case XO_MT_INT16:
+	xvp->xv_type = XO_VT_INT;
+	xvp->xv_u.xv_int = *(const int16_t *) mp;
+	break;
+
+    case XO_MT_INT32:
+	xvp->xv_type = XO_VT_INT;
+	xvp->xv_u.xv_int = *(const int32_t *) mp;
+	break;
+
+    case XO_MT_INT64:
+	xvp->xv_type = XO_VT_INT;
+	xvp->xv_u.xv_int = *(const int64_t *) mp;
+	break;
+
+    case XO_MT_UINT8:
+	xvp->xv_type = XO_VT_UINT;
+	xvp->xv_u.xv_uint = *(const uint8_t *) mp;
+	break;
+
+    case XO_MT_UINT16:
+	xvp->xv_type = XO_VT_UINT;
+	xvp->xv_u.xv_uint = *(const uint16_t *) mp;
+	break;
+
+    case XO_MT_UINT32:
+	xvp->xv_type = XO_VT_UINT;
+	xvp->xv_u.xv_uint = *(const uint32_t *) mp;
+	break;
+
+    case XO_MT_UINT64:
+	xvp->xv_type = XO_VT_UINT;
+	xvp->xv_u.xv_uint = *(const uint64_t *) mp;
+	break;
+
+    case XO_MT_FLOAT:
+	xvp->xv_type = XO_VT_DOUBLE;
+	xvp->xv_u.xv_double = *(const float *) mp;
+	break;
+
+    case XO_MT_DOUBLE:
+	xvp->xv_type = XO_VT_DOUBLE;
+	xvp->xv_u.xv_double = *(const double *) mp;
+	break;
+
+    case XO_MT_STRING:
+	xvp->xv_type = XO_VT_STRING;
+	xvp->xv_u.xv_string = *(const char * const *) mp;
+	break;
+
+    case XO_MT_CHARS:
+	xvp->xv_type = XO_VT_STRING;
+	xvp->xv_u.xv_string = (const char *) mp;
+	break;
+
+    case XO_MT_POINTER:
+	xvp->xv_type = XO_VT_POINTER;
+	xvp->xv_u.xv_pointer = *(const void * const *) mp;
+	break;
+
+    default:
+	xvp->xv_type = XO_VT_NONE;
+	break;
+    }
+}
+
+/*
+ * Return an upper bound on the number of values a format can use:
+ * one per '%' and '*', and one for each field whose content is an
+ * argument.
+ */
+static unsigned
+xo_format_max_values (const char *fmt, xo_field_info_t *fields,
+		      unsigned max_fields)
+{
+    unsigned count = 0, i;
+    const char *cp;
+
+    for (cp = fmt; *cp; cp++)
+	if (*cp == '%' || *cp == '*')
+	    count += 1;
+
+    for (i = 0; i < max_fields && fields[i].xfi_ftype; i++)
+	if (fields[i].xfi_flags & XFF_ARGUMENT)
+	    count += 1;
+
+    return count;
 }
 
 /*
- * Parse and emit a set of fields
+ * Emit a list named "name", with one instance for each row returned
+ * by "func".  The format's fields are loaded (or parsed) once, and the
+ * instances are opened and closed directly, rather than through
+ * xo_transition, sharing the caller's copy of "name".  We own the
+ * flushing, so XOF_FLUSH doesn't flush each row; the rows are written
+ * when the buffer fills and when the list is closed.  "max_vals" is
+ * the room given to "func", or zero to size it from the format.
  */
-static int
-xo_do_emit (xo_handle_t *xop, xo_emit_flags_t flags, const char *fmt)
+static ssize_t
+xo_do_emit_rows (xo_handle_t *xop, const char *name, const xo_compiled_t *xcp,
+		 xo_row_func_t func, void *opaque, unsigned max_vals)
 {
-    xop->xo_columns = 0;	/* Always reset it */
-    xop->xo_errno = errno;	/* Save for "%m" */
-
-    if (fmt == NULL)
-	return 0;
-
+    const char *fmt = xcp->xc_format;
     unsigned max_fields;
-    xo_field_info_t *fields = NULL;
+    xo_field_info_t *fields;
+    xo_value_t *vals;
+    ssize_t rc, total = 0;
+    int num_vals, flush, stable;
 
-    /* Adjust XOEF_RETAIN based on global flags */
-    if (XOF_ISSET(xop, XOF_RETAIN_ALL))
-	flags |= XOEF_RETAIN;
-    if (XOF_ISSET(xop, XOF_RETAIN_NONE))
-	flags &= ~XOEF_RETAIN;
+    xop = xo_default(xop);
+
+    if (name == NULL) {
+	xo_failure(xop, "NULL passed for list name");
+	return -1;
+    }
 
     /*
-     * Check for 'retain' flag, telling us to retain the field
-     * information.  If we've already saved it, then we can avoid
-     * re-parsing the format string.
+     * Load the fields once, parsing the format if needed.  Only a
+     * compiled format is known to be immutable; a parsed one is the
+     * caller's string, which we mustn't cache by address.
      */
-    if (!(flags & XOEF_RETAIN)
-	|| xo_retain_find(fmt, &fields, &max_fields) != 0
-	|| fields == NULL) {
-
-	/* Nothing retained; parse the format string */
+    stable = (xcp->xc_version == XO_COMPILED_VERSION);
+    if (stable) {
+	max_fields = xcp->xc_max_fields;
+	fields = xo_compiled_find(xop, xcp);
+	if (fields == NULL) {
+	    fields = alloca(max_fields * sizeof(fields[0]));
+	    xo_compiled_retain(xop, xcp, fields);
+	}
+    } else {
 	max_fields = xo_count_fields(xop, fmt);
 	fields = alloca(max_fields * sizeof(fields[0]));
 	bzero(fields, max_fields * sizeof(fields[0]));
 
 	if (xo_parse_fields(xop, fields, max_fields, fmt))
 	    return -1;		/* Warning already displayed */
-
-	if (flags & XOEF_RETAIN) {
-	    /* Retain the info */
-	    xo_retain_add(fmt, fields, max_fields);
-	}
     }
 
-    return xo_do_emit_fields(xop, fields, max_fields, fmt);
-}
+    if (max_vals == 0)
+	max_vals = xo_format_max_values(fmt, fields, max_fields);
+    vals = alloca((max_vals ?: 1) * sizeof(vals[0]));
 
-/*
- * Rebuild a format string in a gettext-friendly format.  This function
- * is exposed to tools can perform this function.  See xo(1).
- */
-char *
-xo_simplify_format (xo_handle_t *xop, const char *fmt, int with_numbers,
-		    xo_simplify_field_func_t field_cb)
-{
-    xop = xo_default(xop);
+    rc = xo_open_list_h(xop, name);
+    if (rc < 0)
+	return rc;
+    total += rc;
 
-    xop->xo_columns = 0;	/* Always reset it */
-    xop->xo_errno = errno;	/* Save for "%m" */
+    flush = XOF_ISSET(xop, XOF_FLUSH);
+    XOF_CLEAR(xop, XOF_FLUSH);
 
-    unsigned max_fields = xo_count_fields(xop, fmt);
-    xo_field_info_t fields[max_fields];
+    while ((num_vals = func(opaque, vals, max_vals)) >= 0) {
+	if ((unsigned) num_vals > max_vals) {
+	    xo_failure(xop, "too many values (%d of %u) for list '%s'",
+		       num_vals, max_vals, name);
+	    num_vals = max_vals;
+	}
 
-    bzero(fields, max_fields * sizeof(fields[0]));
+	rc = xo_do_open_instance(xop, 0, name, XSF_NAME_SHARED);
+	if (rc < 0)
+	    break;
+	total += rc;
 
-    if (xo_parse_fields(xop, fields, max_fields, fmt))
-	return NULL;		/* Warning already displayed */
+	rc = xo_do_emit_values(xop, fields, max_fields, fmt, stable,
+			       vals, num_vals);
+	if (rc < 0) {
+	    xo_do_close_instance(xop, name); /* Keep the stack balanced */
+	    break;
+	}
+	total += rc;
 
-    xo_buffer_t xb;
-    xo_buf_init(&xb);
+	rc = xo_do_close_instance(xop, name);
+	if (rc < 0)
+	    break;
+	total += rc;
+    }
 
-    if (with_numbers)
-	xo_gettext_finish_numbering_fields(xop, fmt, fields);
+    if (flush)
+	XOF_SET(xop, XOF_FLUSH);
 
-    if (xo_gettext_simplify_format(xop, &xb, fields, -1, fmt, field_cb))
-	return NULL;
+    if (xo_close_list_h(xop, name) < 0 || rc < 0)
+	return -1;
 
-    return xb.xb_bufp;
+    return total;
 }
 
 xo_ssize_t
-xo_emit_hv (xo_handle_t *xop, const char *fmt, va_list vap)
+xo_emit_rows_h (xo_handle_t *xop, const char *name, const xo_compiled_t *xcp,
+		xo_row_func_t func, void *opaque)
 {
-    ssize_t rc;
-
-    xop = xo_default(xop);
-    va_copy(xop->xo_vap, vap);
-    rc = xo_do_emit(xop, 0, fmt);
-    va_end(xop->xo_vap);
-    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
-
-    return rc;
+    return xo_do_emit_rows(xop, name, xcp, func, opaque, 0);
 }
 
 xo_ssize_t
-xo_emit_h (xo_handle_t *xop, const char *fmt, ...)
+xo_emit_rows (const char *name, const xo_compiled_t *xcp,
+	      xo_row_func_t func, void *opaque)
 {
-    ssize_t rc;
-
-    xop = xo_default(xop);
-    va_start(xop->xo_vap, fmt);
-    rc = xo_do_emit(xop, 0, fmt);
-    va_end(xop->xo_vap);
-    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
-
-    return rc;
+    return xo_do_emit_rows(NULL, name, xcp, func, opaque, 0);
 }
 
-xo_ssize_t
-xo_emit (const char *fmt, ...)
-{
-    xo_handle_t *xop = xo_default(NULL);
-    ssize_t rc;
+/*
+ * xo_emit_list walks its array of structures as a row function
+ */
+typedef struct xo_list_rows_s {
+    const xo_member_t *xlr_members; /* Member descriptions */
+    unsigned xlr_num_members;	/* Number of members */
+    const char *xlr_row;	/* Next structure */
+    size_t xlr_stride;		/* Distance between structures */
+    size_t xlr_left;		/* Number of structures left */
+} xo_list_rows_t;
 
-    va_start(xop->xo_vap, fmt);
-    rc = xo_do_emit(xop, 0, fmt);
-    va_end(xop->xo_vap);
-    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+static int
+xo_list_row (void *opaque, xo_value_t *vals, unsigned max)
+{
+    xo_list_rows_t *xlrp = opaque;
+    unsigned i;
 
-    return rc;
-}
+    if (xlrp->xlr_left == 0)
+	return -1;
 
-xo_ssize_t
-xo_emit_hvf (xo_handle_t *xop, xo_emit_flags_t flags,
-	     const char *fmt, va_list vap)
-{
-    ssize_t rc;
+    for (i = 0; i < xlrp->xlr_num_members && i < max; i++)
+	xo_member_value(&vals[i], &xlrp->xlr_members[i], xlrp->xlr_row);
 
-    xop = xo_default(xop);
-    va_copy(xop->xo_vap, vap);
-    rc = xo_do_emit(xop, flags, fmt);
-    va_end(xop->xo_vap);
-    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+    xlrp->xlr_row += xlrp->xlr_stride;
+    xlrp->xlr_left -= 1;
 
-    return rc;
+    return i;
 }
 
+/*
+ * Emit a list of "count" instances named "name", one for each
+ * structure in the array at "base" (with "stride" bytes between
+ * them).  The members are the arguments for the format, in order.
+ */
 xo_ssize_t
-xo_emit_hf (xo_handle_t *xop, xo_emit_flags_t flags, const char *fmt, ...)
-{
-    ssize_t rc;
-
-    xop = xo_default(xop);
-    va_start(xop->xo_vap, fmt);
-    rc = xo_do_emit(xop, flags, fmt);
-    va_end(xop->xo_vap);
-    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
+xo_emit_list_h (xo_handle_t *xop, const char *name,
+		const xo_compiled_t *xcp, const xo_member_t *members,
+		unsigned num_members, const void *base, size_t stride,
+		size_t count)
+{
+    xo_list_rows_t xlr = {
+	.xlr_members = members,
+	.xlr_num_members = num_members,
+	.xlr_row = base,
+	.xlr_stride = stride,
+	.xlr_left = count,
+    };
 
-    return rc;
+    return xo_do_emit_rows(xop, name, xcp, xo_list_row, &xlr,
+			   num_members ?: 1);
 }
 
 xo_ssize_t
-xo_emit_f (xo_emit_flags_t flags, const char *fmt, ...)
+xo_emit_list (const char *name, const xo_compiled_t *xcp,
+	      const xo_member_t *members, unsigned num_members,
+	      const void *base, size_t stride, size_t count)
 {
-    xo_handle_t *xop = xo_default(NULL);
-    ssize_t rc;
-
-    va_start(xop->xo_vap, fmt);
-    rc = xo_do_emit(xop, flags, fmt);
-    va_end(xop->xo_vap);
-    bzero(&xop->xo_vap, sizeof(xop->xo_vap));
-
-    return rc;
+    return xo_emit_list_h(NULL, name, xcp, members, num_members,
+			  base, stride, count);
 }
 
 /*
@@ -6845,6 +9760,8 @@ xo_depth_change (xo_handle_t *xop, const char *name,
 	if (xo_depth_check(xop, xop->xo_depth + delta))
 	    return;
 
+	xo_xpath_invalidate(xop, xop->xo_depth + 1);
+
 	xo_stack_t *xsp = &xop->xo_stack[xop->xo_depth + delta];
 	xsp->xs_flags = flags;
 	xsp->xs_state = state;
@@ -6853,7 +9770,12 @@ xo_depth_change (xo_handle_t *xop, const char *name,
 	if (name == NULL)
 	    name = XO_FAILURE_NAME;
 
-	xsp->xs_name = xo_strndup(name, -1);
+	if (flags & XSF_NAME_SHARED) {
+	    xsp->xs_name = name;
+	} else {
+	    xsp->xs_name_copy = xo_strndup(name, -1);
+	    xsp->xs_name = xsp->xs_name_copy;
+	}
 
     } else {			/* Pop operation */
 	if (xop->xo_depth == 0) {
@@ -6882,14 +9804,15 @@ xo_depth_change (xo_handle_t *xop, const char *name,
 	    }
 	}
 
-	if (xsp->xs_name) {
-	    xo_free(xsp->xs_name);
-	    xsp->xs_name = NULL;
-	}
-	if (xsp->xs_keys) {
-	    xo_free(xsp->xs_keys);
-	    xsp->xs_keys = NULL;
+	if (xsp->xs_name_copy) {
+	    xo_free(xsp->xs_name_copy);
+	    xsp->xs_name_copy = NULL;
 	}
+	xsp->xs_name = NULL;
+	/* Keep the key buffer, for the next frame at this depth */
+	xo_buf_reset(&xsp->xs_keys);
+
+	xo_xpath_invalidate(xop, xop->xo_depth);
     }
 
     xop->xo_depth += delta;	/* Record new depth */
@@ -6904,6 +9827,7 @@ xo_set_depth (xo_handle_t *xop, int depth)
     if (xo_depth_check(xop, depth))
 	return;
 
+    xo_xpath_invalidate(xop, 0);
     xop->xo_depth += depth;
     xop->xo_indent += depth;
 
@@ -7378,8 +10302,13 @@ xo_do_close_leaf_list (xo_handle_t *xop, const char *name)
     return rc;
 }
 
+/*
+ * Open an instance.  "xsf" gives additional flags for the new frame;
+ * XSF_NAME_SHARED avoids copying a name that will outlive the frame.
+ */
 static int
-xo_do_open_instance (xo_handle_t *xop, xo_xof_flags_t flags, const char *name)
+xo_do_open_instance (xo_handle_t *xop, xo_xof_flags_t flags, const char *name,
+		     xo_xsf_flags_t xsf)
 {
     xop = xo_default(xop);
 
@@ -7428,7 +10357,8 @@ xo_do_open_instance (xo_handle_t *xop, xo_xof_flags_t flags, const char *name)
 	break;
     }
 
-    xo_depth_change(xop, name, 1, 1, XSS_OPEN_INSTANCE, xo_stack_flags(flags));
+    xo_depth_change(xop, name, 1, 1, XSS_OPEN_INSTANCE,
+		    xo_stack_flags(flags) | xsf);
 
     return rc;
 }
@@ -7545,20 +10475,24 @@ xo_close_instance_d (void)
     return xo_close_instance_h(NULL, NULL);
 }
 
+/*
+ * Close frames, from the top of the stack down to (and including) the
+ * frame at "depth".  Each frame is closed by the routine for its state,
+ * which pops it; markers are popped here, handing their flags to the
+ * frame beneath them.
+ */
 static int
-xo_do_close_all (xo_handle_t *xop, xo_stack_t *limit)
+xo_do_close_to_depth (xo_handle_t *xop, int depth)
 {
     xo_stack_t *xsp;
-    ssize_t rc = 0;
+    ssize_t rc;
     xo_xsf_flags_t flags;
+    int cur;
 
-    for (xsp = &xop->xo_stack[xop->xo_depth]; xsp >= limit; xsp--) {
-	switch (xsp->xs_state) {
-	case XSS_INIT:
-	    /* Nothing */
-	    rc = 0;
-	    break;
+    for (cur = xop->xo_depth; cur >= depth; cur--) {
+	xsp = &xop->xo_stack[cur];
 
+	switch (xsp->xs_state) {
 	case XSS_OPEN_CONTAINER:
 	    rc = xo_do_close_container(xop, NULL);
 	    break;
@@ -7581,6 +10515,10 @@ xo_do_close_all (xo_handle_t *xop, xo_stack_t *limit)
 	    xop->xo_stack[xop->xo_depth].xs_flags |= flags;
 	    rc = 0;
 	    break;
+
+	default:		/* XSS_INIT: Nothing */
+	    rc = 0;
+	    break;
 	}
 
 	if (rc < 0)
@@ -7598,7 +10536,6 @@ static int
 xo_do_close (xo_handle_t *xop, const char *name, xo_state_t new_state)
 {
     xo_stack_t *xsp, *limit = NULL;
-    ssize_t rc;
     xo_state_t need_state = new_state;
 
     if (new_state == XSS_CLOSE_CONTAINER)
@@ -7650,11 +10587,132 @@ xo_do_close (xo_handle_t *xop, const char *name, xo_state_t new_state)
 	return 0;
     }
 
-    rc = xo_do_close_all(xop, limit);
-
-    return rc;
+    return xo_do_close_to_depth(xop, limit - xop->xo_stack);
 }
 
+/*
+ * The transition from one state to another is driven by a table,
+ * indexed by the old and new states.  Each entry gives a step to take
+ * first (typically closing an open list), the main action, and flags.
+ * Entries not in the table are zero, meaning XTM_UNKNOWN.
+ */
+typedef struct xo_transition_s {
+    uint8_t xt_pre;		/* XTP_* step to take first */
+    uint8_t xt_main;		/* XTM_* action */
+    uint8_t xt_flags;		/* XTF_* flags */
+} xo_transition_t;
+
+/* Values for xt_pre */
+#define XTP_NONE		0 /* Nothing */
+#define XTP_CLOSE_LEAF_LIST	1 /* Close the open leaf-list */
+#define XTP_CLOSE_LIST		2 /* Close the open list */
+#define XTP_CLOSE_INSTANCE	3 /* Close the open instance */
+#define XTP_OPEN_LIST		4 /* Open a list for the new instance */
+
+/* Values for xt_main */
+#define XTM_UNKNOWN		0 /* Not a valid transition */
+#define XTM_NONE		1 /* Nothing to do */
+#define XTM_OPEN_CONTAINER	2 /* Open a container */
+#define XTM_CLOSE_CONTAINER	3 /* Close a container (for "xo --close") */
+#define XTM_CLOSE		4 /* Close down to the named frame */
+#define XTM_OPEN_LIST		5 /* Open a list */
+#define XTM_OPEN_INSTANCE	6 /* Open an instance */
+#define XTM_CLOSE_INSTANCE	7 /* Close the open instance */
+#define XTM_OPEN_LEAF_LIST	8 /* Open a leaf-list */
+#define XTM_CLOSE_LEAF_LIST	9 /* Close the open leaf-list */
+#define XTM_CLOSE_ANY_LIST	10 /* Close down to the nearest list */
+#define XTM_IGNORE		11 /* Makes no sense; ignore it */
+
+/* Values for xt_flags */
+#define XTF_MARKER	(1<<0)	/* A marker on top prevents this transition */
+#define XTF_MARKER_OPEN	(1<<1)	/* A marker on top means XTP_OPEN_LIST */
+
+#define XT(_old, _new) [XSS_ ## _old][XSS_ ## _new]
+
+static const xo_transition_t xo_transitions[XSS_MAX + 1][XSS_MAX + 1] = {
+    XT(INIT, OPEN_CONTAINER) = { XTP_NONE, XTM_OPEN_CONTAINER, 0 },
+    XT(OPEN_INSTANCE, OPEN_CONTAINER) = { XTP_NONE, XTM_OPEN_CONTAINER, 0 },
+    XT(OPEN_CONTAINER, OPEN_CONTAINER) = { XTP_NONE, XTM_OPEN_CONTAINER, 0 },
+    XT(OPEN_LIST, OPEN_CONTAINER) =
+	{ XTP_CLOSE_LEAF_LIST, XTM_OPEN_CONTAINER, XTF_MARKER },
+    XT(OPEN_LEAF_LIST, OPEN_CONTAINER) =
+	{ XTP_CLOSE_LEAF_LIST, XTM_OPEN_CONTAINER, XTF_MARKER },
+
+    /* This is an exception for "xo --close" */
+    XT(INIT, CLOSE_CONTAINER) = { XTP_NONE, XTM_CLOSE_CONTAINER, 0 },
+    XT(OPEN_CONTAINER, CLOSE_CONTAINER) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+    XT(OPEN_LIST, CLOSE_CONTAINER) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+    XT(OPEN_INSTANCE, CLOSE_CONTAINER) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+    XT(OPEN_LEAF_LIST, CLOSE_CONTAINER) =
+	{ XTP_CLOSE_LEAF_LIST, XTM_CLOSE, XTF_MARKER },
+
+    XT(INIT, OPEN_LIST) = { XTP_NONE, XTM_OPEN_LIST, 0 },
+    XT(OPEN_CONTAINER, OPEN_LIST) = { XTP_NONE, XTM_OPEN_LIST, 0 },
+    XT(OPEN_INSTANCE, OPEN_LIST) = { XTP_NONE, XTM_OPEN_LIST, 0 },
+    XT(OPEN_LIST, OPEN_LIST) = { XTP_CLOSE_LIST, XTM_OPEN_LIST, XTF_MARKER },
+    XT(OPEN_LEAF_LIST, OPEN_LIST) =
+	{ XTP_CLOSE_LEAF_LIST, XTM_OPEN_LIST, XTF_MARKER },
+
+    XT(OPEN_LIST, CLOSE_LIST) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+    XT(INIT, CLOSE_LIST) = { XTP_NONE, XTM_CLOSE, 0 },
+    XT(OPEN_CONTAINER, CLOSE_LIST) = { XTP_NONE, XTM_CLOSE, 0 },
+    XT(OPEN_INSTANCE, CLOSE_LIST) = { XTP_NONE, XTM_CLOSE, 0 },
+    XT(OPEN_LEAF_LIST, CLOSE_LIST) = { XTP_NONE, XTM_CLOSE, 0 },
+
+    XT(OPEN_LIST, OPEN_INSTANCE) = { XTP_NONE, XTM_OPEN_INSTANCE, 0 },
+    XT(INIT, OPEN_INSTANCE) = { XTP_OPEN_LIST, XTM_OPEN_INSTANCE, 0 },
+    XT(OPEN_CONTAINER, OPEN_INSTANCE) =
+	{ XTP_OPEN_LIST, XTM_OPEN_INSTANCE, 0 },
+    XT(OPEN_INSTANCE, OPEN_INSTANCE) =
+	{ XTP_CLOSE_INSTANCE, XTM_OPEN_INSTANCE, XTF_MARKER_OPEN },
+    XT(OPEN_LEAF_LIST, OPEN_INSTANCE) =
+	{ XTP_CLOSE_LEAF_LIST, XTM_OPEN_INSTANCE, XTF_MARKER },
+
+    XT(OPEN_INSTANCE, CLOSE_INSTANCE) =
+	{ XTP_NONE, XTM_CLOSE_INSTANCE, XTF_MARKER },
+    XT(INIT, CLOSE_INSTANCE) = { XTP_NONE, XTM_IGNORE, 0 },
+    XT(OPEN_CONTAINER, CLOSE_INSTANCE) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+    XT(OPEN_LIST, CLOSE_INSTANCE) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+    XT(OPEN_LEAF_LIST, CLOSE_INSTANCE) =
+	{ XTP_CLOSE_LEAF_LIST, XTM_CLOSE, XTF_MARKER },
+
+    XT(OPEN_CONTAINER, OPEN_LEAF_LIST) = { XTP_NONE, XTM_OPEN_LEAF_LIST, 0 },
+    XT(OPEN_INSTANCE, OPEN_LEAF_LIST) = { XTP_NONE, XTM_OPEN_LEAF_LIST, 0 },
+    XT(INIT, OPEN_LEAF_LIST) = { XTP_NONE, XTM_OPEN_LEAF_LIST, 0 },
+    XT(OPEN_LIST, OPEN_LEAF_LIST) =
+	{ XTP_CLOSE_LIST, XTM_OPEN_LEAF_LIST, XTF_MARKER },
+    XT(OPEN_LEAF_LIST, OPEN_LEAF_LIST) =
+	{ XTP_CLOSE_LIST, XTM_OPEN_LEAF_LIST, XTF_MARKER },
+
+    XT(OPEN_LEAF_LIST, CLOSE_LEAF_LIST) =
+	{ XTP_NONE, XTM_CLOSE_LEAF_LIST, XTF_MARKER },
+    XT(INIT, CLOSE_LEAF_LIST) = { XTP_NONE, XTM_IGNORE, 0 },
+    XT(OPEN_CONTAINER, CLOSE_LEAF_LIST) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+    XT(OPEN_LIST, CLOSE_LEAF_LIST) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+    XT(OPEN_INSTANCE, CLOSE_LEAF_LIST) = { XTP_NONE, XTM_CLOSE, XTF_MARKER },
+
+    XT(OPEN_CONTAINER, EMIT) = { XTP_NONE, XTM_NONE, 0 },
+    XT(OPEN_INSTANCE, EMIT) = { XTP_NONE, XTM_NONE, 0 },
+    XT(INIT, EMIT) = { XTP_NONE, XTM_NONE, 0 },
+    XT(OPEN_LIST, EMIT) = { XTP_NONE, XTM_CLOSE_ANY_LIST, XTF_MARKER },
+    XT(OPEN_LEAF_LIST, EMIT) = { XTP_CLOSE_LEAF_LIST, XTM_NONE, XTF_MARKER },
+
+    XT(INIT, EMIT_LEAF_LIST) = { XTP_NONE, XTM_OPEN_LEAF_LIST, 0 },
+    XT(OPEN_CONTAINER, EMIT_LEAF_LIST) = { XTP_NONE, XTM_OPEN_LEAF_LIST, 0 },
+    XT(OPEN_INSTANCE, EMIT_LEAF_LIST) = { XTP_NONE, XTM_OPEN_LEAF_LIST, 0 },
+    XT(OPEN_LEAF_LIST, EMIT_LEAF_LIST) = { XTP_NONE, XTM_NONE, 0 },
+
+    /*
+     * We need to be backward compatible with the pre-xo_open_leaf_list
+     * API, where both lists and leaf-lists were opened as lists.  So
+     * if we find an open list that hasn't had anything written to it,
+     * we'll accept it.
+     */
+    XT(OPEN_LIST, EMIT_LEAF_LIST) = { XTP_NONE, XTM_NONE, 0 },
+};
+
+#undef XT
+
 /*
  * We are in a given state and need to transition to the new state.
  */
@@ -7665,6 +10723,8 @@ xo_transition (xo_handle_t *xop, xo_xof_flags_t flags, const char *name,
     xo_stack_t *xsp;
     ssize_t rc = 0;
     int old_state, on_marker;
+    const xo_transition_t *xtp = NULL;
+    unsigned pre;
 
     xop = xo_default(xop);
 
@@ -7685,222 +10745,92 @@ xo_transition (xo_handle_t *xop, xo_xof_flags_t flags, const char *name,
      *   XSS_INIT, XSS_OPEN_CONTAINER, XSS_OPEN_LIST,
      *   XSS_OPEN_INSTANCE, XSS_OPEN_LEAF_LIST, XSS_DISCARDING
      */
-    switch (XSS_TRANSITION(old_state, new_state)) {
-
-    open_container:
-    case XSS_TRANSITION(XSS_INIT, XSS_OPEN_CONTAINER):
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_OPEN_CONTAINER):
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_OPEN_CONTAINER):
-       rc = xo_do_open_container(xop, flags, name);
-       break;
-
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_OPEN_CONTAINER):
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_OPEN_CONTAINER):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_leaf_list(xop, NULL);
-	if (rc >= 0)
-	    goto open_container;
-	break;
-
-    case XSS_TRANSITION(XSS_INIT, XSS_CLOSE_CONTAINER):
-	/* This is an exception for "xo --close" */
-	rc = xo_do_close_container(xop, name);
-	break;
-
-    /*close_container:*/
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_CLOSE_CONTAINER):
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_CLOSE_CONTAINER):
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_CLOSE_CONTAINER):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close(xop, name, new_state);
-	break;
+    if (old_state <= XSS_MAX && new_state <= XSS_MAX)
+	xtp = &xo_transitions[old_state][new_state];
 
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_CLOSE_CONTAINER):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_leaf_list(xop, NULL);
-	if (rc >= 0)
-	    rc = xo_do_close(xop, name, new_state);
-	break;
+    if (xtp == NULL || xtp->xt_main == XTM_UNKNOWN) {
+	xo_failure(xop, "unknown transition: (%u -> %u)",
+		   xsp->xs_state, new_state);
+	goto done;
+    }
 
-    open_list:
-    case XSS_TRANSITION(XSS_INIT, XSS_OPEN_LIST):
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_OPEN_LIST):
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_OPEN_LIST):
-	rc = xo_do_open_list(xop, flags, name);
-	break;
+    if (on_marker && (xtp->xt_flags & XTF_MARKER)) {
+	xo_failure(xop, "marker '%s' prevents transition from %s to %s",
+		   xop->xo_stack[xop->xo_depth].xs_name,
+		   xo_state_name(old_state), xo_state_name(new_state));
+	return -1;
+    }
 
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_OPEN_LIST):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_list(xop, NULL);
-	if (rc >= 0)
-	    goto open_list;
-	break;
+    pre = xtp->xt_pre;
+    if (on_marker && (xtp->xt_flags & XTF_MARKER_OPEN))
+	pre = XTP_OPEN_LIST;
 
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_OPEN_LIST):
-	if (on_marker)
-	    goto marker_prevents_close;
+    switch (pre) {
+    case XTP_CLOSE_LEAF_LIST:
 	rc = xo_do_close_leaf_list(xop, NULL);
-	if (rc >= 0)
-	    goto open_list;
-	break;
-
-    /*close_list:*/
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_CLOSE_LIST):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close(xop, name, new_state);
 	break;
 
-    case XSS_TRANSITION(XSS_INIT, XSS_CLOSE_LIST):
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_CLOSE_LIST):
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_CLOSE_LIST):
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_CLOSE_LIST):
-	rc = xo_do_close(xop, name, new_state);
+    case XTP_CLOSE_LIST:
+	rc = xo_do_close_list(xop, NULL);
 	break;
 
-    open_instance:
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_OPEN_INSTANCE):
-	rc = xo_do_open_instance(xop, flags, name);
+    case XTP_CLOSE_INSTANCE:
+	rc = xo_do_close_instance(xop, NULL);
 	break;
 
-    case XSS_TRANSITION(XSS_INIT, XSS_OPEN_INSTANCE):
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_OPEN_INSTANCE):
+    case XTP_OPEN_LIST:
 	rc = xo_do_open_list(xop, flags, name);
-	if (rc >= 0)
-	    goto open_instance;
-	break;
-
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_OPEN_INSTANCE):
-	if (on_marker) {
-	    rc = xo_do_open_list(xop, flags, name);
-	} else {
-	    rc = xo_do_close_instance(xop, NULL);
-	}
-	if (rc >= 0)
-	    goto open_instance;
 	break;
+    }
 
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_OPEN_INSTANCE):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_leaf_list(xop, NULL);
-	if (rc >= 0)
-	    goto open_instance;
-	break;
+    if (rc < 0)
+	goto done;
 
-    /*close_instance:*/
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_CLOSE_INSTANCE):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_instance(xop, name);
+    switch (xtp->xt_main) {
+    case XTM_OPEN_CONTAINER:
+	rc = xo_do_open_container(xop, flags, name);
 	break;
 
-    case XSS_TRANSITION(XSS_INIT, XSS_CLOSE_INSTANCE):
-	/* This one makes no sense; ignore it */
-	xo_failure(xop, "xo_close_instance ignored when called from "
-		   "initial state ('%s')", name ?: "(unknown)");
+    case XTM_CLOSE_CONTAINER:
+	rc = xo_do_close_container(xop, name);
 	break;
 
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_CLOSE_INSTANCE):
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_CLOSE_INSTANCE):
-	if (on_marker)
-	    goto marker_prevents_close;
+    case XTM_CLOSE:
 	rc = xo_do_close(xop, name, new_state);
 	break;
 
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_CLOSE_INSTANCE):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_leaf_list(xop, NULL);
-	if (rc >= 0)
-	    rc = xo_do_close(xop, name, new_state);
-	break;
-
-    open_leaf_list:
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_OPEN_LEAF_LIST):
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_OPEN_LEAF_LIST):
-    case XSS_TRANSITION(XSS_INIT, XSS_OPEN_LEAF_LIST):
-	rc = xo_do_open_leaf_list(xop, flags, name);
-	break;
-
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_OPEN_LEAF_LIST):
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_OPEN_LEAF_LIST):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_list(xop, NULL);
-	if (rc >= 0)
-	    goto open_leaf_list;
+    case XTM_OPEN_LIST:
+	rc = xo_do_open_list(xop, flags, name);
 	break;
 
-    /*close_leaf_list:*/
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_CLOSE_LEAF_LIST):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_leaf_list(xop, name);
+    case XTM_OPEN_INSTANCE:
+	rc = xo_do_open_instance(xop, flags, name, 0);
 	break;
 
-    case XSS_TRANSITION(XSS_INIT, XSS_CLOSE_LEAF_LIST):
-	/* Makes no sense; ignore */
-	xo_failure(xop, "xo_close_leaf_list ignored when called from "
-		   "initial state ('%s')", name ?: "(unknown)");
+    case XTM_CLOSE_INSTANCE:
+	rc = xo_do_close_instance(xop, name);
 	break;
 
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_CLOSE_LEAF_LIST):
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_CLOSE_LEAF_LIST):
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_CLOSE_LEAF_LIST):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close(xop, name, new_state);
+    case XTM_OPEN_LEAF_LIST:
+	rc = xo_do_open_leaf_list(xop, flags, name);
 	break;
 
-    /*emit:*/
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_EMIT):
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_EMIT):
+    case XTM_CLOSE_LEAF_LIST:
+	rc = xo_do_close_leaf_list(xop, name);
 	break;
 
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_EMIT):
-	if (on_marker)
-	    goto marker_prevents_close;
+    case XTM_CLOSE_ANY_LIST:
 	rc = xo_do_close(xop, NULL, XSS_CLOSE_LIST);
 	break;
 
-    case XSS_TRANSITION(XSS_INIT, XSS_EMIT):
-	break;
-
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_EMIT):
-	if (on_marker)
-	    goto marker_prevents_close;
-	rc = xo_do_close_leaf_list(xop, NULL);
-	break;
-
-    /*emit_leaf_list:*/
-    case XSS_TRANSITION(XSS_INIT, XSS_EMIT_LEAF_LIST):
-    case XSS_TRANSITION(XSS_OPEN_CONTAINER, XSS_EMIT_LEAF_LIST):
-    case XSS_TRANSITION(XSS_OPEN_INSTANCE, XSS_EMIT_LEAF_LIST):
-	rc = xo_do_open_leaf_list(xop, flags, name);
-	break;
-
-    case XSS_TRANSITION(XSS_OPEN_LEAF_LIST, XSS_EMIT_LEAF_LIST):
-	break;
-
-    case XSS_TRANSITION(XSS_OPEN_LIST, XSS_EMIT_LEAF_LIST):
-	/*
-	 * We need to be backward compatible with the pre-xo_open_leaf_list
-	 * API, where both lists and leaf-lists were opened as lists.  So
-	 * if we find an open list that hasn't had anything written to it,
-	 * we'll accept it.
-	 */
+    case XTM_IGNORE:
+	xo_failure(xop, "xo_%s ignored when called from "
+		   "initial state ('%s')", xo_state_name(new_state),
+		   name ?: "(unknown)");
 	break;
-
-    default:
-	xo_failure(xop, "unknown transition: (%u -> %u)",
-		   xsp->xs_state, new_state);
     }
 
+ done:
     /* Handle the flush flag */
     if (rc >= 0 && XOF_ISSET(xop, XOF_FLUSH))
 	if (xo_flush_h(xop) < 0)
@@ -7910,12 +10840,6 @@ xo_transition (xo_handle_t *xop, xo_xof_flags_t flags, const char *name,
     XOIF_SET(xop, XOIF_MADE_OUTPUT);
 
     return rc;
-
- marker_prevents_close:
-    xo_failure(xop, "marker '%s' prevents transition from %s to %s",
-	       xop->xo_stack[xop->xo_depth].xs_name,
-	       xo_state_name(old_state), xo_state_name(new_state));
-    return -1;
 }
 
 xo_ssize_t
@@ -8005,7 +10929,7 @@ xo_finish_h (xo_handle_t *xop)
     xop = xo_default(xop);
 
     if (!XOF_ISSET(xop, XOF_NO_CLOSE))
-	xo_do_close_all(xop, xop->xo_stack);
+	xo_do_close_to_depth(xop, 0);
 
     switch (xo_style(xop)) {
     case XO_STYLE_JSON:
@@ -8027,6 +10951,10 @@ xo_finish_h (xo_handle_t *xop)
     case XO_STYLE_ENCODER:
 	xo_encoder_handle(xop, XO_OP_FINISH, NULL, NULL, 0);
 	break;
+
+    case XO_STYLE_HTML:
+	xo_html_chunk_close(xop);
+	break;
     }
 
     return xo_flush_h(xop);
@@ -8478,6 +11406,19 @@ xo_set_private (xo_handle_t *xop, void *opaque)
     xop->xo_private = opaque;
 }
 
+/*
+ * Record a function to receive failure messages, for tools that
+ * want to report them in their own way.
+ */
+void
+xo_set_failure_func (xo_handle_t *xop, xo_failure_func_t func, void *opaque)
+{
+    xop = xo_default(xop);
+
+    xop->xo_failure_func = func;
+    xop->xo_failure_opaque = opaque;
+}
+
 /*
  * Get the encoder function
  */
@@ -8523,7 +11464,7 @@ xo_explicit_transition (xo_handle_t *xop, xo_state_t new_state,
 	break;
 
     case XSS_OPEN_INSTANCE:
-	xo_do_open_instance(xop, flags, name);
+	xo_do_open_instance(xop, flags, name, 0);
 	break;
 
     case XSS_CLOSE_INSTANCE:
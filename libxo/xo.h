@@ -79,10 +79,10 @@ typedef unsigned long long xo_xof_flags_t;
 #define XOF_IGNORE_CLOSE XOF_BIT(12) /** Ignore errors on close tags */
 #define XOF_NOT_FIRST	XOF_BIT(13) /* Not the first item (JSON)  */
 #define XOF_NO_LOCALE	XOF_BIT(14) /** Don't bother with locale */
-#define XOF_RESV15	XOF_BIT(15) /* Unused */
+#define XOF_HTML_COMPACT XOF_BIT(15) /** Short class names, XPath prefixes */
 
 #define XOF_NO_TOP	XOF_BIT(16) /** Don't emit the top braces in JSON */
-#define XOF_RESV17	XOF_BIT(17) /* Unused  */
+#define XOF_HTML_TAGS	XOF_BIT(17) /** Use a table of tag names (HTML) */
 #define XOF_UNITS	XOF_BIT(18) /** Encode units in XML */
 #define XOF_RESV19	XOF_BIT(19) /* Unused */
 
@@ -176,6 +176,21 @@ xo_set_style_name (xo_handle_t *xop, const char *style);
 int
 xo_set_options (xo_handle_t *xop, const char *input);
 
+/*
+ * A set of options (as given to xo_set_options), parsed once and
+ * ready to be applied to any number of handles.
+ */
+typedef struct xo_options_s xo_options_t;
+
+xo_options_t *
+xo_options_parse (const char *input);
+
+int
+xo_options_apply (xo_handle_t *xop, const xo_options_t *options);
+
+void
+xo_options_free (xo_options_t *options);
+
 xo_xof_flags_t
 xo_get_flags (xo_handle_t *xop);
 
@@ -699,4 +714,144 @@ xo_retain_clear_all (void);
 void
 xo_retain_clear (const char *fmt);
 
+int
+xo_retain_preload (xo_handle_t *xop, const char * const *fmts, unsigned count);
+
+/*
+ * Compiled format strings hold the results of parsing a format
+ * string, as generated by "xolint-c -G", allowing xo_emit to skip
+ * parsing at run time.  Values are offsets into xc_format, or one
+ * of the special values below.  The field list ends with a zero
+ * xcf_ftype.  If XO_COMPILED_VERSION doesn't match, libxo falls
+ * back to parsing xc_format.
+ */
+#define XO_COMPILED_VERSION	1
+#define XO_COMPILED_NONE	0xffffffffU /* No value */
+#define XO_COMPILED_DEFAULT	0xfffffffeU /* The default format ("%s") */
+
+typedef struct xo_compiled_field_s {
+    unsigned xcf_ftype;		/* Field type (role, or text) */
+    unsigned long xcf_flags;	/* Field flags (XFF_*) */
+    unsigned xcf_fnum;		/* Field number */
+    unsigned xcf_renum;		/* Reordered number */
+    unsigned xcf_start;		/* Start of field */
+    unsigned xcf_len;		/* Length of field */
+    unsigned xcf_content;	/* Field's content */
+    unsigned xcf_clen;		/* Content length */
+    unsigned xcf_format;	/* Field's format */
+    unsigned xcf_flen;		/* Format length */
+    unsigned xcf_encoding;	/* Field's encoding format */
+    unsigned xcf_elen;		/* Encoding length */
+    unsigned xcf_next;		/* Next character in format string */
+} xo_compiled_field_t;
+
+typedef struct xo_compiled_s {
+    unsigned xc_version;	/* XO_COMPILED_VERSION */
+    const char *xc_format;	/* Original format string */
+    unsigned xc_max_fields;	/* Fields needed (per xo_count_fields) */
+    const xo_compiled_field_t *xc_fields; /* Parsed fields */
+} xo_compiled_t;
+
+xo_ssize_t
+xo_emit_compiled_hv (xo_handle_t *xop, const xo_compiled_t *xcp, va_list vap);
+
+xo_ssize_t
+xo_emit_compiled_h (xo_handle_t *xop, const xo_compiled_t *xcp, ...);
+
+/*
+ * Typed values can be given in place of a va_list (see
+ * xo_emit_values_h).  Each value carries its own type, and libxo
+ * converts it to the type needed by the field's format, so a
+ * XO_VT_UINT value can be rendered with "%d" and a XO_VT_STRING
+ * value of "12" with "%u".  Values are used in the same order as
+ * printf arguments, with each '*' in a format using a value of its
+ * own.
+ */
+typedef enum xo_value_type_e {
+    XO_VT_NONE = 0,		/* No value (zero or a NULL string) */
+    XO_VT_INT,			/* Signed integer (xv_u.xv_int) */
+    XO_VT_UINT,			/* Unsigned integer (xv_u.xv_uint) */
+    XO_VT_DOUBLE,		/* Floating point number (xv_u.xv_double) */
+    XO_VT_STRING,		/* UTF-8 string (xv_u.xv_string) */
+    XO_VT_POINTER,		/* Pointer (xv_u.xv_pointer) */
+} xo_value_type_t;
+
+typedef struct xo_value_s {
+    xo_value_type_t xv_type;	/* Type of value (XO_VT_*) */
+    union {
+	long long xv_int;	/* XO_VT_INT */
+	unsigned long long xv_uint; /* XO_VT_UINT */
+	double xv_double;	/* XO_VT_DOUBLE */
+	const char *xv_string;	/* XO_VT_STRING */
+	const void *xv_pointer;	/* XO_VT_POINTER */
+    } xv_u;			/* Value (e.g. vals[0].xv_u.xv_int) */
+} xo_value_t;
+
+xo_ssize_t
+xo_emit_values_hf (xo_handle_t *xop, xo_emit_flags_t flags, const char *fmt,
+		   const xo_value_t *vals, unsigned num_vals);
+
+xo_ssize_t
+xo_emit_values_h (xo_handle_t *xop, const char *fmt,
+		  const xo_value_t *vals, unsigned num_vals);
+
+xo_ssize_t
+xo_emit_values (const char *fmt, const xo_value_t *vals, unsigned num_vals);
+
+xo_ssize_t
+xo_emit_compiled_values_h (xo_handle_t *xop, const xo_compiled_t *xcp,
+			   const xo_value_t *vals, unsigned num_vals);
+
+/*
+ * A member descriptor tells libxo where to find a value in a
+ * structure, and what C type it has.  See xo_emit_list_h.
+ */
+typedef enum xo_member_type_e {
+    XO_MT_NONE = 0,		/* Nothing (an XO_VT_NONE value) */
+    XO_MT_INT8,			/* int8_t */
+    XO_MT_INT16,		/* int16_t */
+    XO_MT_INT32,		/* int32_t */
+    XO_MT_INT64,		/* int64_t */
+    XO_MT_UINT8,		/* uint8_t */
+    XO_MT_UINT16,		/* uint16_t */
+    XO_MT_UINT32,		/* uint32_t */
+    XO_MT_UINT64,		/* uint64_t */
+    XO_MT_FLOAT,		/* float */
+    XO_MT_DOUBLE,		/* double */
+    XO_MT_STRING,		/* const char * (UTF-8) */
+    XO_MT_CHARS,		/* char[] (UTF-8, NUL-terminated) */
+    XO_MT_POINTER,		/* void * */
+} xo_member_type_t;
+
+typedef struct xo_member_s {
+    xo_member_type_t xm_type;	/* Type of member (XO_MT_*) */
+    size_t xm_offset;		/* Offset of member (from offsetof) */
+} xo_member_t;
+
+xo_ssize_t
+xo_emit_list_h (xo_handle_t *xop, const char *name,
+		const xo_compiled_t *xcp, const xo_member_t *members,
+		unsigned num_members, const void *base, size_t stride,
+		size_t count);
+
+xo_ssize_t
+xo_emit_list (const char *name, const xo_compiled_t *xcp,
+	      const xo_member_t *members, unsigned num_members,
+	      const void *base, size_t stride, size_t count);
+
+/*
+ * A row function fills in "vals" (which has room for "max" values)
+ * with the arguments for the next instance, returning the number of
+ * values used, or -1 when there are no more rows.  See xo_emit_rows_h.
+ */
+typedef int (*xo_row_func_t)(void *opaque, xo_value_t *vals, unsigned max);
+
+xo_ssize_t
+xo_emit_rows_h (xo_handle_t *xop, const char *name, const xo_compiled_t *xcp,
+		xo_row_func_t func, void *opaque);
+
+xo_ssize_t
+xo_emit_rows (const char *name, const xo_compiled_t *xcp,
+	      xo_row_func_t func, void *opaque);
+
 #endif /* INCLUDE_XO_H */
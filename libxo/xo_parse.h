@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#ifndef XO_PARSE_H
+#define XO_PARSE_H
+
+/*
+ * NOTE WELL: This file is needed by tools (like xolint) that inspect
+ * format strings using libxo's own parser, so their view of a format
+ * string matches what libxo does at run time.  General libxo code
+ * should _never_ include this header file.  It must be included after
+ * "xo.h" and "xo_encoder.h" (for xo_xff_flags_t).
+ */
+
+/*
+ * Beyond the normal field roles ('V', 'T', etc), the parser uses
+ * these pseudo-roles for the text between fields.
+ */
+#define XO_ROLE_EBRACE	'{'	/* Escaped braces */
+#define XO_ROLE_TEXT	'+'
+#define XO_ROLE_NEWLINE	'\n'
+
+/*
+ * This structure represents the parsed field information, suitable for
+ * processing by xo_do_emit and anything else that needs to parse fields.
+ * Note that all pointers point to the main format string.
+ *
+ * XXX This is a first step toward compilable or cachable format
+ * strings.  We can also cache the results of dgettext when no format
+ * is used, assuming the 'p' modifier has _not_ been set.
+ */
+typedef struct xo_field_info_s {
+    xo_xff_flags_t xfi_flags;	/* Flags for this field */
+    unsigned xfi_ftype;		/* Field type, as character (e.g. 'V') */
+    const char *xfi_start;   /* Start of field in the format string */
+    const char *xfi_content;	/* Field's content */
+    const char *xfi_format;	/* Field's Format */
+    const char *xfi_encoding;	/* Field's encoding format */
+    const char *xfi_next;	/* Next character in format string */
+    ssize_t xfi_len;		/* Length of field */
+    ssize_t xfi_clen;		/* Content length */
+    ssize_t xfi_flen;		/* Format length */
+    ssize_t xfi_elen;		/* Encoding length */
+    unsigned xfi_fnum;		/* Field number (if used; 0 otherwise) */
+    unsigned xfi_renum;		/* Reordered number (0 == no renumbering) */
+} xo_field_info_t;
+
+/*
+ * Return the number of xo_field_info_t's needed to parse the format
+ * string.  The caller should allocate (and zero) this many.
+ */
+int
+xo_count_fields (xo_handle_t *xop, const char *fmt);
+
+/*
+ * Parse a format string into fields, returning non-zero on failure.
+ */
+int
+xo_parse_fields (xo_handle_t *xop, xo_field_info_t *fields,
+		 unsigned num_fields, const char *fmt);
+
+/*
+ * When set, failure messages (normally only displayed when XOF_WARN
+ * is set) are passed to this function instead of being written to
+ * stderr.  "fmt" is the untouched printf-style format of the message,
+ * allowing the caller to identify specific failures.
+ */
+typedef void (*xo_failure_func_t)(void *opaque, const char *fmt,
+				  const char *msg);
+
+void
+xo_set_failure_func (xo_handle_t *xop, xo_failure_func_t func, void *opaque);
+
+#endif /* XO_PARSE_H */
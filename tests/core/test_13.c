@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xo_config.h"
+#include "xo.h"
+
+/*
+ * A table in the style generated by "xolint-c -F".  The last entry
+ * is broken, so the preload reports a failure for it.
+ */
+static const char *xo_format_table[] = {
+    "{T:Item}: {T:Count}\n",
+    "{k:name}: {:count/%u}\n",
+    "{Lwc:Total}{:total/%u} {U:items}\n",
+    "{:broken/%s",
+};
+static unsigned xo_format_count =
+    (sizeof(xo_format_table) / sizeof(xo_format_table[0]));
+
+int
+main (int argc, char **argv)
+{
+    static const char *names[] = { "gum", "rope", "ladder", "bolt" };
+    static unsigned counts[] = { 1412, 85, 0, 4123 };
+    unsigned i, total = 0;
+    int failed;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_flags(NULL, XOF_UNITS);
+
+    failed = xo_retain_preload(NULL, xo_format_table, xo_format_count);
+
+    xo_open_container("top");
+    xo_emit("{L:Failed to preload}: {:failed/%d}\n", failed);
+
+    /* A different copy of a preloaded format still finds it */
+    char *title = strdup("{T:Item}: {T:Count}\n");
+    xo_emit(title, "Item", "Count");
+    free(title);
+
+    xo_open_list("item");
+    for (i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+	xo_open_instance("item");
+	xo_emit_f(XOEF_RETAIN, "{k:name}: {:count/%u}\n",
+		  names[i], counts[i]);
+	xo_close_instance("item");
+	total += counts[i];
+    }
+    xo_close_list("item");
+
+    xo_emit("{Lwc:Total}{:total/%u} {U:items}\n", total);
+
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
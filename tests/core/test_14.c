@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test "html-chunk", which groups HTML lines into <template> chunks
+ * for xohtml.js to render on demand.  Other styles are unchanged.
+ */
+int
+main (int argc, char **argv)
+{
+    int i;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_options(NULL, "html-chunk=4");
+
+    xo_open_container("top");
+    xo_emit("{T:Row/%-6s}{T:Square/%s}\n");
+
+    xo_open_list("row");
+    for (i = 1; i <= 10; i++) {
+	xo_open_instance("row");
+	xo_emit("{k:number/%-6d}{:square/%d}\n", i, i * i);
+	xo_close_instance("row");
+    }
+    xo_close_list("row");
+
+    xo_emit("\n{L:Partial}");
+    xo_emit("{:rows/ %d}\n", 10);
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
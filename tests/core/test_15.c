@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+xo_info_t info[] = {
+    { "name", "string", "Name of the interface" },
+    { "mtu", "number", "Maximum transmission unit" },
+    { "packets", "number", "Packets received" },
+};
+int info_count = (sizeof(info) / sizeof(info[0]));
+
+/*
+ * Test "html-compact" and "html-tags": short class names, XPath
+ * prefixes given once when they change, and a table of tag names.
+ * Other styles are unchanged.
+ */
+int
+main (int argc, char **argv)
+{
+    struct ifdata {
+	const char *if_name;
+	unsigned if_mtu;
+	unsigned long if_packets;
+    } ifdata[] = {
+	{ "em0", 1500, 3021 },
+	{ "em1", 9000, 14 },
+	{ "lo0", 16384, 882 },
+	{ NULL, 0, 0 }
+    }, *ip;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_set_options(NULL, "html-compact,html-tags");
+    xo_set_info(NULL, info, info_count);
+
+    xo_open_container("interfaces");
+    xo_emit("{T:Name/%-6s}{T:MTU/%6s}{T:Packets/%10s}\n");
+
+    xo_open_list("interface");
+    for (ip = ifdata; ip->if_name; ip++) {
+	xo_open_instance("interface");
+	xo_emit("{k:name/%-6s/%s}{:mtu/%6u/%u}{:packets/%10lu/%lu}\n",
+		ip->if_name, ip->if_mtu, ip->if_packets);
+	xo_open_container("errors");
+	xo_emit("{P:      }{Lwc:Errors}{:packets/%lu}{Uw:packets}\n",
+		ip->if_packets / 100);
+	xo_close_container("errors");
+	xo_close_instance("interface");
+    }
+    xo_close_list("interface");
+
+    xo_emit("{Lwc:Total}{:count/%u}\n", 3);
+    xo_close_container("interfaces");
+
+    xo_finish();
+
+    return 0;
+}
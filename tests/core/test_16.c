@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test xo_options_parse and xo_options_apply: options parsed once
+ * and applied to a handle, along with the handling of bad input.
+ */
+int
+main (int argc, char **argv)
+{
+    xo_options_t *opts, *bad;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    bad = xo_options_parse("underscores,no-such-option");
+    opts = xo_options_parse("underscores, units,indent=4");
+
+    xo_open_container("top");
+
+    xo_emit("{L:Bad options}: {:bad-options/%s}\n",
+	    bad ? "parsed" : "rejected");
+
+    if (xo_options_apply(NULL, opts) < 0)
+	xo_emit("{:apply-error/%s}\n", "failed");
+
+    xo_open_list("disk");
+    xo_open_instance("disk");
+    xo_emit("{k:disk-name/%s} {:free-space/%u}{U:/MB}\n", "ada0", 4096);
+    xo_close_instance("disk");
+    xo_open_instance("disk");
+    xo_emit("{k:disk-name/%s} {:free-space/%u}{U:/MB}\n", "ada1", 512);
+    xo_close_instance("disk");
+    xo_close_list("disk");
+
+    xo_close_container("top");
+
+    xo_options_free(opts);
+    xo_options_free(bad);
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test xo_emit_values_h and xo_emit_compiled_values_h: formats
+ * given arrays of typed values in place of a va_list.
+ */
+static const xo_compiled_t part_format = {
+    0, "{k:sku/%s} {:count/%4u} {:price/%8.2f}\n", 0, NULL
+};
+
+int
+main (int argc, char **argv)
+{
+    xo_value_t vals[8];
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_open_container("top");
+
+    /* Values of each type */
+    vals[0].xv_type = XO_VT_STRING;
+    vals[0].xv_u.xv_string = "gum";
+    vals[1].xv_type = XO_VT_INT;
+    vals[1].xv_u.xv_int = -42;
+    vals[2].xv_type = XO_VT_UINT;
+    vals[2].xv_u.xv_uint = 18446744073709551615ULL;
+    vals[3].xv_type = XO_VT_DOUBLE;
+    vals[3].xv_u.xv_double = 3.25;
+    vals[4].xv_type = XO_VT_STRING;
+    vals[4].xv_u.xv_string = "x";
+    xo_emit_values("{:name/%s} {:int/%d} {:uint/%llu} {:real/%.3f} "
+		   "{:letter/%c}\n", vals, 5);
+
+    /* Strings converted to the types their formats need */
+    vals[0].xv_u.xv_string = "17";
+    vals[1].xv_type = XO_VT_STRING;
+    vals[1].xv_u.xv_string = "0x20";
+    vals[2].xv_type = XO_VT_STRING;
+    vals[2].xv_u.xv_string = "1.5e3";
+    xo_emit_values("{:dec/%d} {:hex/%x} {:float/%g}\n", vals, 3);
+
+    /* Widths and precisions given as values */
+    vals[0].xv_type = XO_VT_INT;
+    vals[0].xv_u.xv_int = 6;
+    vals[1].xv_type = XO_VT_INT;
+    vals[1].xv_u.xv_int = 99;
+    vals[2].xv_type = XO_VT_INT;
+    vals[2].xv_u.xv_int = 3;
+    vals[3].xv_type = XO_VT_STRING;
+    vals[3].xv_u.xv_string = "abcdef";
+    xo_emit_values("[{:wide/%*d}] [{:short/%.*s}]\n", vals, 4);
+
+    /* A title given as a value */
+    vals[0].xv_type = XO_VT_STRING;
+    vals[0].xv_u.xv_string = "Color";
+    vals[1].xv_type = XO_VT_STRING;
+    vals[1].xv_u.xv_string = "blue";
+    xo_emit_values("{T:/%s}: {:shade/%s}\n", vals, 2);
+
+    xo_open_list("part");
+    for (int i = 0; i < 3; i++) {
+	static const char *skus[] = { "GRO-000-415", "HRD-000-212",
+				      "HRD-000-517" };
+
+	vals[0].xv_type = XO_VT_STRING;
+	vals[0].xv_u.xv_string = skus[i];
+	vals[1].xv_type = XO_VT_UINT;
+	vals[1].xv_u.xv_uint = (i + 1) * 15;
+	vals[2].xv_type = XO_VT_DOUBLE;
+	vals[2].xv_u.xv_double = 1.99 + i * 10;
+
+	xo_open_instance("part");
+	xo_emit_compiled_values_h(NULL, &part_format, vals, 3);
+	xo_close_instance("part");
+    }
+    xo_close_list("part");
+
+    /* Too few values is reported as a failure */
+    vals[0].xv_type = XO_VT_STRING;
+    vals[0].xv_u.xv_string = "only";
+    if (xo_emit_values("{:first/%s} {:second/%s}\n", vals, 1) < 0)
+	xo_emit("{:short-values/%s}\n", "failed");
+
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "xo.h"
+
+/*
+ * Test streaming of large string values: each style's output for a
+ * large value (with characters that need escaping, and multi-byte
+ * UTF-8 characters) is sent to a writer that records its size, a
+ * hash of its contents, and whether any single write was large.
+ */
+typedef struct sink_s {
+    size_t s_bytes;		/* Total bytes written */
+    uint32_t s_hash;		/* FNV-1a hash of the output */
+    size_t s_max;		/* Largest single write */
+} sink_t;
+
+static xo_ssize_t
+sink_write (void *opaque, const char *data)
+{
+    sink_t *sp = opaque;
+    size_t len = strlen(data);
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+	sp->s_hash ^= (unsigned char) data[i];
+	sp->s_hash *= 16777619;
+    }
+
+    sp->s_bytes += len;
+    if (len > sp->s_max)
+	sp->s_max = len;
+
+    return len;
+}
+
+static const char *styles[] = { "text", "xml", "json", "html", NULL };
+
+int
+main (int argc, char **argv)
+{
+    static const char pattern[] = "ab<c>&d\"e\\f\tg\xc3\xa9h\xe2\x82\xac ";
+    size_t len = 200000, plen = sizeof(pattern) - 1, i;
+    char *big;
+    int s;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    big = malloc(len + 1);
+    if (big == NULL)
+	return 1;
+
+    for (i = 0; i < len; i++)
+	big[i] = pattern[i % plen];
+    while (len > 0 && (big[len - 1] & 0x80)) /* Don't end mid-character */
+	len -= 1;
+    big[len] = '\0';
+
+    xo_open_container("top");
+    xo_open_list("style");
+
+    for (s = 0; styles[s]; s++) {
+	sink_t sink = { 0, 2166136261U, 0 };
+	xo_handle_t *xop = xo_create(XO_STYLE_TEXT, XOF_UTF8);
+
+	xo_set_options(xop, styles[s]);
+	xo_set_writer(xop, &sink, sink_write, NULL, NULL);
+
+	xo_open_container_h(xop, "top");
+	xo_emit_h(xop, "{T:Data}: {:data/%s}\n", big);
+	xo_emit_h(xop, "{:size/%zu}\n", len);
+	xo_close_container_h(xop, "top");
+	xo_finish_h(xop);
+	xo_destroy(xop);
+
+	xo_open_instance("style");
+	xo_emit("{k:name/%s}: {:bytes/%zu} {:hash/%08x} {:chunked}\n",
+		styles[s], sink.s_bytes, sink.s_hash,
+		(sink.s_max < 65536) ? "yes" : "no");
+	xo_close_instance("style");
+    }
+
+    xo_close_list("style");
+    xo_close_container("top");
+
+    xo_finish();
+
+    free(big);
+    return 0;
+}
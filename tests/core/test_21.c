@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xo.h"
+
+/*
+ * Test an anchor that stays open across several xo_emit calls,
+ * started by a call that makes enough output to pass the buffer's
+ * high-water mark.  The output before the anchor is written without
+ * waiting for the anchor to close, and the total output (including
+ * the anchor's padding) is the same size.  All we need from the
+ * writer is how much it was given, and how often.
+ */
+typedef struct counter_s {
+    size_t c_bytes;		/* Total bytes written */
+    unsigned c_writes;		/* Number of writes */
+} counter_t;
+
+static xo_ssize_t
+counter_write (void *opaque, const char *data)
+{
+    counter_t *cp = opaque;
+    size_t len = strlen(data);
+
+    cp->c_bytes += len;
+    cp->c_writes += 1;
+
+    return len;
+}
+
+static const char *styles[] = { "text", "html", NULL };
+
+int
+main (int argc, char **argv)
+{
+    char filler[12001];
+    int s;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    memset(filler, 'x', sizeof(filler) - 1);
+    filler[sizeof(filler) - 1] = '\0';
+
+    xo_open_container("top");
+    xo_open_list("style");
+
+    for (s = 0; styles[s]; s++) {
+	counter_t counter = { 0, 0 };
+	unsigned before_close;
+	xo_handle_t *xop = xo_create(XO_STYLE_TEXT, 0);
+
+	xo_set_options(xop, styles[s]);
+	xo_set_writer(xop, &counter, counter_write, NULL, NULL);
+
+	xo_emit_h(xop, "{:filler/%.*s}\n{[:30}{:min/%d}",
+		  (int) sizeof(filler) - 1, filler, 1);
+	xo_emit_h(xop, "/{:cur/%d}", 4);
+	xo_emit_h(xop, "/{:max/%d}", 15);
+	before_close = counter.c_writes;
+	xo_emit_h(xop, "{]:}|\n");
+
+	xo_finish_h(xop);
+	xo_destroy(xop);
+
+	xo_open_instance("style");
+	xo_emit("{k:name/%s}: {:bytes/%zu} {:early}\n",
+		styles[s], counter.c_bytes, (before_close > 0) ? "yes" : "no");
+	xo_close_instance("style");
+    }
+
+    xo_close_list("style");
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "xo.h"
+
+/*
+ * Test humanized integer fields.  Text output humanizes "%ju" and
+ * "%lld" arguments directly, while "%s" goes through the formatted
+ * text, so each line shows both, and they should always match.  The
+ * values sit on either side of the powers of 1024 and 1000, and of
+ * the 9.95 edge where rounding to one decimal place gives "10".
+ */
+static const uintmax_t values[] = {
+    0, 1, 999, 1000, 1001, 1023, 1024, 1025,
+    9948, 9949, 9950, 9951, 9999, 10000,
+    10187, 10188, 10189, 10239, 10240,
+    999999, 1000000, 1048575, 1048576, 1048577,
+    10433331, 10433332, 999999999, 1000000000,
+    1073741823, 1073741824, 1099511627775ULL, 1099511627776ULL,
+    1125899906842624ULL, 1152921504606846976ULL, UINTMAX_MAX,
+};
+
+static const long long negatives[] = { -1, -1000, -1024, -10188 };
+
+int
+main (int argc, char **argv)
+{
+    char buf[32];
+    unsigned i;
+
+    argc = xo_parse_args(argc, argv);
+    if (argc < 0)
+	return 1;
+
+    xo_open_container("top");
+
+    xo_open_list("value");
+    for (i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+	snprintf(buf, sizeof(buf), "%ju", values[i]);
+
+	xo_open_instance("value");
+	xo_emit("{k:value/%ju}: {h:plain/%ju} {h:plain-text/%s}, "
+		"{h,hn-space:space/%ju} {h,hn-space:space-text/%s}, "
+		"{h,hn-decimal:decimal/%ju} {h,hn-decimal:decimal-text/%s}, "
+		"{h,hn-1000:si/%ju} {h,hn-1000:si-text/%s}, "
+		"{h,hn-decimal,hn-1000:si-decimal/%ju} "
+		"{h,hn-decimal,hn-1000:si-decimal-text/%s}\n",
+		values[i], values[i], buf, values[i], buf,
+		values[i], buf, values[i], buf, values[i], buf);
+	xo_close_instance("value");
+    }
+    xo_close_list("value");
+
+    xo_open_list("negative");
+    for (i = 0; i < sizeof(negatives) / sizeof(negatives[0]); i++) {
+	snprintf(buf, sizeof(buf), "%lld", negatives[i]);
+
+	xo_open_instance("negative");
+	xo_emit("{k:value/%lld}: {h:plain/%lld} {h:plain-text/%s}, "
+		"{h,hn-decimal,hn-1000:si-decimal/%lld} "
+		"{h,hn-decimal,hn-1000:si-decimal-text/%s}\n",
+		negatives[i], negatives[i], buf, negatives[i], buf);
+	xo_close_instance("negative");
+    }
+    xo_close_list("negative");
+
+    xo_close_container("top");
+
+    xo_finish();
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#
+# $Id$
+#
+# Copyright 2019, Juniper Networks, Inc.
+# All rights reserved.
+# This SOFTWARE is licensed under the LICENSE provided in the
+# ../Copyright file. By downloading, installing, copying, or otherwise
+# using the SOFTWARE, you agree to be bound by the terms of that
+# LICENSE.
+
+XO=$1
+shift
+
+XOP="${XO} --warn"
+
+# This is testing --batch and friends, reading argument records from stdin
+
+printf 'red\t55\ngreen\t66\nblue\t77\n' | \
+    ${XOP} --top-wrap --wrap top --instance machine --batch \
+        "Machine {k:name} has {:memory/%d}\n"
+
+printf 'one\0first value\0\ntwo\0second\tvalue\0\n' | \
+    ${XOP} --top-wrap --open data --batch-delimiter nul \
+        "{:name} is {:value}\n"
+
+printf '5:three10:line\nbreak\n' | \
+    ${XOP} --top-wrap --close data --not-first --batch-delimiter length \
+        "{:name} is {:value}\n"
+
+printf 'up\teth0\nstat\teth0\t1500\t42\nup\tlo0\n' | \
+    ${XOP} --top-wrap --wrap interfaces --instance interface \
+        --batch-format 'up=Interface {k:name} is up\n' \
+        --batch-format 'stat={k:name}: mtu {:mtu/%u} errors {:errors/%d}\n'
+
+# Coprocess mode keeps the real libxo state for the whole session
+printf '%s\n' \
+    'open container top' \
+    'open list machine' \
+    'open instance machine' \
+    'emit Machine {k:name} has {:memory/%d}\n	red	55' \
+    'close instance' \
+    'open instance machine' \
+    'emit Machine {k:name} has {:memory/%d}\n	green	66' \
+    'flush' \
+    'close list machine' \
+    'emit Total: {:total/%d}\n	2' \
+    'finish' | ${XOP} --top-wrap --coprocess
@@ -0,0 +1,36 @@
+#
+# $Id$
+#
+# Copyright 2019, Juniper Networks, Inc.
+# All rights reserved.
+# This SOFTWARE is licensed under the LICENSE provided in the
+# ../Copyright file. By downloading, installing, copying, or otherwise
+# using the SOFTWARE, you agree to be bound by the terms of that
+# LICENSE.
+
+XO=$1
+shift
+
+XOP="${XO} --warn --depth 2 --leading-xpath /top"
+
+# This is testing how xo passes its arguments to libxo's conversions
+
+${XO} --warn --top-wrap --open top
+
+# A value too big for the buffer is formatted twice; the field after
+# it must still get its own argument.  Squeeze the long run to keep
+# the output readable.
+LONG=`printf '%9000s' '' | tr ' ' a`
+${XOP} \
+    '{:long/%s} {:after/%s}\n' "${LONG}" second | tr -s a
+
+# Both '*' arguments of a "%*.*" conversion are used
+${XOP} --not-first \
+    '[{:padded/%*.*s}] [{:left/%-*.*s}] {:next/%s}\n' \
+    10 3 abcdef 8 2 xyz done
+
+# "%c" uses the first character of its argument
+${XOP} --not-first \
+    '{:initial/%c}{:rest/%s} {:flag/%c}\n' Hello ello yes
+
+${XO} --warn --top-wrap --close top
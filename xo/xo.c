@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "xo_config.h"
 #include "xo.h"
@@ -25,19 +26,60 @@
 
 static int opt_warn;		/* Enable warnings */
 
-static char **save_argv;
-static char **checkpoint_argv;
+/*
+ * In batch mode, we read argument records from stdin, emitting the
+ * format string for each record.  Records can be given in one of
+ * several encodings, selected via "--batch-delimiter".
+ */
+typedef enum batch_mode_e {
+    BATCH_TAB,			/* Fields are tab-separated, one line/record */
+    BATCH_NUL,			/* Fields are NUL-terminated */
+    BATCH_LENGTH,		/* Fields are "<len>:<bytes>" */
+} batch_mode_t;
+
+typedef struct batch_format_s {
+    char *bf_name;		/* Name of this format */
+    char *bf_format;		/* Format string (after prep_arg) */
+} batch_format_t;
+
+static batch_format_t *batch_formats; /* Named formats (--batch-format) */
+static int batch_formats_count;	/* Number of named formats */
 
-static char *
-next_arg (void)
+static char *batch_buf;		/* Field data for the current record */
+static size_t batch_bufsiz;	/* Size of batch_buf */
+static size_t *batch_offsets;	/* Offsets of each field in batch_buf */
+static char **batch_argv;	/* Fields of the current record */
+static size_t batch_argv_max;	/* Size of batch_argv/batch_offsets */
+
+static xo_value_t *arg_values;	/* Arguments for the format */
+static size_t arg_values_max;	/* Size of arg_values */
+
+/*
+ * Emit the format string with the given (NULL-terminated) arguments.
+ * Our arguments are all strings, and libxo converts each one to the
+ * type needed by its conversion (e.g. "%d" or "%5.2f").
+ */
+static void
+emit_args (xo_emit_flags_t flags, const char *fmt, char **argv)
 {
-    char *cp = *save_argv;
+    size_t argc;
+
+    for (argc = 0; argv[argc]; argc++) {
+	if (argc >= arg_values_max) {
+	    size_t sz = arg_values_max ? arg_values_max * 2 : 16;
+	    xo_value_t *vp = realloc(arg_values, sz * sizeof(*vp));
+	    if (vp == NULL)
+		xo_errx(1, "out of memory");
+	    arg_values = vp;
+	    arg_values_max = sz;
+	}
 
-    if (cp == NULL)
-	xo_errx(1, "missing argument");
+	arg_values[argc].xv_type = XO_VT_STRING;
+	arg_values[argc].xv_u.xv_string = argv[argc];
+    }
 
-    save_argv += 1;
-    return cp;
+    if (xo_emit_values_hf(NULL, flags, fmt, arg_values, argc) < 0)
+	xo_errx(1, "missing argument");
 }
 
 static void
@@ -78,106 +120,303 @@ prep_arg (char *fmt)
 }
 
 static void
-checkpoint (xo_handle_t *xop UNUSED, va_list vap UNUSED, int restore)
+batch_add_format (char *arg)
+{
+    char *cp = strchr(arg, '=');
+    if (cp == NULL || cp == arg)
+	xo_errx(1, "invalid batch format (expected 'name=format'): %s", arg);
+
+    *cp++ = '\0';
+
+    batch_format_t *bfp = realloc(batch_formats,
+				  (batch_formats_count + 1) * sizeof(*bfp));
+    if (bfp == NULL)
+	xo_errx(1, "out of memory");
+
+    batch_formats = bfp;
+    bfp += batch_formats_count++;
+    bfp->bf_name = arg;
+    bfp->bf_format = cp;
+
+    prep_arg(cp);
+}
+
+static const char *
+batch_find_format (const char *name)
+{
+    int i;
+
+    for (i = 0; i < batch_formats_count; i++)
+	if (strcmp(name, batch_formats[i].bf_name) == 0)
+	    return batch_formats[i].bf_format;
+
+    return NULL;
+}
+
+static void
+batch_append (size_t *offp, int ch)
 {
-    if (restore)
-	save_argv = checkpoint_argv;
-    else
-	checkpoint_argv = save_argv;
+    if (*offp + 1 >= batch_bufsiz) {
+	size_t sz = batch_bufsiz ? batch_bufsiz * 2 : BUFSIZ;
+	char *cp = realloc(batch_buf, sz);
+	if (cp == NULL)
+	    xo_errx(1, "out of memory");
+	batch_buf = cp;
+	batch_bufsiz = sz;
+    }
+
+    batch_buf[(*offp)++] = ch;
+}
+
+static void
+batch_start_field (size_t argc, size_t off)
+{
+    if (argc + 2 > batch_argv_max) {
+	size_t sz = batch_argv_max ? batch_argv_max * 2 : 16;
+	char **argv = realloc(batch_argv, sz * sizeof(*argv));
+	size_t *offsets = realloc(batch_offsets, sz * sizeof(*offsets));
+	if (argv == NULL || offsets == NULL)
+	    xo_errx(1, "out of memory");
+	batch_argv = argv;
+	batch_offsets = offsets;
+	batch_argv_max = sz;
+    }
+
+    batch_offsets[argc] = off;
 }
 
 /*
- * Our custom formatter is responsible for combining format string pieces
- * with our command line arguments to build strings.  This involves faking
- * some printf-style logic.
+ * Read the next record from the input stream, splitting it into a
+ * NULL-terminated set of fields in batch_argv.  Since batch_buf can
+ * move as it grows, we record offsets and turn them into pointers
+ * once the record is complete.  In "nul" and "length" modes, a
+ * newline where a field would start marks the end of the record.
+ * Returns the number of fields or -1 at end of file.
  */
-static xo_ssize_t
-formatter (xo_handle_t *xop, char *buf, xo_ssize_t bufsiz,
-	   const char *fmt, va_list vap UNUSED)
+static int
+batch_read_record (FILE *fp, batch_mode_t mode)
 {
-    int lflag UNUSED = 0;	/* Parse long flag, though currently ignored */
-    int hflag = 0, jflag = 0, tflag = 0,
-	zflag = 0, qflag = 0, star1 = 0, star2 = 0;
-    int rc = 0;
-    int w1 = 0, w2 = 0;
-    const char *cp;
-
-    for (cp = fmt + 1; *cp; cp++) {
-	if (*cp == 'l')
-	    lflag += 1;
-	else if (*cp == 'h')
-	    hflag += 1;
-	else if (*cp == 'j')
-	    jflag += 1;
-	else if (*cp == 't')
-	    tflag += 1;
-	else if (*cp == 'z')
-	    zflag += 1;
-	else if (*cp == 'q')
-	    qflag += 1;
-	else if (*cp == '*') {
-	    if (star1 == 0)
-		star1 = 1;
-	    else
-		star2 = 1;
-	} else if (strchr("diouxXDOUeEfFgGaAcCsSp", *cp) != NULL)
+    size_t argc = 0, off = 0, len, i;
+    int ch;
+
+    for (;;) {
+	ch = getc(fp);
+	if (ch == EOF)
 	    break;
-	else if (*cp == 'n' || *cp == 'v') {
-	    if (opt_warn)
-		xo_error_h(xop, "unsupported format: '%s'", fmt);
-	    return -1;
+
+	if (mode != BATCH_TAB && ch == '\n')
+	    break;		/* End of record */
+
+	batch_start_field(argc++, off);
+
+	if (mode == BATCH_LENGTH) {
+	    for (len = 0; ch >= '0' && ch <= '9'; ch = getc(fp))
+		len = len * 10 + (ch - '0');
+	    if (ch != ':')
+		xo_errx(1, "invalid length-prefixed field in record");
+
+	    for (i = 0; i < len; i++) {
+		ch = getc(fp);
+		if (ch == EOF)
+		    xo_errx(1, "truncated length-prefixed field in record");
+		batch_append(&off, ch);
+	    }
+
+	    batch_append(&off, '\0');
+	    continue;
 	}
+
+	/* Tab and NUL modes: read up to the end of the field */
+	for (; ch != EOF; ch = getc(fp)) {
+	    if (mode == BATCH_NUL) {
+		if (ch == '\0')
+		    break;
+	    } else if (ch == '\t' || ch == '\n')
+		break;
+
+	    batch_append(&off, ch);
+	}
+
+	batch_append(&off, '\0');
+
+	if (ch == EOF || (mode == BATCH_TAB && ch == '\n'))
+	    break;
     }
 
-    char fc = *cp;
+    if (ch == EOF && argc == 0)
+	return -1;
 
-    /* Handle "%*.*s" */
-    if (star1)
-	w1 = strtol(next_arg(), NULL, 0);
-    if (star2 > 1)
-	w2 = strtol(next_arg(), NULL, 0);
+    batch_start_field(argc, off); /* Ensure room for the trailing NULL */
+    for (i = 0; i < argc; i++)
+	batch_argv[i] = batch_buf + batch_offsets[i];
+    batch_argv[argc] = NULL;
 
-    if (fc == 'D' || fc == 'O' || fc == 'U')
-	lflag = 1;
+    return argc;
+}
 
-    if (strchr("diD", fc) != NULL) {
-	long long value = strtoll(next_arg(), NULL, 0);
-	if (star1 && star2)
-	    rc = snprintf(buf, bufsiz, fmt, w1, w2, value);
-	else if (star1)
-	    rc = snprintf(buf, bufsiz, fmt, w1, value);
-	else
-	    rc = snprintf(buf, bufsiz, fmt, value);
-
-    } else if (strchr("ouxXOUp", fc) != NULL) {
-	unsigned long long value = strtoull(next_arg(), NULL, 0);
-	if (star1 && star2)
-	    rc = snprintf(buf, bufsiz, fmt, w1, w2, value);
-	else if (star1)
-	    rc = snprintf(buf, bufsiz, fmt, w1, value);
+/*
+ * Emit the format string once per input record, reusing the handle
+ * (and its stack of open containers) for the entire input.  The
+ * parsed format is retained, so it's only parsed once.
+ */
+static void
+batch_emit (const char *fmt, batch_mode_t mode, const char *instance)
+{
+    const char *rfmt;
+    char **argv;
+    int argc, seen = 0;
+
+    while ((argc = batch_read_record(stdin, mode)) >= 0) {
+	argv = batch_argv;
+	rfmt = fmt;
+
+	if (batch_formats_count) {
+	    if (argc == 0)
+		continue;
+
+	    rfmt = batch_find_format(*argv);
+	    if (rfmt == NULL)
+		xo_errx(1, "unknown batch format: %s", *argv);
+	    argv += 1;
+	}
+
+	if (instance)
+	    xo_open_instance(instance);
+
+	emit_args(XOEF_RETAIN, rfmt, argv);
+
+	if (instance)
+	    xo_close_instance(instance);
+
+	seen = 1;
+    }
+
+    if (instance && seen)
+	xo_close_list(instance);
+}
+
+/*
+ * Formats given to the coprocess "emit" command live in the record
+ * buffer, which is reused for each line, so we keep our own copy of
+ * each distinct format.  This gives the retain cache a stable pointer,
+ * so each format is parsed only once.
+ */
+static char **coprocess_formats;
+static int coprocess_formats_count;
+
+static const char *
+coprocess_intern_format (const char *fmt)
+{
+    int i;
+
+    for (i = 0; i < coprocess_formats_count; i++)
+	if (strcmp(fmt, coprocess_formats[i]) == 0)
+	    return coprocess_formats[i];
+
+    char **newp = realloc(coprocess_formats,
+			  (coprocess_formats_count + 1) * sizeof(*newp));
+    char *cp = strdup(fmt);
+    if (newp == NULL || cp == NULL)
+	xo_errx(1, "out of memory");
+
+    coprocess_formats = newp;
+    coprocess_formats[coprocess_formats_count++] = cp;
+    return cp;
+}
+
+/*
+ * Handle the "open" and "close" commands, which take the type of the
+ * construct ("container", "list", or "instance") and a name.  The
+ * name is optional for "close".
+ */
+static void
+coprocess_open_close (int is_open, char *rest)
+{
+    char *name = rest + strcspn(rest, " ");
+
+    if (*name)
+	*name++ = '\0';
+    if (*name == '\0')
+	name = NULL;
+
+    if (is_open && name == NULL)
+	xo_errx(1, "missing name for open %s", rest);
+
+    if (strcmp(rest, "container") == 0) {
+	if (is_open)
+	    xo_open_container_d(name);
 	else
-	    rc = snprintf(buf, bufsiz, fmt, value);
-
-    } else if (strchr("eEfFgGaA", fc) != NULL) {
-	double value = strtold(next_arg(), NULL);
-	if (star1 && star2)
-	    rc = snprintf(buf, bufsiz, fmt, w1, w2, value);
-	else if (star1)
-	    rc = snprintf(buf, bufsiz, fmt, w1, value);
+	    xo_close_container(name);
+
+    } else if (strcmp(rest, "list") == 0) {
+	if (is_open)
+	    xo_open_list_d(name);
 	else
-	    rc = snprintf(buf, bufsiz, fmt, value);
-
-    } else if (fc == 'C' || fc == 'c' || fc == 'S' || fc == 's') {
-	char *value = next_arg();
-	if (star1 && star2)
-	    rc = snprintf(buf, bufsiz, fmt, w1, w2, value);
-	else if (star1)
-	    rc = snprintf(buf, bufsiz, fmt, w1, value);
+	    xo_close_list(name);
+
+    } else if (strcmp(rest, "instance") == 0) {
+	if (is_open)
+	    xo_open_instance_d(name);
 	else
-	    rc = snprintf(buf, bufsiz, fmt, value);
+	    xo_close_instance(name);
+
+    } else {
+	xo_errx(1, "unknown type for %s: '%s'", is_open ? "open" : "close",
+		rest);
     }
+}
+
+/*
+ * In coprocess mode, we read commands from stdin, using a single
+ * handle for the entire session, so the normal libxo state machine
+ * handles nesting and separators.  Each record is a command, with
+ * the first field holding the command name and its parameters:
+ *
+ *   open <type> <name>
+ *   close <type> [<name>]
+ *   emit <format>        (remaining fields are the arguments)
+ *   flush
+ *   finish
+ */
+static void
+coprocess_run (batch_mode_t mode)
+{
+    char *cmd, *rest;
+    int argc;
+
+    while ((argc = batch_read_record(stdin, mode)) >= 0) {
+	if (argc == 0)
+	    continue;
+
+	cmd = batch_argv[0];
+	rest = cmd + strcspn(cmd, " ");
+	if (*rest)
+	    *rest++ = '\0';
+
+	if (*cmd == '\0' || *cmd == '#') {
+	    continue;		/* Empty line or comment */
+
+	} else if (strcmp(cmd, "emit") == 0) {
+	    prep_arg(rest);
+	    emit_args(XOEF_RETAIN, coprocess_intern_format(rest),
+		      batch_argv + 1);
 
-    return rc;
+	} else if (strcmp(cmd, "open") == 0) {
+	    coprocess_open_close(1, rest);
+
+	} else if (strcmp(cmd, "close") == 0) {
+	    coprocess_open_close(0, rest);
+
+	} else if (strcmp(cmd, "flush") == 0) {
+	    xo_flush();
+
+	} else if (strcmp(cmd, "finish") == 0) {
+	    break;
+
+	} else {
+	    xo_errx(1, "unknown command: '%s'", cmd);
+	}
+    }
 }
 
 static void
@@ -194,10 +433,14 @@ print_help (void)
 {
     fprintf(stderr,
 "Usage: xo [options] format [fields]\n"
+"    --batch               Emit format for each argument record read from stdin\n"
+"    --batch-delimiter <mode> Record encoding for --batch (tab, nul, length)\n"
+"    --batch-format <name>=<format> Add a named format for --batch\n"
 "    --close <path>        Close tags for the given path\n"
 "    --close-instance <name> Close an open instance name\n"
 "    --close-list <name>   Close an open list name\n"
 "    --continuation OR -C  Output belongs on same line as previous output\n"
+"    --coprocess           Read open/close/emit/flush/finish commands from stdin\n"
 "    --depth <num>         Set the depth for pretty printing\n"
 "    --help                Display this help text\n"
 "    --html OR -H          Generate HTML output\n"
@@ -224,8 +467,12 @@ print_help (void)
 }
 
 static struct opts {
+    int o_batch;
+    int o_batch_delimiter;
+    int o_batch_format;
     int o_close_instance;
     int o_close_list;
+    int o_coprocess;
     int o_depth;
     int o_help;
     int o_not_first;
@@ -239,10 +486,14 @@ static struct opts {
 } opts;
 
 static struct option long_opts[] = {
+    { "batch", no_argument, &opts.o_batch, 1 },
+    { "batch-delimiter", required_argument, &opts.o_batch_delimiter, 1 },
+    { "batch-format", required_argument, &opts.o_batch_format, 1 },
     { "close", required_argument, NULL, 'c' },
     { "close-instance", required_argument, &opts.o_close_instance, 1 },
     { "close-list", required_argument, &opts.o_close_list, 1 },
     { "continuation", no_argument, NULL, 'C' },
+    { "coprocess", no_argument, &opts.o_coprocess, 1 },
     { "depth", required_argument, &opts.o_depth, 1 },
     { "help", no_argument, &opts.o_help, 1 },
     { "html", no_argument, NULL, 'H' },
@@ -279,6 +530,9 @@ main (int argc UNUSED, char **argv)
     int opt_depth = 0;
     int opt_not_first = 0;
     int opt_top_wrap = 0;
+    int opt_batch = 0;
+    int opt_coprocess = 0;
+    batch_mode_t opt_batch_mode = BATCH_TAB;
     int rc;
 
     argc = xo_parse_args(argc, argv);
@@ -348,7 +602,28 @@ main (int argc UNUSED, char **argv)
 	    break;
 
 	case 0:
-	    if (opts.o_depth) {
+	    if (opts.o_batch) {
+		opt_batch = 1;
+
+	    } else if (opts.o_batch_delimiter) {
+		if (strcmp(optarg, "tab") == 0)
+		    opt_batch_mode = BATCH_TAB;
+		else if (strcmp(optarg, "nul") == 0)
+		    opt_batch_mode = BATCH_NUL;
+		else if (strcmp(optarg, "length") == 0)
+		    opt_batch_mode = BATCH_LENGTH;
+		else
+		    xo_errx(1, "unknown batch delimiter: %s", optarg);
+		opt_batch = 1;
+
+	    } else if (opts.o_batch_format) {
+		batch_add_format(optarg);
+		opt_batch = 1;
+
+	    } else if (opts.o_coprocess) {
+		opt_coprocess = 1;
+
+	    } else if (opts.o_depth) {
 		opt_depth = atoi(optarg);
 		
 	    } else if (opts.o_help) {
@@ -430,8 +705,7 @@ main (int argc UNUSED, char **argv)
 	    xo_errx(1, "invalid options: %s", opt_options);
     }
 
-    xo_set_formatter(NULL, formatter, checkpoint);
-    xo_set_flags(NULL, XOF_NO_VA_ARG | XOF_NO_TOP | XOF_NO_CLOSE);
+    xo_set_flags(NULL, XOF_NO_TOP | XOF_NO_CLOSE);
 
     /*
      * If we have some explicit state change, handle it
@@ -448,8 +722,28 @@ main (int argc UNUSED, char **argv)
 	exit(0);
     }
 
-    fmt = *argv++;
-    if (opt_opener == NULL && opt_closer == NULL && fmt == NULL) {
+    /*
+     * In coprocess mode, the session is a complete document, so we let
+     * libxo close any open constructs when we finish.
+     */
+    if (opt_coprocess) {
+	if (opt_top_wrap)
+	    xo_clear_flags(NULL, XOF_NO_TOP);
+	xo_clear_flags(NULL, XOF_NO_CLOSE);
+
+	if (opt_depth > 0)
+	    xo_set_depth(NULL, opt_depth);
+
+	coprocess_run(opt_batch_mode);
+	xo_finish();
+	return 0;
+    }
+
+    if (!opt_batch || batch_formats_count == 0)
+	fmt = *argv++;
+    /* Batch mode always needs a format, either given or named */
+    if (fmt == NULL && batch_formats_count == 0
+	    && (opt_batch || (opt_opener == NULL && opt_closer == NULL))) {
 	print_help();
 	return 1;
     }
@@ -503,18 +797,25 @@ main (int argc UNUSED, char **argv)
 	}
     }
 
-    if (opt_instance)
-	xo_open_instance(opt_instance);
+    if (opt_batch) {
+	/* Batch mode handles instances itself, one per record */
+	if (fmt)
+	    prep_arg(fmt);
+	batch_emit(fmt, opt_batch_mode, opt_instance);
 
-    /* If there's a format string, call xo_emit to emit the contents */
-    if (fmt && *fmt) {
-	save_argv = argv;
-	prep_arg(fmt);
-	xo_emit(fmt);		/* This call does the real formatting */
-    }
+    } else {
+	if (opt_instance)
+	    xo_open_instance(opt_instance);
 
-    if (opt_instance)
-	xo_close_instance(opt_instance);
+	/* If there's a format string, call xo_emit to emit the contents */
+	if (fmt && *fmt) {
+	    prep_arg(fmt);
+	    emit_args(0, fmt, argv); /* This call does the real formatting */
+	}
+
+	if (opt_instance)
+	    xo_close_instance(opt_instance);
+    }
     
     /* If there's an wrapper hierarchy, close each element's container */
     while (opt_wrapper) {
@@ -1,12 +1,49 @@
 jQuery(function($) {
-    setTimeout(function() {
-        var $top = $("html body");
-        $top.find('[class~="data"]').each(function() {
-            var help = $(this).attr('data-help'),
-                type = $(this).attr('data-type'),
+    /*
+     * Output made with the "html-compact" libxo option uses short
+     * class names ("d" for "data"), gives XPath prefixes in empty
+     * <div class="xp"> elements when they change, and, with
+     * "html-tags", gives tag names (and their info) in empty
+     * <div class="tg" data-t="N"> elements, with fields using
+     * 'data-t="N"' in place of 'data-tag'.
+     */
+    var tags = {};
+
+    function addTag(div) {
+        tags[$(div).attr("data-t")] = {
+            tag: $(div).attr("data-tag"),
+            type: $(div).attr("data-type"),
+            help: $(div).attr("data-help")
+        };
+    }
+
+    /*
+     * Attach the help/type/xpath tooltips to the data fields
+     * under "$top".  "prefix" is the XPath prefix in effect at
+     * its start (for compact output); the prefix in effect at the
+     * end is returned.
+     */
+    function addTips($top, prefix) {
+        $top.find('div.xp, div.tg, [class~="data"], [class~="d"]')
+        .each(function() {
+            if ($(this).hasClass("xp")) {
+                prefix = $(this).attr("data-xpath");
+                return;
+            }
+            if ($(this).hasClass("tg")) {
+                addTag(this);
+                return;
+            }
+
+            var def = tags[$(this).attr("data-t")] || {},
+                help = $(this).attr('data-help') || def.help,
+                type = $(this).attr('data-type') || def.type,
+                tag = $(this).attr('data-tag') || def.tag,
                 xpath = $(this).attr('data-xpath'),
-                tag = $(this).attr('data-tag'),
                 output = "";
+            if (!xpath && prefix !== undefined && tag) {
+                xpath = prefix + "/" + tag;
+            }
             if (help) {
                 output += "<b>Help</b>: " + help  + "<br/>";
             }
@@ -16,7 +53,7 @@ jQuery(function($) {
             if (xpath) {
                 output += "<div class='xpath-wrapper'>"
                     + "<a class='xpath-link' href='#'>"
-                    + "show xpath</a><div class='xpath'>" 
+                    + "show xpath</a><div class='xpath'>"
                     + xpath + "</div></div><br/>";
             }
             if (output.length > 0) {
@@ -50,5 +87,104 @@ jQuery(function($) {
                 style: "qtip-tipped"
             });
         });
+
+        return prefix;
+    }
+
+    /*
+     * Output made with the "html-chunk=N" libxo option arrives as
+     * <template class="xo-chunk" data-line="L"> elements of N lines
+     * each.  Template contents are parsed but not rendered, so we
+     * build an index of the chunks, give each one a placeholder of
+     * its estimated height, and only render (and add tooltips to)
+     * the chunks that are near the visible window.  Chunks that
+     * scroll far away are emptied again, keeping the DOM small.
+     */
+    function renderChunks(chunks, prefix) {
+        var index = [], lineHeight = 0, i;
+
+        for (i = 0; i < chunks.length; i++) {
+            var tmpl = chunks[i],
+                holder = $("<div class='xo-chunk'/>")
+                    .attr("data-line", $(tmpl).attr("data-line")),
+                content = $(tmpl.content);
+
+            /* Record the XPath prefix and tags each chunk needs */
+            index.push({
+                template: tmpl,
+                holder: holder,
+                lines: tmpl.content.childElementCount,
+                prefix: prefix,
+                shown: false
+            });
+            content.find("div.xp").each(function() {
+                prefix = $(this).attr("data-xpath");
+            });
+            content.find("div.tg").each(function() {
+                addTag(this);
+            });
+            $(tmpl).after(holder);
+        }
+
+        function show(chunk) {
+            if (chunk.shown) {
+                return;
+            }
+            chunk.shown = true;
+            chunk.holder.css("height", "")
+                .append(document.importNode(chunk.template.content, true));
+            addTips(chunk.holder, chunk.prefix);
+        }
+
+        function hide(chunk) {
+            if (!chunk.shown) {
+                return;
+            }
+            chunk.shown = false;
+            chunk.holder.css("height", chunk.holder.height() + "px").empty();
+        }
+
+        /* Render the first chunk to learn the line height */
+        show(index[0]);
+        if (index[0].lines > 0) {
+            lineHeight = index[0].holder.height() / index[0].lines;
+        }
+        for (i = 1; i < index.length; i++) {
+            index[i].holder.css("height",
+                                Math.ceil(index[i].lines * lineHeight) + "px");
+        }
+
+        if (!("IntersectionObserver" in window)) {
+            for (i = 1; i < index.length; i++) {
+                show(index[i]);
+            }
+            return;
+        }
+
+        /* Keep a screenful above and below the window rendered */
+        var observer = new IntersectionObserver(function(entries) {
+            entries.forEach(function(entry) {
+                var chunk = index[$(entry.target).data("xo-chunk")];
+                if (entry.isIntersecting) {
+                    show(chunk);
+                } else {
+                    hide(chunk);
+                }
+            });
+        }, { rootMargin: "100% 0px" });
+
+        for (i = 0; i < index.length; i++) {
+            index[i].holder.data("xo-chunk", i);
+            observer.observe(index[i].holder[0]);
+        }
+    }
+
+    setTimeout(function() {
+        var chunks = $("template.xo-chunk");
+
+        var prefix = addTips($("html body"));
+        if (chunks.length > 0) {
+            renderChunks(chunks.get(), prefix);
+        }
     }, 0);
-});
\ No newline at end of file
+});
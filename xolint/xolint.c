@@ -0,0 +1,1880 @@
+/*
+ * Copyright (c) 2019, Juniper Networks, Inc.
+ * All rights reserved.
+ * This SOFTWARE is licensed under the LICENSE provided in the
+ * ../Copyright file. By downloading, installing, copying, or otherwise
+ * using the SOFTWARE, you agree to be bound by the terms of that
+ * LICENSE.
+ *
+ * xolint-c -- a native version of xolint.pl, using libxo's own
+ * format string parser (xo_parse_fields) so that the linter's view
+ * of a format string is exactly what libxo sees at run time.  Input
+ * files are mmap'd and tokenized just enough to find calls to the
+ * xo_emit family with literal format strings; multiple files can be
+ * checked in parallel (-j).  Messages match those of xolint.pl.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <string.h>
+#include <stddef.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "xo_config.h"
+#include "xo.h"
+#include "xo_encoder.h"
+#include "xo_parse.h"
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+#include <getopt.h>		/* Include after xo.h for testing */
+
+#ifndef UNUSED
+#define UNUSED __attribute__ ((__unused__))
+#endif /* UNUSED */
+
+static int opt_cpp;		/* Run input through cpp */
+static char *opt_cflags;	/* Flags to pass to cpp */
+static int opt_info;		/* Generate xo_info_t table */
+static int opt_print;		/* Print input lines with messages */
+static int opt_vocabulary;	/* Print field names */
+static int opt_formats;		/* Generate format string table */
+static int opt_generate;	/* Generate compiled emit functions */
+static int opt_jobs = 1;	/* Number of worker threads */
+
+/*
+ * A list of (unique) strings
+ */
+typedef struct lint_list_s {
+    char **ll_data;		/* Strings */
+    unsigned ll_count;		/* Number of strings */
+    unsigned ll_max;		/* Allocated size of ll_data */
+} lint_list_t;
+
+/*
+ * Each input file is processed by a single worker; its messages and
+ * vocabulary are collected here and reported, in order, once all
+ * files are done.
+ */
+struct lint_gen_s;
+
+typedef struct lint_file_s {
+    const char *lf_name;	/* Name of the input file */
+    char *lf_err;		/* Buffered messages (for stderr) */
+    size_t lf_errlen;		/* Length of lf_err */
+    lint_list_t lf_vocab;	/* Field names seen (for -V/-I) */
+    lint_list_t lf_formats;	/* Format strings seen (for -F) */
+    unsigned lf_errors;		/* Count of errors */
+    unsigned lf_warnings;	/* Count of warnings */
+    unsigned lf_info;		/* Count of info messages */
+    struct lint_gen_s *lf_gen;	/* Generator state (for -G) */
+} lint_file_t;
+
+/*
+ * The state of checking one xo_emit call.  The "roles" string mimics
+ * xolint.pl's view of the field descriptor: the short role/modifier
+ * characters, with long names converted into their short forms.
+ */
+typedef struct lint_call_s {
+    lint_file_t *lc_file;	/* File being checked */
+    FILE *lc_out;		/* Where messages go */
+    const char *lc_curfile;	/* Current file name (from cpp markers) */
+    unsigned lc_line;		/* Line number of the call */
+    const char *lc_src;		/* Source text of the call (for -p) */
+    const char *lc_src_end;	/* End of lc_src */
+    unsigned lc_src_line;	/* Line number of lc_src */
+    const char *lc_fmt;		/* Format string being checked */
+    size_t lc_fmtlen;		/* Length of lc_fmt */
+} lint_call_t;
+
+typedef enum lint_level_e {
+    LINT_ERROR,
+    LINT_WARNING,
+    LINT_INFO,
+} lint_level_t;
+
+static const char *lint_level_names[] = { "error", "warning", "info" };
+
+static void
+lint_list_add (lint_list_t *llp, const char *name, size_t len)
+{
+    unsigned i;
+
+    for (i = 0; i < llp->ll_count; i++)
+	if (strncmp(llp->ll_data[i], name, len) == 0
+		&& llp->ll_data[i][len] == '\0')
+	    return;
+
+    if (llp->ll_count >= llp->ll_max) {
+	unsigned max = llp->ll_max ? llp->ll_max * 2 : 64;
+	char **newp = realloc(llp->ll_data, max * sizeof(*newp));
+	if (newp == NULL)
+	    xo_errx(1, "out of memory");
+	llp->ll_data = newp;
+	llp->ll_max = max;
+    }
+
+    llp->ll_data[llp->ll_count++] = strndup(name, len);
+}
+
+static void
+lint_list_free (lint_list_t *llp)
+{
+    unsigned i;
+
+    for (i = 0; i < llp->ll_count; i++)
+	free(llp->ll_data[i]);
+    free(llp->ll_data);
+}
+
+/*
+ * Report a message, with optional replay of the offending source lines.
+ */
+static void
+lint_report (lint_call_t *lcp, lint_level_t level, const char *fmt, ...)
+{
+    lint_file_t *lfp = lcp->lc_file;
+    va_list vap;
+
+    if (opt_vocabulary)
+	return;
+
+    switch (level) {
+    case LINT_ERROR:
+	lfp->lf_errors += 1;
+	break;
+    case LINT_WARNING:
+	lfp->lf_warnings += 1;
+	break;
+    case LINT_INFO:
+	lfp->lf_info += 1;
+	break;
+    }
+
+    fprintf(lcp->lc_out, "%s: %u: %s: ", lcp->lc_curfile, lcp->lc_line,
+	    lint_level_names[level]);
+    va_start(vap, fmt);
+    vfprintf(lcp->lc_out, fmt, vap);
+    va_end(vap);
+    fprintf(lcp->lc_out, "\n");
+
+    if (opt_print) {
+	const char *cp, *ep;
+	unsigned line = lcp->lc_src_line;
+
+	for (cp = lcp->lc_src; cp < lcp->lc_src_end; cp = ep + 1) {
+	    ep = memchr(cp, '\n', lcp->lc_src_end - cp);
+	    if (ep == NULL)
+		ep = lcp->lc_src_end;
+	    fprintf(lcp->lc_out, "%u     %.*s\n", line++, (int) (ep - cp), cp);
+	}
+	fprintf(lcp->lc_out, "\n");
+    }
+}
+
+/*
+ * libxo reports parsing problems via xo_failure; we turn them into
+ * messages, using xolint.pl's wording when there is one.
+ */
+static void
+lint_failure (void *opaque, const char *fmt, const char *msg)
+{
+    lint_call_t *lcp = opaque;
+
+    if (strncmp(fmt, "unknown keyword ignored", 23) == 0) {
+	const char *cp = strchr(msg, '\'');
+	int len = cp ? (int) strlen(cp + 1) - 1 : 0;
+
+	lint_report(lcp, LINT_ERROR, "Unknown long name for role/modifier (%.*s)",
+		    len, cp ? cp + 1 : "");
+
+    } else if (strncmp(fmt, "field descriptor uses multiple types", 36) == 0) {
+	lint_report(lcp, LINT_ERROR, "only one field role can be used");
+
+    } else if (strncmp(fmt, "missing closing '}'", 19) == 0) {
+	lint_report(lcp, LINT_ERROR, "missing closing brace");
+
+    } else {
+	/* Drop the trailing copy of the format string, if any */
+	const char *cp = strstr(fmt, ": '%s'") ? strstr(msg, ": '") : NULL;
+	int len = cp ? (int) (cp - msg) : (int) strlen(msg);
+
+	lint_report(lcp, LINT_ERROR, "%.*s", len, msg);
+    }
+}
+
+/*
+ * Build the xolint.pl-style short form of the roles and modifiers
+ * preceding the field's content.  Also return the long names, if any.
+ */
+static void
+lint_roles (const char *sp, const char *ep, char *buf, size_t bufsiz,
+	    const char **longp)
+{
+    static const struct {
+	const char *name;
+	char ch;
+    } names[] = {
+	{ "color", 'C' }, { "decoration", 'D' }, { "error", 'E' },
+	{ "label", 'L' }, { "note", 'N' }, { "padding", 'P' },
+	{ "title", 'T' }, { "units", 'U' }, { "value", 'V' },
+	{ "warning", 'W' }, { "start-anchor", '[' }, { "stop-anchor", ']' },
+	{ "colon", 'c' }, { "display", 'd' }, { "encoding", 'e' },
+	{ "hn", 'h' }, { "humanize", 'h' }, { "key", 'k' },
+	{ "leaf-list", 'l' }, { "no-quotes", 'n' }, { "quotes", 'q' },
+	{ "trim", 't' }, { "white", 'w' },
+	{ NULL, 0 }
+    };
+    char *bp = buf, *be = buf + bufsiz - 1;
+    const char *cp, *np;
+    int i;
+
+    *longp = NULL;
+
+    for (cp = sp; cp < ep && *cp != ',' && bp < be; cp++)
+	*bp++ = *cp;
+
+    if (cp < ep && *cp == ',')
+	*longp = cp;
+
+    while (cp < ep && *cp == ',') {
+	for (np = ++cp; np < ep && *np != ','; np++)
+	    continue;
+
+	for (i = 0; names[i].name; i++) {
+	    if (strncmp(names[i].name, cp, np - cp) == 0
+		    && names[i].name[np - cp] == '\0') {
+		if (bp < be)
+		    *bp++ = names[i].ch;
+		break;
+	    }
+	}
+
+	cp = np;
+    }
+
+    *bp = '\0';
+}
+
+/*
+ * Count the arguments consumed by a printf-style format, checking
+ * each conversion as we go.  Returns -1 if there's no format.
+ */
+static int
+lint_count_args (lint_call_t *lcp, const char *fmt, ssize_t flen)
+{
+    const char *cp, *ep = fmt + flen;
+    int count = 0, dots;
+
+    if (fmt == NULL || flen <= 0)
+	return -1;
+
+    for (cp = fmt; cp < ep; cp++) {
+	if (*cp != '%')
+	    continue;
+
+	if (cp + 1 < ep && cp[1] == '%') {
+	    cp += 1;
+	    continue;
+	}
+
+	for (dots = 0, cp++; cp < ep; cp++) {
+	    if (*cp == '.')
+		dots += 1;
+	    else if (*cp == '*')
+		count += 1;
+	    else if (strchr("diouxXDOUeEfFgGaAcCsSp", *cp))
+		break;
+	}
+
+	if (cp >= ep) {
+	    lint_report(lcp, LINT_ERROR, "invalid field format");
+	    break;
+	}
+
+	count += 1;
+
+	/*
+	 * Max width only valid for strings
+	 *     xo_emit("{:tag/%2.4.6d}", 55);
+	 */
+	if (dots >= 2 && *cp != 's' && *cp != 'S')
+	    lint_report(lcp, LINT_ERROR, "max width only valid for strings");
+    }
+
+    return count;
+}
+
+static int
+lint_color_name (const char *cp, size_t len)
+{
+    static const char *colors[] = {
+	"default", "black", "red", "green", "yellow",
+	"blue", "magenta", "cyan", "white", NULL
+    };
+    int i;
+
+    for (i = 0; colors[i]; i++)
+	if (strlen(colors[i]) == len && strncmp(colors[i], cp, len) == 0)
+	    return 1;
+
+    return 0;
+}
+
+static int
+lint_effect_name (const char *cp, size_t len)
+{
+    static const char *effects[] = {
+	"bold", "no-bold", "underline", "no-underline",
+	"inverse", "no-inverse", "reset", "normal", NULL
+    };
+    int i;
+
+    for (i = 0; effects[i]; i++)
+	if (strlen(effects[i]) == len && strncmp(effects[i], cp, len) == 0)
+	    return 1;
+
+    return 0;
+}
+
+static void
+lint_check_color (lint_call_t *lcp, const char *content, ssize_t clen)
+{
+    const char *cp, *ep = content + clen, *np, *sp, *tp;
+
+    for (cp = content; cp < ep; cp = np + 1) {
+	np = memchr(cp, ',', ep - cp);
+	if (np == NULL)
+	    np = ep;
+
+	for (sp = cp; sp < np && isspace((int) *sp); sp++)
+	    continue;
+	for (tp = np; tp > sp && isspace((int) tp[-1]); tp--)
+	    continue;
+
+	size_t len = tp - sp;
+
+	if (lint_color_name(sp, len)) {
+	    lint_report(lcp, LINT_ERROR,
+			"Field has color without fg- or bg- (role: C)");
+
+	} else if (len > 3 && (strncmp(sp, "fg-", 3) == 0
+			       || strncmp(sp, "bg-", 3) == 0)
+		   && lint_color_name(sp + 3, len - 3)) {
+	    /* Color */
+
+	} else if (!lint_effect_name(sp, len)) {
+	    lint_report(lcp, LINT_ERROR,
+			"Field has invalid color or effect (role: C) (%.*s)",
+			(int) len, sp);
+	}
+    }
+}
+
+static void
+lint_check_value (lint_call_t *lcp, const char *content, ssize_t clen)
+{
+    const char *cp, *ep = content + clen;
+    int upper = 0, under = 0, invalid = 0;
+
+    if (clen == 0) {
+	lint_report(lcp, LINT_ERROR, "value field must have a name (as content)");
+	return;
+    }
+
+    for (cp = content; cp < ep; cp++) {
+	if (*cp == '_')
+	    under = 1;
+	if (isupper((int) *cp))
+	    upper = 1;
+	if (!(islower((int) *cp) || isdigit((int) *cp) || *cp == '-'))
+	    invalid = 1;
+    }
+
+    if (under)
+	lint_report(lcp, LINT_ERROR,
+		    "use hyphens, not underscores, for value field name");
+
+    if (isdigit((int) *content))
+	lint_report(lcp, LINT_ERROR, "value field name cannot start with digit");
+
+    if (upper) {
+	lint_report(lcp, LINT_ERROR, "value field name should be lower case");
+	/* xolint.pl gives this message for upper case names too */
+	lint_report(lcp, LINT_ERROR,
+		    "value field name should be longer than two characters");
+    }
+
+    if (invalid)
+	lint_report(lcp, LINT_ERROR,
+		    "value field name contains invalid character (%.*s)",
+		    (int) clen, content);
+}
+
+/*
+ * Check a single field descriptor.  "last" is the last text
+ * character before the field (or NUL).
+ */
+static void
+lint_check_field (lint_call_t *lcp, xo_field_info_t *xfip, int last)
+{
+    const char *basep = xfip->xfi_start;
+    const char *fmt_end = lcp->lc_fmt + lcp->lc_fmtlen;
+    const char *rp, *longs;
+    char roles[64];
+
+    /* Find the end of the roles and modifiers */
+    for (rp = basep; *rp && *rp != ':' && *rp != '/' && *rp != '}'; rp++)
+	if (*rp == '\\' && rp[1])
+	    rp += 1;
+
+    lint_roles(basep, rp, roles, sizeof(roles), &longs);
+
+    const char *content = xfip->xfi_content;
+    ssize_t clen = content ? xfip->xfi_clen : 0;
+
+    /* The default format ("%s") doesn't live in our format string */
+    const char *format = xfip->xfi_format;
+    ssize_t flen = xfip->xfi_flen;
+    if (format < lcp->lc_fmt || format >= fmt_end)
+	format = NULL, flen = 0;
+
+    const char *encoding = xfip->xfi_encoding;
+    ssize_t elen = encoding ? xfip->xfi_elen : 0;
+
+    if (opt_vocabulary) {
+	if (clen && !strpbrk(roles, "CDEGLNPTUW[]"))
+	    lint_list_add(&lcp->lc_file->lf_vocab, content, clen);
+	return;
+    }
+
+    /*
+     * Last character before field definition is a field type
+     *     xo_emit("{T:Min} T{:Max}");
+     */
+    if (last && strchr("DELNPTUVW[]", last) && !strpbrk(roles, "DELNPTUVW[]"))
+	lint_report(lcp, LINT_INFO, "last character before field definition "
+		    "is a field type (%c)", last);
+
+    /*
+     * Encoding format uses different number of arguments
+     *     xo_emit("{:name/%6.6s %%04d/%s}", name, number);
+     */
+    int cf = lint_count_args(lcp, format, flen);
+    int ce = lint_count_args(lcp, encoding, elen);
+    if (cf >= 0 && ce >= 0 && cf != ce)
+	lint_report(lcp, LINT_WARNING, "encoding format uses different "
+		    "number of arguments (%d/%d)", cf, ce);
+
+    if (strpbrk(roles, "CDLNT")) {
+	/*
+	 * Potential missing slash after C, D, N, L, or T with format
+	 *     xo_emit("{T:%6.6s}\n", "Max");
+	 */
+	if (clen && memchr(content, '%', clen))
+	    lint_report(lcp, LINT_INFO, "potential missing slash after C, D, "
+			"N, L, or T with format");
+
+	/*
+	 * An encoding format cannot be given (roles: DNLT)
+	 *    xo_emit("{T:Max//%s}", "Max");
+	 */
+	if (elen)
+	    lint_report(lcp, LINT_ERROR, "encoding format cannot be given "
+			"when content is present");
+    }
+
+    /*
+     * Format cannot be given when content is present (roles: CDLN)
+     *    xo_emit("{N:Max/%6.6s}", "Max");
+     */
+    if (strpbrk(roles, "CDLN") && clen && flen)
+	lint_report(lcp, LINT_ERROR,
+		    "format cannot be given when content is present");
+
+    if (xfip->xfi_ftype == 'C' && clen)
+	lint_check_color(lcp, content, clen);
+
+    /*
+     * Field has humanize modifier but no format string
+     *   xo_emit("{h:value}", value);
+     */
+    if ((xfip->xfi_flags & XFF_HUMANIZE) && flen == 0)
+	lint_report(lcp, LINT_ERROR,
+		    "Field has humanize modifier but no format string");
+
+    /*
+     * Field has hn-* modifier but not 'h' modifier
+     *   xo_emit("{,hn-1000:value}", value);
+     */
+    if (!(xfip->xfi_flags & XFF_HUMANIZE) && longs && strstr(longs, ",hn-")
+	    && strstr(longs, ",hn-") < rp)
+	lint_report(lcp, LINT_ERROR,
+		    "Field has hn-* modifier but not 'h' modifier");
+
+    /*
+     * Names for argument fields ('a') are passed at run time, and
+     * display-only fields ('d') don't need one.
+     */
+    if (xfip->xfi_ftype == 'V' && !(xfip->xfi_flags & XFF_ARGUMENT)
+	    && (clen || !(xfip->xfi_flags & XFF_DISPLAY_ONLY)))
+	lint_check_value(lcp, content, clen);
+
+    /*
+     * Decoration field contains invalid character
+     *     xo_emit("{D:not good}");
+     */
+    if (xfip->xfi_ftype == 'D') {
+	const char *cp;
+	int bad = (clen == 0);
+
+	for (cp = content; cp && cp < content + clen; cp++)
+	    if (!strchr("~!@#$%^&*();:[]{} ", *cp))
+		bad = 1;
+
+	if (bad)
+	    lint_report(lcp, LINT_WARNING,
+			"decoration field contains invalid character");
+    }
+
+    if (xfip->xfi_ftype == '[' || xfip->xfi_ftype == ']') {
+	/*
+	 * Anchor content should be decimal width
+	 *     xo_emit("{[:mumble}");
+	 */
+	if (clen) {
+	    const char *cp = content, *ep = content + clen;
+
+	    if (*cp == '-')
+		cp += 1;
+	    if (cp == ep)
+		cp = NULL;
+	    for (; cp && cp < ep; cp++)
+		if (!isdigit((int) *cp))
+		    break;
+	    if (cp != ep)
+		lint_report(lcp, LINT_ERROR,
+			    "anchor content should be decimal width");
+	}
+
+	/*
+	 * Anchor format should be "%d"
+	 *     xo_emit("{[:/%s}");
+	 */
+	if (flen && (flen != 2 || strncmp(format, "%d", 2) != 0))
+	    lint_report(lcp, LINT_ERROR, "anchor format should be \"%%d\"");
+
+	/*
+	 * Anchor cannot have both format and encoding format
+	 *     xo_emit("{[:32/%d}");
+	 */
+	if (clen && flen)
+	    lint_report(lcp, LINT_ERROR,
+			"anchor cannot have both format and encoding format");
+    }
+}
+
+/*
+ * Check a complete format string, using libxo's parser.
+ */
+static void
+lint_check_format (xo_handle_t *xop, lint_call_t *lcp)
+{
+    const char *fmt = lcp->lc_fmt;
+    int last = 0;
+
+    unsigned max_fields = xo_count_fields(xop, fmt);
+    xo_field_info_t *fields = calloc(max_fields + 1, sizeof(*fields));
+    if (fields == NULL)
+	xo_errx(1, "out of memory");
+
+    xo_set_failure_func(xop, lint_failure, lcp);
+
+    if (xo_parse_fields(xop, fields, max_fields, fmt) == 0) {
+	xo_field_info_t *xfip;
+
+	for (xfip = fields; xfip->xfi_ftype; xfip++) {
+	    switch (xfip->xfi_ftype) {
+	    case XO_ROLE_TEXT:
+		/*
+		 * A percent sign appearing in text is a literal
+		 *     xo_emit("cost: %d", cost);
+		 */
+		if (!opt_vocabulary
+			&& memchr(xfip->xfi_content, '%', xfip->xfi_clen))
+		    lint_report(lcp, LINT_INFO,
+				"a percent sign appearing in text is a literal");
+		if (xfip->xfi_clen)
+		    last = xfip->xfi_content[xfip->xfi_clen - 1];
+		break;
+
+	    case XO_ROLE_NEWLINE:
+		last = '\n';
+		break;
+
+	    case XO_ROLE_EBRACE:
+		last = '}';
+		break;
+
+	    default:
+		lint_check_field(lcp, xfip, last);
+		last = 0;
+	    }
+	}
+    }
+
+    xo_set_failure_func(xop, NULL, NULL);
+    free(fields);
+}
+
+/*
+ * The xo_emit family, and which argument holds the format string.
+ * For -G, we also need the argument holding the handle (or
+ * LINT_NO_HANDLE), and functions we can't replace are marked
+ * LINT_NO_GEN.
+ */
+#define LINT_NO_HANDLE	-1	/* Uses the default handle */
+#define LINT_NO_GEN	-2	/* Can't be replaced by generated code */
+
+static const struct {
+    const char *name;
+    int argnum;
+    int handle;
+} lint_funcs[] = {
+    { "xo_emit", 0, LINT_NO_HANDLE },
+    { "xo_emit_h", 1, 0 },
+    { "xo_emit_hv", 1, LINT_NO_GEN },
+    { "xo_emit_f", 1, LINT_NO_HANDLE },
+    { "xo_emit_hf", 2, 0 },
+    { "xo_emit_hvf", 2, LINT_NO_GEN },
+    { "xo_emit_warn", 0, LINT_NO_GEN },
+    { "xo_emit_warnx", 0, LINT_NO_GEN },
+    { "xo_emit_err", 1, LINT_NO_GEN },
+    { "xo_emit_errx", 1, LINT_NO_GEN },
+    { "xo_emit_errc", 2, LINT_NO_GEN },
+    { "xo_emit_warn_c", 1, LINT_NO_GEN },
+    { "xo_emit_warn_hc", 2, LINT_NO_GEN },
+    { NULL, 0, 0 }
+};
+
+/*
+ * Tokenizer state for one input buffer.
+ */
+typedef struct lint_input_s {
+    const char *li_cp;		/* Current position */
+    const char *li_ep;		/* End of input */
+    unsigned li_line;		/* Current line number */
+    const char *li_curfile;	/* Current file name (from cpp markers) */
+    char *li_curfile_buf;	/* Allocated file name */
+} lint_input_t;
+
+static int
+lint_at_line_start (lint_input_t *lip, const char *base)
+{
+    return lip->li_cp == base || lip->li_cp[-1] == '\n';
+}
+
+/*
+ * Skip a preprocessor line, handling line markers ("# 12 "file.c"")
+ * that cpp leaves behind.
+ */
+static void
+lint_skip_directive (lint_input_t *lip)
+{
+    const char *cp = lip->li_cp + 1, *ep = lip->li_ep;
+    unsigned num = 0;
+    int have_num = 0;
+
+    while (cp < ep && (*cp == ' ' || *cp == '\t'))
+	cp += 1;
+    if (cp + 4 < ep && strncmp(cp, "line", 4) == 0)
+	for (cp += 4; cp < ep && (*cp == ' ' || *cp == '\t'); cp++)
+	    continue;
+    for (; cp < ep && isdigit((int) *cp); cp++, have_num = 1)
+	num = num * 10 + (*cp - '0');
+
+    if (have_num) {
+	while (cp < ep && (*cp == ' ' || *cp == '\t'))
+	    cp += 1;
+	if (cp < ep && *cp == '"') {
+	    const char *sp = ++cp;
+	    while (cp < ep && *cp != '"' && *cp != '\n')
+		cp += 1;
+	    free(lip->li_curfile_buf);
+	    lip->li_curfile = lip->li_curfile_buf = strndup(sp, cp - sp);
+	}
+    }
+
+    /* Skip to the end of the line, honoring continuations */
+    for (cp = lip->li_cp; cp < ep; cp++) {
+	if (*cp == '\\' && cp + 1 < ep && cp[1] == '\n') {
+	    cp += 1;
+	    lip->li_line += 1;
+	} else if (*cp == '\n')
+	    break;
+    }
+
+    lip->li_cp = cp;
+
+    /* The marker gives the number of the _next_ line */
+    if (have_num)
+	lip->li_line = num - 1;
+}
+
+/*
+ * Skip over a quoted string or character constant, returning the
+ * end of it (after the closing quote).
+ */
+static const char *
+lint_skip_quoted (lint_input_t *lip, const char *cp)
+{
+    const char *ep = lip->li_ep;
+    char quote = *cp++;
+
+    for (; cp < ep; cp++) {
+	if (*cp == '\\' && cp + 1 < ep) {
+	    if (cp[1] == '\n')
+		lip->li_line += 1;
+	    cp += 1;
+	} else if (*cp == quote)
+	    return cp + 1;
+	else if (*cp == '\n') {
+	    lip->li_line += 1;
+	    return cp;		/* Unterminated; give up */
+	}
+    }
+
+    return ep;
+}
+
+/*
+ * Skip whitespace and comments, counting newlines.
+ */
+static const char *
+lint_skip_space (lint_input_t *lip, const char *cp)
+{
+    const char *ep = lip->li_ep;
+
+    while (cp < ep) {
+	if (*cp == '\n') {
+	    lip->li_line += 1;
+	    cp += 1;
+	} else if (isspace((int) *cp)) {
+	    cp += 1;
+	} else if (*cp == '/' && cp + 1 < ep && cp[1] == '*') {
+	    for (cp += 2; cp < ep; cp++) {
+		if (*cp == '\n')
+		    lip->li_line += 1;
+		else if (*cp == '*' && cp + 1 < ep && cp[1] == '/') {
+		    cp += 2;
+		    break;
+		}
+	    }
+	} else if (*cp == '/' && cp + 1 < ep && cp[1] == '/') {
+	    while (cp < ep && *cp != '\n')
+		cp += 1;
+	} else
+	    break;
+    }
+
+    return cp;
+}
+
+/*
+ * A simple growable buffer, always NUL terminated
+ */
+typedef struct lint_buf_s {
+    char *lb_data;		/* Contents */
+    size_t lb_len;		/* Length of lb_data */
+    size_t lb_size;		/* Allocated size */
+} lint_buf_t;
+
+static void
+lint_buf_append (lint_buf_t *lbp, const char *data, size_t len)
+{
+    if (lbp->lb_len + len + 1 > lbp->lb_size) {
+	size_t size = lbp->lb_size ? lbp->lb_size : 256;
+	while (lbp->lb_len + len + 1 > size)
+	    size *= 2;
+
+	char *newp = realloc(lbp->lb_data, size);
+	if (newp == NULL)
+	    xo_errx(1, "out of memory");
+	lbp->lb_data = newp;
+	lbp->lb_size = size;
+    }
+
+    memcpy(lbp->lb_data + lbp->lb_len, data, len);
+    lbp->lb_len += len;
+    lbp->lb_data[lbp->lb_len] = '\0';
+}
+
+/*
+ * Append the value of a C string literal (after the opening quote)
+ * to the buffer, handling escapes.  Returns the end of the literal.
+ */
+static const char *
+lint_append_literal (lint_input_t *lip, const char *cp, lint_buf_t *lbp)
+{
+    const char *ep = lip->li_ep;
+    char ch;
+
+    for (; cp < ep && *cp != '"'; cp++) {
+	ch = *cp;
+
+	if (ch == '\n') {
+	    lip->li_line += 1;
+	    break;
+	}
+
+	if (ch == '\\' && cp + 1 < ep) {
+	    ch = *++cp;
+	    switch (ch) {
+	    case 'n': ch = '\n'; break;
+	    case 't': ch = '\t'; break;
+	    case 'r': ch = '\r'; break;
+	    case 'a': ch = '\a'; break;
+	    case 'b': ch = '\b'; break;
+	    case 'f': ch = '\f'; break;
+	    case 'v': ch = '\v'; break;
+	    case '\n':
+		lip->li_line += 1;
+		continue;
+
+	    case 'x':
+		for (ch = 0; cp + 1 < ep && isxdigit((int) cp[1]); cp++)
+		    ch = ch * 16 + (isdigit((int) cp[1]) ? cp[1] - '0'
+				    : tolower((int) cp[1]) - 'a' + 10);
+		break;
+
+	    case '0': case '1': case '2': case '3':
+	    case '4': case '5': case '6': case '7': {
+		int i;
+		for (ch -= '0', i = 1; i < 3 && cp + 1 < ep
+			 && cp[1] >= '0' && cp[1] <= '7'; i++, cp++)
+		    ch = ch * 8 + (cp[1] - '0');
+		break;
+	    }
+	    }
+	}
+
+	lint_buf_append(lbp, &ch, 1);
+    }
+
+    return (cp < ep && *cp == '"') ? cp + 1 : cp;
+}
+
+/*
+ * Where the arguments of a call are found in the source (for -G)
+ */
+#define LINT_MAX_ARGS	4	/* We only need to know the first few */
+
+typedef struct lint_args_s {
+    const char *la_start[LINT_MAX_ARGS]; /* Start of each argument */
+    const char *la_end[LINT_MAX_ARGS]; /* End (the ',' or ')') */
+    int la_macro;		/* Format uses <inttypes.h> macros */
+} lint_args_t;
+
+/*
+ * Parse the arguments of an xo_emit call, starting just after the
+ * open paren.  If argument "argnum" is entirely made of string
+ * literals, the concatenated value is returned in "value" and the
+ * source spelling (literals and macros, without whitespace) in
+ * "raw".  Returns the position after the closing paren.
+ */
+static const char *
+lint_parse_call (lint_input_t *lip, const char *cp, int argnum,
+		 lint_buf_t *value, lint_buf_t *raw, int *literalp,
+		 lint_args_t *args)
+{
+    const char *ep = lip->li_ep, *sp;
+    int depth = 0, arg = 0, literal = 1, seen = 0;
+
+    bzero(args, sizeof(*args));
+
+    while (cp < ep) {
+	cp = lint_skip_space(lip, cp);
+	if (cp >= ep)
+	    break;
+
+	if (arg < LINT_MAX_ARGS && args->la_start[arg] == NULL)
+	    args->la_start[arg] = cp;
+
+	if (*cp == '"') {
+	    if (arg == argnum && depth == 0) {
+		sp = cp;
+		cp = lint_append_literal(lip, cp + 1, value);
+		if (raw->lb_len)
+		    lint_buf_append(raw, " ", 1);
+		lint_buf_append(raw, sp, cp - sp);
+		seen = 1;
+	    } else
+		cp = lint_skip_quoted(lip, cp);
+	    continue;
+	}
+
+	if (*cp == '\'') {
+	    cp = lint_skip_quoted(lip, cp);
+	    if (arg == argnum)
+		literal = 0;
+	    continue;
+	}
+
+	if (*cp == '(' || *cp == '[' || *cp == '{') {
+	    depth += 1;
+	    if (arg == argnum)
+		literal = 0;
+	    cp += 1;
+	    continue;
+	}
+
+	if (*cp == ')' || *cp == ']' || *cp == '}') {
+	    cp += 1;
+	    if (depth-- == 0) {
+		if (arg < LINT_MAX_ARGS)
+		    args->la_end[arg] = cp - 1;
+		break;
+	    }
+	    continue;
+	}
+
+	if (*cp == ',' && depth == 0) {
+	    if (arg < LINT_MAX_ARGS)
+		args->la_end[arg] = cp;
+	    arg += 1;
+	    cp += 1;
+	    continue;
+	}
+
+	if (*cp == ';' && depth == 0)
+	    break;		/* Runaway call; give up */
+
+	if (arg == argnum && depth == 0) {
+	    /*
+	     * The <inttypes.h> macros are common in format strings; we
+	     * handle them as "ll" plus the conversion character.
+	     */
+	    if (strncmp(cp, "PRI", 3) == 0 && cp + 3 < ep
+		    && strchr("diouxX", cp[3])) {
+		char conv[3] = { 'l', 'l', cp[3] };
+
+		for (sp = cp, cp += 4; cp < ep && (isalnum((int) *cp)
+						   || *cp == '_'); cp++)
+		    continue;
+
+		lint_buf_append(value, conv, sizeof(conv));
+		args->la_macro = 1;
+		if (raw->lb_len)
+		    lint_buf_append(raw, " ", 1);
+		lint_buf_append(raw, sp, cp - sp);
+		continue;
+	    }
+
+	    literal = 0;
+	}
+
+	cp += 1;
+    }
+
+    *literalp = literal && seen;
+    return cp;
+}
+
+/*
+ * State for generating compiled emit functions (-G).  The generated
+ * functions are collected in lg_funcs, and the rewritten source,
+ * with calls replaced by calls to the generated functions, in lg_src.
+ */
+typedef struct lint_gen_s {
+    FILE *lg_funcs;		/* Generated functions */
+    char *lg_funcs_buf;		/* Buffer for lg_funcs */
+    size_t lg_funcs_len;	/* Length of lg_funcs_buf */
+    FILE *lg_src;		/* Rewritten source */
+    char *lg_src_buf;		/* Buffer for lg_src */
+    size_t lg_src_len;		/* Length of lg_src_buf */
+    lint_list_t lg_formats;	/* Formats we've generated (by number) */
+    unsigned lg_compiled;	/* Number of compiled functions */
+    unsigned lg_fallback;	/* Number of interpreted functions */
+    int lg_failed;		/* Saw a bad format string */
+} lint_gen_t;
+
+#define LINT_GEN_MAX_ARGS	64 /* Max arguments for one format string */
+
+/*
+ * Find the C types of the arguments consumed by a printf-style
+ * format, appending them to "types".  Returns -1 for conversions
+ * we don't know.
+ */
+static int
+lint_gen_types (lint_call_t *lcp, const char *fmt, ssize_t flen,
+		const char **types, unsigned *countp)
+{
+    const char *cp, *ep = fmt + flen;
+    const char *type;
+    char lmod[3];
+    int lcount;
+
+    for (cp = fmt; cp < ep; cp++) {
+	if (*cp != '%')
+	    continue;
+
+	if (++cp < ep && *cp == '%')
+	    continue;
+
+	/* Flags, widths, and precisions; each '*' is an int */
+	for (; cp < ep && strchr("-+ #0'.123456789*", *cp); cp++) {
+	    if (*cp == '*') {
+		if (*countp >= LINT_GEN_MAX_ARGS)
+		    return -1;
+		types[(*countp)++] = "int";
+	    }
+	}
+
+	for (lcount = 0; cp < ep && strchr("hlLqjtz", *cp); cp++)
+	    if (lcount < 2)
+		lmod[lcount++] = *cp;
+	lmod[lcount] = '\0';
+
+	if (cp >= ep)
+	    goto bad;
+
+	int lng = (lmod[0] == 'l' && lmod[1] == '\0');
+	int llng = (strcmp(lmod, "ll") == 0 || lmod[0] == 'q');
+
+	switch (*cp) {
+	case 'd':
+	case 'i':
+	    type = llng ? "long long" : lng ? "long"
+		: lmod[0] == 'j' ? "intmax_t" : lmod[0] == 't' ? "ptrdiff_t"
+		: lmod[0] == 'z' ? "ssize_t" : "int";
+	    break;
+
+	case 'o':
+	case 'u':
+	case 'x':
+	case 'X':
+	    type = llng ? "unsigned long long" : lng ? "unsigned long"
+		: lmod[0] == 'j' ? "uintmax_t" : lmod[0] == 't' ? "ptrdiff_t"
+		: lmod[0] == 'z' ? "size_t" : "unsigned";
+	    break;
+
+	case 'D':
+	    type = "long";
+	    break;
+
+	case 'O':
+	case 'U':
+	    type = "unsigned long";
+	    break;
+
+	case 'e': case 'E': case 'f': case 'F':
+	case 'g': case 'G': case 'a': case 'A':
+	    type = (lmod[0] == 'L') ? "long double" : "double";
+	    break;
+
+	case 'c':
+	case 'C':
+	    type = "int";
+	    break;
+
+	case 's':
+	    type = lng ? "const wchar_t *" : "const char *";
+	    break;
+
+	case 'S':
+	    type = "const wchar_t *";
+	    break;
+
+	case 'p':
+	    type = "const void *";
+	    break;
+
+	case 'm':
+	    continue;		/* strerror(errno); no argument */
+
+	default:
+	    goto bad;
+	}
+
+	if (*countp >= LINT_GEN_MAX_ARGS)
+	    return -1;
+	types[(*countp)++] = type;
+    }
+
+    return 0;
+
+ bad:
+    lint_report(lcp, LINT_ERROR, "unsupported conversion in format: '%.*s'",
+		(int) flen, fmt);
+    return -1;
+}
+
+static unsigned
+lint_gen_offset (const char *fmt, size_t len, const char *ptr)
+{
+    if (ptr == NULL)
+	return XO_COMPILED_NONE;
+    if (ptr < fmt || ptr > fmt + len)
+	return XO_COMPILED_DEFAULT;
+    return ptr - fmt;
+}
+
+static void
+lint_gen_offset_print (FILE *fp, const char *fmt, size_t len, const char *ptr)
+{
+    unsigned off = lint_gen_offset(fmt, len, ptr);
+
+    if (off == XO_COMPILED_NONE)
+	fprintf(fp, ", XO_COMPILED_NONE");
+    else if (off == XO_COMPILED_DEFAULT)
+	fprintf(fp, ", XO_COMPILED_DEFAULT");
+    else
+	fprintf(fp, ", %u", off);
+}
+
+/*
+ * Generate a function for the format string, returning its number,
+ * or -1 if the format can't be used.  Formats with gettext features,
+ * field numbers, or <inttypes.h> macros (whose offsets aren't known
+ * until compile time) are handed to the interpreter (with XOEF_RETAIN);
+ * the rest are emitted with a compiled field table.
+ */
+static int
+lint_gen_function (xo_handle_t *xop, lint_gen_t *lgp, lint_call_t *lcp,
+		   const char *raw, int macro)
+{
+    const char *fmt = lcp->lc_fmt;
+    size_t len = lcp->lc_fmtlen;
+    const char *types[LINT_GEN_MAX_ARGS];
+    unsigned ntypes = 0, num, i;
+    xo_field_info_t *xfip;
+    int fallback = macro, rc = -1;
+
+    /* Same format, same function */
+    for (num = 0; num < lgp->lg_formats.ll_count; num++)
+	if (strcmp(lgp->lg_formats.ll_data[num], raw) == 0)
+	    return num + 1;
+
+    unsigned max_fields = xo_count_fields(xop, fmt);
+    xo_field_info_t *fields = calloc(max_fields + 1, sizeof(*fields));
+    if (fields == NULL)
+	xo_errx(1, "out of memory");
+
+    xo_set_failure_func(xop, lint_failure, lcp);
+
+    if (xo_parse_fields(xop, fields, max_fields, fmt) != 0)
+	goto done;
+
+    for (xfip = fields; xfip->xfi_ftype; xfip++) {
+	switch (xfip->xfi_ftype) {
+	case XO_ROLE_TEXT:
+	case XO_ROLE_NEWLINE:
+	case XO_ROLE_EBRACE:
+	    continue;
+
+	case 'G':
+	    fallback = 1;
+	    continue;
+	}
+
+	if ((xfip->xfi_flags & XFF_GT_FLAGS) || xfip->xfi_fnum)
+	    fallback = 1;
+
+	if (xfip->xfi_flags & XFF_ARGUMENT) {
+	    if (ntypes >= LINT_GEN_MAX_ARGS)
+		goto done;
+	    types[ntypes++] = "const char *";
+	}
+
+	/* Other roles ignore their format when they have content */
+	if (xfip->xfi_format == NULL || (xfip->xfi_ftype != 'V'
+		&& ((xfip->xfi_clen && xfip->xfi_content)
+		    || (xfip->xfi_flags & XFF_ARGUMENT))))
+	    continue;
+
+	if (lint_gen_types(lcp, xfip->xfi_format, xfip->xfi_flen,
+			   types, &ntypes) < 0)
+	    goto done;
+    }
+
+    lint_list_add(&lgp->lg_formats, raw, strlen(raw));
+    num = lgp->lg_formats.ll_count;
+
+    FILE *fp = lgp->lg_funcs;
+
+    if (!fallback) {
+	fprintf(fp, "static const xo_compiled_field_t xo_gen_fields_%u[] = {\n",
+		num);
+	for (xfip = fields; xfip->xfi_ftype; xfip++) {
+	    if (xfip->xfi_ftype == '\n')
+		fprintf(fp, "    { '\\n'");
+	    else
+		fprintf(fp, "    { '%c'", xfip->xfi_ftype);
+
+	    fprintf(fp, ", %#lx, %u, %u", (unsigned long) xfip->xfi_flags,
+		    xfip->xfi_fnum, xfip->xfi_renum);
+	    lint_gen_offset_print(fp, fmt, len, xfip->xfi_start);
+	    fprintf(fp, ", %ld", (long) xfip->xfi_len);
+	    lint_gen_offset_print(fp, fmt, len, xfip->xfi_content);
+	    fprintf(fp, ", %ld", (long) xfip->xfi_clen);
+	    lint_gen_offset_print(fp, fmt, len, xfip->xfi_format);
+	    fprintf(fp, ", %ld", (long) xfip->xfi_flen);
+	    lint_gen_offset_print(fp, fmt, len, xfip->xfi_encoding);
+	    fprintf(fp, ", %ld", (long) xfip->xfi_elen);
+	    lint_gen_offset_print(fp, fmt, len, xfip->xfi_next);
+	    fprintf(fp, " },\n");
+	}
+	fprintf(fp, "    { 0 }\n};\n\n");
+
+	fprintf(fp, "static const xo_compiled_t xo_gen_format_%u = {\n"
+		"    XO_COMPILED_VERSION,\n    %s,\n    %u, xo_gen_fields_%u\n"
+		"};\n\n", num, raw, max_fields, num);
+	lgp->lg_compiled += 1;
+    } else
+	lgp->lg_fallback += 1;
+
+    fprintf(fp, "static xo_ssize_t\nxo_gen_emit_%u (xo_handle_t *xop", num);
+    for (i = 0; i < ntypes; i++)
+	fprintf(fp, ", %s%sa%u", types[i],
+		types[i][strlen(types[i]) - 1] == '*' ? "" : " ", i + 1);
+    fprintf(fp, ")\n{\n");
+
+    if (fallback)
+	fprintf(fp, "    return xo_emit_hf(xop, XOEF_RETAIN, %s", raw);
+    else
+	fprintf(fp, "    return xo_emit_compiled_h(xop, &xo_gen_format_%u", num);
+
+    for (i = 0; i < ntypes; i++)
+	fprintf(fp, ", a%u", i + 1);
+    fprintf(fp, ");\n}\n\n");
+
+    rc = num;
+
+ done:
+    xo_set_failure_func(xop, NULL, NULL);
+    free(fields);
+    if (rc < 0)
+	lgp->lg_failed = 1;
+    return rc;
+}
+
+/*
+ * Replace a call with a call to a generated function.  "copied" is
+ * where we've copied the source up to; "name" is the start of the
+ * called function's name.  Newlines in the replaced text are kept,
+ * so line numbers don't change.
+ */
+static void
+lint_gen_rewrite (lint_gen_t *lgp, const char *copied, const char *name,
+		  int num, int handle, int argnum, lint_args_t *args)
+{
+    FILE *fp = lgp->lg_src;
+    const char *cp, *hp = NULL, *he = NULL;
+    const char *fe = args->la_end[argnum]; /* The ',' or ')' after format */
+
+    fwrite(copied, 1, name - copied, fp);
+
+    fprintf(fp, "xo_gen_emit_%u(", num);
+    if (handle >= 0) {
+	hp = args->la_start[handle];
+	he = args->la_end[handle];
+	while (he > hp && isspace((int) he[-1]))
+	    he -= 1;
+	fwrite(hp, 1, he - hp, fp);
+    } else
+	fprintf(fp, "NULL");
+
+    for (cp = name; cp < fe; cp++)
+	if (*cp == '\n' && !(cp >= hp && cp < he))
+	    fputc('\n', fp);
+}
+
+static int
+lint_is_ident (int ch)
+{
+    return isalnum(ch) || ch == '_';
+}
+
+/*
+ * Scan a buffer for calls to the xo_emit family, checking the
+ * literal format strings we find.
+ */
+static void
+lint_scan (xo_handle_t *xop, lint_file_t *lfp, FILE *out,
+	   const char *base, size_t len, lint_gen_t *lgp)
+{
+    lint_input_t input = {
+	.li_cp = base, .li_ep = base + len, .li_line = 1,
+	.li_curfile = lfp->lf_name,
+    };
+    lint_input_t *lip = &input;
+    const char *cp, *ep = base + len, *np;
+    const char *copied = base;	/* For -G: source copied so far */
+    lint_buf_t value, raw;
+    lint_args_t args;
+    int i, literal;
+
+    while (lip->li_cp < ep) {
+	cp = lip->li_cp;
+
+	if (*cp == '#' && lint_at_line_start(lip, base)) {
+	    lint_skip_directive(lip);
+	    continue;
+	}
+
+	if (*cp == '"' || *cp == '\'') {
+	    lip->li_cp = lint_skip_quoted(lip, cp);
+	    continue;
+	}
+
+	if (*cp == '/' || isspace((int) *cp)) {
+	    np = lint_skip_space(lip, cp);
+	    lip->li_cp = (np == cp) ? cp + 1 : np;
+	    continue;
+	}
+
+	if (!lint_is_ident(*cp)) {
+	    lip->li_cp += 1;
+	    continue;
+	}
+
+	/* Find the whole identifier */
+	for (np = cp; np < ep && lint_is_ident(*np); np++)
+	    continue;
+	lip->li_cp = np;
+
+	if (np - cp < 7 || strncmp(cp, "xo_emit", 7) != 0
+		|| (cp > base && lint_is_ident(cp[-1])))
+	    continue;
+
+	for (i = 0; lint_funcs[i].name; i++)
+	    if (strlen(lint_funcs[i].name) == (size_t) (np - cp)
+		    && strncmp(lint_funcs[i].name, cp, np - cp) == 0)
+		break;
+	if (lint_funcs[i].name == NULL)
+	    continue;
+
+	const char *start_line = cp;
+	while (start_line > base && start_line[-1] != '\n')
+	    start_line -= 1;
+	unsigned src_line = lip->li_line;
+
+	np = lint_skip_space(lip, np);
+	if (np >= ep || *np != '(') {
+	    lip->li_cp = np;
+	    continue;
+	}
+
+	bzero(&value, sizeof(value));
+	bzero(&raw, sizeof(raw));
+
+	np = lint_parse_call(lip, np + 1, lint_funcs[i].argnum,
+			     &value, &raw, &literal, &args);
+	lip->li_cp = np;
+
+	if (lgp) {
+	    int argnum = lint_funcs[i].argnum;
+
+	    if (literal && lint_funcs[i].handle != LINT_NO_GEN
+		    && argnum < LINT_MAX_ARGS && args.la_end[argnum]) {
+		lint_call_t call = {
+		    .lc_file = lfp,
+		    .lc_out = out,
+		    .lc_curfile = lip->li_curfile,
+		    .lc_line = lip->li_line,
+		    .lc_src = start_line,
+		    .lc_src_end = memchr(np, '\n', ep - np) ?: ep,
+		    .lc_src_line = src_line,
+		    .lc_fmt = value.lb_data,
+		    .lc_fmtlen = value.lb_len,
+		};
+		int num = lint_gen_function(xop, lgp, &call, raw.lb_data,
+					    args.la_macro);
+		if (num > 0) {
+		    lint_gen_rewrite(lgp, copied, cp, num,
+				     lint_funcs[i].handle, argnum, &args);
+		    copied = args.la_end[argnum];
+		}
+	    }
+
+	} else if (literal && opt_formats) {
+	    lint_list_add(&lfp->lf_formats, raw.lb_data, raw.lb_len);
+
+	} else if (literal) {
+	    const char *end_line = memchr(np, '\n', ep - np);
+	    lint_call_t call = {
+		.lc_file = lfp,
+		.lc_out = out,
+		.lc_curfile = lip->li_curfile,
+		.lc_line = lip->li_line,
+		.lc_src = start_line,
+		.lc_src_end = end_line ? end_line : ep,
+		.lc_src_line = src_line,
+		.lc_fmt = value.lb_data,
+		.lc_fmtlen = value.lb_len,
+	    };
+
+	    lint_check_format(xop, &call);
+	}
+
+	free(value.lb_data);
+	free(raw.lb_data);
+    }
+
+    if (lgp)
+	fwrite(copied, 1, ep - copied, lgp->lg_src);
+
+    free(lip->li_curfile_buf);
+}
+
+/*
+ * Read a file via cpp (-c), returning an allocated buffer.
+ */
+static char *
+lint_read_cpp (const char *name, size_t *lenp)
+{
+    char *cmd, *buf = NULL;
+    size_t len = 0, size = 0, rc;
+    FILE *fp;
+
+    if (access(name, R_OK) != 0)
+	return NULL;
+
+    if (asprintf(&cmd, "cpp %s '%s'", opt_cflags ?: "", name) < 0)
+	xo_errx(1, "out of memory");
+
+    fp = popen(cmd, "r");
+    free(cmd);
+    if (fp == NULL)
+	return NULL;
+
+    for (;;) {
+	if (len + BUFSIZ > size) {
+	    size = size ? size * 2 : BUFSIZ * 4;
+	    buf = realloc(buf, size);
+	    if (buf == NULL)
+		xo_errx(1, "out of memory");
+	}
+
+	rc = fread(buf + len, 1, size - len, fp);
+	if (rc == 0)
+	    break;
+	len += rc;
+    }
+
+    pclose(fp);
+    *lenp = len;
+    return buf;
+}
+
+/*
+ * Check one input file.  Messages are collected in memory, so that
+ * files processed in parallel are reported in order.
+ */
+static void
+lint_file (xo_handle_t *xop, lint_file_t *lfp)
+{
+    FILE *out = open_memstream(&lfp->lf_err, &lfp->lf_errlen);
+    if (out == NULL)
+	xo_err(1, "could not open output buffer");
+
+    if (opt_cpp) {
+	size_t len = 0;
+	char *buf = lint_read_cpp(lfp->lf_name, &len);
+
+	if (buf == NULL)
+	    fprintf(out, "%s: no such file\n", lfp->lf_name);
+	else
+	    lint_scan(xop, lfp, out, buf, len, lfp->lf_gen);
+	free(buf);
+
+    } else {
+	int fd = open(lfp->lf_name, O_RDONLY);
+	struct stat st;
+
+	if (fd < 0 || fstat(fd, &st) < 0) {
+	    fprintf(out, "%s: cannot open input file\n", lfp->lf_name);
+	} else if (st.st_size > 0) {
+	    void *base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	    if (base == MAP_FAILED) {
+		fprintf(out, "%s: cannot map input file\n", lfp->lf_name);
+	    } else {
+		lint_scan(xop, lfp, out, base, st.st_size, lfp->lf_gen);
+		munmap(base, st.st_size);
+	    }
+	}
+
+	if (fd >= 0)
+	    close(fd);
+    }
+
+    fclose(out);
+}
+
+#ifdef HAVE_PTHREAD_H
+static lint_file_t *lint_files;	/* Files for our workers */
+static int lint_files_count;	/* Number of files */
+static int lint_files_next;	/* Next file to be processed */
+static pthread_mutex_t lint_files_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void *
+lint_worker (void *arg UNUSED)
+{
+    xo_handle_t *xop = xo_create(XO_STYLE_TEXT, XOF_WARN);
+    int i;
+
+    for (;;) {
+	pthread_mutex_lock(&lint_files_mutex);
+	i = lint_files_next++;
+	pthread_mutex_unlock(&lint_files_mutex);
+
+	if (i >= lint_files_count)
+	    break;
+
+	lint_file(xop, &lint_files[i]);
+    }
+
+    xo_destroy(xop);
+    return NULL;
+}
+#endif /* HAVE_PTHREAD_H */
+
+static void
+lint_all (lint_file_t *files, int count)
+{
+    int i;
+
+#ifdef HAVE_PTHREAD_H
+    int jobs = (opt_jobs < count) ? opt_jobs : count;
+
+    if (jobs > 1) {
+	pthread_t *tids = calloc(jobs, sizeof(*tids));
+	if (tids == NULL)
+	    xo_errx(1, "out of memory");
+
+	lint_files = files;
+	lint_files_count = count;
+	lint_files_next = 0;
+
+	for (i = 0; i < jobs; i++)
+	    if (pthread_create(&tids[i], NULL, lint_worker, NULL) != 0)
+		xo_errx(1, "could not create worker thread");
+
+	for (i = 0; i < jobs; i++)
+	    pthread_join(tids[i], NULL);
+
+	free(tids);
+	return;
+    }
+#endif /* HAVE_PTHREAD_H */
+
+    xo_handle_t *xop = xo_create(XO_STYLE_TEXT, XOF_WARN);
+
+    for (i = 0; i < count; i++)
+	lint_file(xop, &files[i]);
+
+    xo_destroy(xop);
+}
+
+static int
+lint_strcmp (const void *a, const void *b)
+{
+    return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+/*
+ * Merge one list from all files, returning it sorted and without
+ * duplicates.  The strings are owned by the files' lists.
+ */
+static char **
+lint_merge (lint_file_t *files, int count, size_t offset, unsigned *nump)
+{
+    unsigned total = 0, n = 0, i;
+    lint_list_t *llp;
+    char **all;
+    int f;
+
+    for (f = 0; f < count; f++) {
+	llp = (lint_list_t *) ((char *) &files[f] + offset);
+	total += llp->ll_count;
+    }
+
+    all = calloc(total + 1, sizeof(*all));
+    if (all == NULL)
+	xo_errx(1, "out of memory");
+
+    for (f = 0; f < count; f++) {
+	llp = (lint_list_t *) ((char *) &files[f] + offset);
+	for (i = 0; i < llp->ll_count; i++)
+	    all[n++] = llp->ll_data[i];
+    }
+
+    qsort(all, n, sizeof(*all), lint_strcmp);
+
+    for (i = total = 0; i < n; i++)
+	if (i == 0 || strcmp(all[i], all[total - 1]) != 0)
+	    all[total++] = all[i];
+
+    *nump = total;
+    return all;
+}
+
+static void
+lint_print_vocabulary (lint_file_t *files, int count)
+{
+    unsigned n, i;
+    char **all = lint_merge(files, count,
+			    offsetof(lint_file_t, lf_vocab), &n);
+
+    if (opt_info)
+	printf("static xo_info_t xo_info_table[] = {\n");
+
+    for (i = 0; i < n; i++) {
+	if (opt_info)
+	    printf("    { \"%s\", \"type\", \"desc\" },\n", all[i]);
+	else
+	    printf("%s\n", all[i]);
+    }
+
+    if (opt_info) {
+	printf("};\n");
+	printf("static int xo_info_count = "
+	       "(sizeof(xo_info_table) / sizeof(xo_info_table[0]));\n\n");
+	printf("#define XO_SET_INFO() \\\n");
+	printf("    xo_set_info(NULL, xo_info_table, xo_info_count)\n");
+    }
+
+    free(all);
+}
+
+/*
+ * Print the format strings as a table suitable for xo_retain_preload.
+ * The strings are given as they appear in the source, so they match
+ * the ones in the binary, including any <inttypes.h> macros.
+ */
+static void
+lint_print_formats (lint_file_t *files, int count)
+{
+    unsigned n, i;
+    char **all = lint_merge(files, count,
+			    offsetof(lint_file_t, lf_formats), &n);
+
+    printf("static const char *xo_format_table[] = {\n");
+    for (i = 0; i < n; i++)
+	printf("    %s,\n", all[i]);
+    printf("};\n");
+    printf("static unsigned xo_format_count = "
+	   "(sizeof(xo_format_table) / sizeof(xo_format_table[0]));\n\n");
+    printf("#define XO_PRELOAD_FORMATS() \\\n");
+    printf("    xo_retain_preload(NULL, xo_format_table, xo_format_count)\n");
+
+    free(all);
+}
+
+/*
+ * Generate compiled emit functions for one file (-G).  The output
+ * is the generated functions, followed by the source file with
+ * calls rewritten to use them.  A "#line" directive keeps compiler
+ * messages pointing at the original source.
+ */
+static int
+lint_generate (lint_file_t *lfp)
+{
+    xo_handle_t *xop = xo_create(XO_STYLE_TEXT, XOF_WARN);
+    lint_gen_t gen;
+
+    bzero(&gen, sizeof(gen));
+    gen.lg_funcs = open_memstream(&gen.lg_funcs_buf, &gen.lg_funcs_len);
+    gen.lg_src = open_memstream(&gen.lg_src_buf, &gen.lg_src_len);
+    if (gen.lg_funcs == NULL || gen.lg_src == NULL)
+	xo_err(1, "could not open output buffer");
+
+    lfp->lf_gen = &gen;
+    lint_file(xop, lfp);
+    lfp->lf_gen = NULL;
+    xo_destroy(xop);
+
+    fclose(gen.lg_funcs);
+    fclose(gen.lg_src);
+
+    if (!gen.lg_failed) {
+	printf("/*\n * Generated by xolint-c -G from %s; do not edit.\n"
+	       " * %u compiled, %u interpreted format strings\n */\n",
+	       lfp->lf_name, gen.lg_compiled, gen.lg_fallback);
+	printf("#include <stddef.h>\n#include <stdint.h>\n"
+	       "#include <inttypes.h>\n"
+	       "#include <sys/types.h>\n#include <wchar.h>\n"
+	       "#include <libxo/xo.h>\n\n");
+	fwrite(gen.lg_funcs_buf, 1, gen.lg_funcs_len, stdout);
+	printf("#line 1 \"%s\"\n", lfp->lf_name);
+	fwrite(gen.lg_src_buf, 1, gen.lg_src_len, stdout);
+    }
+
+    free(gen.lg_funcs_buf);
+    free(gen.lg_src_buf);
+    lint_list_free(&gen.lg_formats);
+
+    return gen.lg_failed ? 1 : 0;
+}
+
+static void
+print_version (void)
+{
+    fprintf(stderr, "libxo version %s%s\n",
+	    xo_version, xo_version_extra);
+    fprintf(stderr, "xolint-c version %s%s\n",
+	    LIBXO_VERSION, LIBXO_VERSION_EXTRA);
+}
+
+static void
+print_help (void)
+{
+    fprintf(stderr,
+"Usage: xolint-c [options] files ...\n"
+"    -c            Invoke 'cpp' on input\n"
+"    -C <flags>    Pass flags to cpp\n"
+"    -F            Print a table of format strings (for xo_retain_preload)\n"
+"    -G            Generate compiled emit functions for one source file\n"
+"    -I            Print xo_info_t data\n"
+"    -j <num>      Check input files using <num> threads\n"
+"    -p            Print input data on errors\n"
+"    -V            Print vocabulary (list of tags)\n"
+"    --help        Display this help text\n"
+"    --version     Display version information\n"
+);
+}
+
+static struct opts {
+    int o_help;
+    int o_version;
+} opts;
+
+static struct option long_opts[] = {
+    { "help", no_argument, &opts.o_help, 1 },
+    { "jobs", required_argument, NULL, 'j' },
+    { "version", no_argument, &opts.o_version, 1 },
+    { NULL, 0, NULL, 0 }
+};
+
+int
+main (int argc, char **argv)
+{
+    lint_file_t *files;
+    int rc, i;
+
+    while ((rc = getopt_long(argc, argv, "cC:FGIj:pV",
+				long_opts, NULL)) != -1) {
+	switch (rc) {
+	case 'c':
+	    opt_cpp = 1;
+	    break;
+
+	case 'C':
+	    opt_cflags = optarg;
+	    break;
+
+	case 'F':
+	    opt_formats = 1;
+	    break;
+
+	case 'G':
+	    opt_generate = 1;
+	    break;
+
+	case 'I':
+	    opt_info = opt_vocabulary = 1;
+	    break;
+
+	case 'j':
+	    opt_jobs = atoi(optarg);
+	    if (opt_jobs < 1)
+		xo_errx(1, "invalid number of jobs: %s", optarg);
+	    break;
+
+	case 'p':
+	    opt_print = 1;
+	    break;
+
+	case 'V':
+	    opt_vocabulary = 1;
+	    break;
+
+	case 0:
+	    if (opts.o_version) {
+		print_version();
+		return 0;
+	    }
+
+	    print_help();
+	    return 1;
+
+	default:
+	    print_help();
+	    return 1;
+	}
+    }
+
+    argc -= optind;
+    argv += optind;
+
+    if (argc <= 0) {
+	print_help();
+	return 1;
+    }
+
+    files = calloc(argc, sizeof(*files));
+    if (files == NULL)
+	xo_errx(1, "out of memory");
+
+    for (i = 0; i < argc; i++)
+	files[i].lf_name = argv[i];
+
+    if (opt_generate) {
+	if (argc != 1 || opt_cpp)
+	    xo_errx(1, "-G needs exactly one input file, without -c");
+
+	rc = lint_generate(&files[0]);
+	if (files[0].lf_errlen)
+	    fwrite(files[0].lf_err, 1, files[0].lf_errlen, stderr);
+	lint_list_free(&files[0].lf_formats);
+	free(files[0].lf_err);
+	free(files);
+	return rc;
+    }
+
+    lint_all(files, argc);
+
+    for (i = 0; i < argc; i++) {
+	lint_file_t *lfp = &files[i];
+
+	if (lfp->lf_errlen)
+	    fwrite(lfp->lf_err, 1, lfp->lf_errlen, stderr);
+	if (!opt_vocabulary && !opt_formats)
+	    printf("%s: %u errors, %u warnings, %u info\n", lfp->lf_name,
+		   lfp->lf_errors, lfp->lf_warnings, lfp->lf_info);
+	fflush(stdout);
+    }
+
+    if (opt_formats)
+	lint_print_formats(files, argc);
+    else if (opt_vocabulary)
+	lint_print_vocabulary(files, argc);
+
+    for (i = 0; i < argc; i++) {
+	lint_list_free(&files[i].lf_vocab);
+	lint_list_free(&files[i].lf_formats);
+	free(files[i].lf_err);
+    }
+    free(files);
+
+    return 0;
+}
@@ -14,11 +14,16 @@
 #include <unistd.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
 #include <sys/queue.h>
 
 #include "xo_config.h"
 #include "xo.h"
 
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
 #include <getopt.h>		/* Include after xo.h for testing */
 
 #ifndef UNUSED
@@ -27,28 +32,106 @@
 
 static int opt_warn;		/* Enable warnings */
 static int opt_numbers;		/* Number our fields */
+static int opt_jobs = 1;	/* Number of worker threads */
 
+/*
+ * Field msgids are kept in the order they were reported by
+ * xo_simplify_format, and are later merged (without duplicates)
+ * into the trailing section of our output.
+ */
 typedef struct xopo_msg_s {
     TAILQ_ENTRY(xopo_msg_s) xm_link;
+    struct xopo_msg_s *xm_hash_next; /* Next in the merge hash bucket */
     char *xm_plural;		/* If plural, points to the second part */
+    int xm_is_plural;		/* Callback reported a plural */
     char xm_data[0];		/* Start of data */
 } xopo_msg_t;
 
 typedef TAILQ_HEAD(xopo_msg_list_s, xopo_msg_s) xopo_msg_list_t;
 
-static xopo_msg_list_t field_list;
+/*
+ * We cache the results of simplifying each msgid, keyed by the
+ * content of the input string.  The cache is shared by all worker
+ * threads, and can be saved to and loaded from a file (--cache), so
+ * repeat runs only need to simplify strings that have changed.
+ */
+typedef struct xopo_entry_s {
+    struct xopo_entry_s *xe_next; /* Next in hash bucket */
+    uint64_t xe_hash;		/* Hash of xe_input */
+    char *xe_input;		/* msgid as found in the input */
+    char *xe_output;		/* Simplified msgid (NULL on failure) */
+    xopo_msg_list_t xe_fields;	/* Field msgids (for "{G:}") */
+    int xe_used;		/* Used in this run (so save it) */
+} xopo_entry_t;
+
+#define XOPO_HASH_SIZE	4096
+
+static xopo_entry_t *xopo_cache[XOPO_HASH_SIZE];
+
+#ifdef HAVE_PTHREAD_H
+static pthread_mutex_t xopo_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define XOPO_LOCK() pthread_mutex_lock(&xopo_cache_mutex)
+#define XOPO_UNLOCK() pthread_mutex_unlock(&xopo_cache_mutex)
+#else /* HAVE_PTHREAD_H */
+#define XOPO_LOCK() do { } while (0)
+#define XOPO_UNLOCK() do { } while (0)
+#endif /* HAVE_PTHREAD_H */
 
-static void
-xopo_msg_cb (const char *str, unsigned len, int plural)
+/*
+ * Each input file is filtered into its own output, so we can process
+ * them in parallel and still stitch the results together in order.
+ */
+typedef struct xopo_file_s {
+    const char *xf_name;	/* Input file name (NULL for stdin) */
+    char *xf_buf;		/* Filtered output */
+    size_t xf_len;		/* Length of xf_buf */
+    xopo_entry_t **xf_entries;	/* Cache entries used, in order */
+    size_t xf_count;		/* Number of entries used */
+    size_t xf_max;		/* Size of xf_entries */
+    int xf_blank;		/* Last line was blank */
+} xopo_file_t;
+
+/*
+ * The xo_simplify_format callback has no opaque argument, so we use
+ * a thread-local to find the entry currently being simplified.
+ */
+#ifndef HAVE_THREAD_LOCAL
+#define THREAD_LOCAL(_x) _x
+#elif HAVE_THREAD_LOCAL == THREAD_LOCAL_before
+#define THREAD_LOCAL(_x) __thread _x
+#elif HAVE_THREAD_LOCAL == THREAD_LOCAL_after
+#define THREAD_LOCAL(_x) _x __thread
+#elif HAVE_THREAD_LOCAL == THREAD_LOCAL_declspec
+#define THREAD_LOCAL(_x) __declspec(_x)
+#else
+#error unknown thread-local setting
+#endif /* HAVE_THREADS_H */
+
+static THREAD_LOCAL(xopo_entry_t *) xopo_cur_entry;
+
+static uint64_t
+xopo_hash (const char *str)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (; *str; str++)
+	hash = (hash ^ (unsigned char) *str) * 1099511628211ULL;
+
+    return hash;
+}
+
+static xopo_msg_t *
+xopo_msg_new (const char *str, unsigned len, int plural)
 {
     int sz = sizeof(xopo_msg_t) + len + 1;
     xopo_msg_t *xmp = malloc(sz);
     if (xmp == NULL)
-	return;
+	return NULL;
 
     bzero(xmp, sz);
     memcpy(xmp->xm_data, str, len);
     xmp->xm_data[len] = '\0';
+    xmp->xm_is_plural = plural;
 
     if (plural) {
 	char *cp = strchr(xmp->xm_data, ',');
@@ -58,17 +141,436 @@ xopo_msg_cb (const char *str, unsigned len, int plural)
 	}
     }
 
-    xopo_msg_t *xmp2;
+    return xmp;
+}
+
+static void
+xopo_msg_cb (const char *str, unsigned len, int plural)
+{
+    xopo_msg_t *xmp = xopo_msg_new(str, len, plural);
+
+    if (xmp && xopo_cur_entry)
+	TAILQ_INSERT_TAIL(&xopo_cur_entry->xe_fields, xmp, xm_link);
+    else
+	free(xmp);
+}
+
+static xopo_entry_t *
+xopo_entry_new (const char *input, uint64_t hash)
+{
+    xopo_entry_t *xep = calloc(1, sizeof(*xep));
+    if (xep == NULL || (xep->xe_input = strdup(input)) == NULL)
+	xo_errx(1, "out of memory");
+
+    xep->xe_hash = hash;
+    TAILQ_INIT(&xep->xe_fields);
+
+    return xep;
+}
+
+/*
+ * Add an entry to the cache.  If another thread beat us to it, we
+ * discard ours and return theirs.  Caller must hold the lock.
+ */
+static xopo_entry_t *
+xopo_entry_insert (xopo_entry_t *xep)
+{
+    xopo_entry_t **bucket = &xopo_cache[xep->xe_hash % XOPO_HASH_SIZE];
+    xopo_entry_t *old;
+
+    for (old = *bucket; old; old = old->xe_next)
+	if (old->xe_hash == xep->xe_hash
+		&& strcmp(old->xe_input, xep->xe_input) == 0)
+	    return old;
+
+    xep->xe_next = *bucket;
+    *bucket = xep;
+
+    return xep;
+}
+
+static void
+xopo_entry_free (xopo_entry_t *xep)
+{
+    xopo_msg_t *xmp;
+
+    while ((xmp = TAILQ_FIRST(&xep->xe_fields)) != NULL) {
+	TAILQ_REMOVE(&xep->xe_fields, xmp, xm_link);
+	free(xmp);
+    }
+
+    free(xep->xe_output);
+    free(xep->xe_input);
+    free(xep);
+}
+
+/*
+ * Find the simplified form of a msgid, consulting the cache first.
+ */
+static xopo_entry_t *
+xopo_simplify (xo_handle_t *xop, const char *input)
+{
+    uint64_t hash = xopo_hash(input);
+    xopo_entry_t *xep;
+
+    XOPO_LOCK();
+    for (xep = xopo_cache[hash % XOPO_HASH_SIZE]; xep; xep = xep->xe_next) {
+	if (xep->xe_hash == hash && strcmp(xep->xe_input, input) == 0) {
+	    xep->xe_used = 1;
+	    XOPO_UNLOCK();
+	    return xep;
+	}
+    }
+    XOPO_UNLOCK();
+
+    /* Simplify without holding the lock; it's the expensive part */
+    xep = xopo_entry_new(input, hash);
+    xep->xe_used = 1;
+
+    xopo_cur_entry = xep;
+    xep->xe_output = xo_simplify_format(xop, input, opt_numbers, xopo_msg_cb);
+    xopo_cur_entry = NULL;
+
+    XOPO_LOCK();
+    xopo_entry_t *found = xopo_entry_insert(xep);
+    found->xe_used = 1;
+    XOPO_UNLOCK();
+
+    if (found != xep)
+	xopo_entry_free(xep);
+
+    return found;
+}
+
+static void
+xopo_file_add_entry (xopo_file_t *xfp, xopo_entry_t *xep)
+{
+    if (xfp->xf_count >= xfp->xf_max) {
+	size_t max = xfp->xf_max ? xfp->xf_max * 2 : 64;
+	xopo_entry_t **newp = realloc(xfp->xf_entries, max * sizeof(*newp));
+	if (newp == NULL)
+	    xo_errx(1, "out of memory");
+	xfp->xf_entries = newp;
+	xfp->xf_max = max;
+    }
+
+    xfp->xf_entries[xfp->xf_count++] = xep;
+}
+
+/*
+ * Filter one input file, rewriting the msgid lines with their
+ * simplified forms.  The output is collected in memory.
+ */
+static void
+xopo_filter (xo_handle_t *xop, xopo_file_t *xfp)
+{
+    static char msgid[] = "msgid ";
+    char buf[BUFSIZ], *cp, *ep;
+    FILE *infile, *outfile;
+    xopo_entry_t *xep;
+
+    if (xfp->xf_name) {
+	infile = fopen(xfp->xf_name, "r");
+	if (infile == NULL)
+	    xo_emit_err(1, "count not open input file: '{:filename}'",
+			xfp->xf_name);
+    } else
+	infile = stdin;
+
+    outfile = open_memstream(&xfp->xf_buf, &xfp->xf_len);
+    if (outfile == NULL)
+	xo_err(1, "could not open output buffer");
+
+    for (;;) {
+	if (fgets(buf, sizeof(buf), infile) == NULL)
+	    break;
+
+	if (buf[0] == '#' && buf[1] == '\n')
+	    continue;
+
+	xfp->xf_blank = (buf[0] == '\n' && buf[1] == '\0');
+
+	if (strncmp(buf, msgid, sizeof(msgid) - 1) != 0) {
+	    fprintf(outfile, "%s", buf);
+	    continue;
+	}
+
+	for (cp = buf + sizeof(msgid); *cp; cp++)
+	    if (!isspace((int) *cp))
+		break;
+
+	if (*cp == '"')
+	    cp += 1;
+
+	ep = cp + strlen(cp);
+	if (ep > cp)
+	    ep -= 1;
+
+	while (isspace((int) *ep) && ep > cp)
+	    ep -= 1;
+
+	if (*ep != '"')
+	    *ep += 1;
+
+	*ep = '\0';
+
+	xep = xopo_simplify(xop, cp);
+	xopo_file_add_entry(xfp, xep);
+
+	if (xep->xe_output)
+	    fprintf(outfile, "msgid \"%s\"\n", xep->xe_output);
+    }
+
+    fclose(outfile);
+    if (infile != stdin)
+	fclose(infile);
+}
+
+#ifdef HAVE_PTHREAD_H
+static xopo_file_t *xopo_files;	/* Files for our workers */
+static int xopo_files_count;	/* Number of files */
+static int xopo_files_next;	/* Next file to be processed */
+static pthread_mutex_t xopo_files_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void *
+xopo_worker (void *arg UNUSED)
+{
+    xo_handle_t *xop = xo_create(XO_STYLE_TEXT, opt_warn ? XOF_WARN : 0);
+    int i;
+
+    for (;;) {
+	pthread_mutex_lock(&xopo_files_mutex);
+	i = xopo_files_next++;
+	pthread_mutex_unlock(&xopo_files_mutex);
+
+	if (i >= xopo_files_count)
+	    break;
+
+	xopo_filter(xop, &xopo_files[i]);
+    }
+
+    xo_destroy(xop);
+    return NULL;
+}
+#endif /* HAVE_PTHREAD_H */
+
+static void
+xopo_filter_all (xopo_file_t *files, int count)
+{
+    int i;
+
+#ifdef HAVE_PTHREAD_H
+    int jobs = (opt_jobs < count) ? opt_jobs : count;
+
+    if (jobs > 1) {
+	pthread_t *tids = calloc(jobs, sizeof(*tids));
+	if (tids == NULL)
+	    xo_errx(1, "out of memory");
+
+	xopo_files = files;
+	xopo_files_count = count;
+	xopo_files_next = 0;
+
+	for (i = 0; i < jobs; i++)
+	    if (pthread_create(&tids[i], NULL, xopo_worker, NULL) != 0)
+		xo_errx(1, "could not create worker thread");
+
+	for (i = 0; i < jobs; i++)
+	    pthread_join(tids[i], NULL);
+
+	free(tids);
+	return;
+    }
+#endif /* HAVE_PTHREAD_H */
+
+    for (i = 0; i < count; i++)
+	xopo_filter(NULL, &files[i]);
+}
+
+/*
+ * The cache file is a simple text file, holding a header line
+ * followed by a set of entries, each separated by a blank line:
+ *
+ *   K <input msgid>
+ *   S <simplified msgid>      (missing if simplification failed)
+ *   F <field msgid>           (or "P" for plurals)
+ */
+static const char xopo_cache_header[] = "# xopo cache, version 1, numbers=";
+
+static void
+xopo_cache_add (xopo_entry_t *xep)
+{
+    if (xep && xopo_entry_insert(xep) != xep)
+	xopo_entry_free(xep);	/* Duplicate entry */
+}
+
+static char *
+xopo_cache_line (char *buf, size_t bufsiz, FILE *fp)
+{
+    if (fgets(buf, bufsiz, fp) == NULL)
+	return NULL;
+
+    size_t len = strlen(buf);
+    if (len > 0 && buf[len - 1] == '\n')
+	buf[--len] = '\0';
+
+    return buf;
+}
+
+static void
+xopo_cache_load (const char *filename)
+{
+    char buf[BUFSIZ * 2];
+    xopo_entry_t *xep = NULL;
+    xopo_msg_t *xmp;
+    FILE *fp;
+
+    fp = fopen(filename, "r");
+    if (fp == NULL)
+	return;			/* No cache yet */
+
+    /* A cache built with different options is useless */
+    if (xopo_cache_line(buf, sizeof(buf), fp) == NULL
+	    || strncmp(buf, xopo_cache_header,
+		       sizeof(xopo_cache_header) - 1) != 0
+	    || atoi(buf + sizeof(xopo_cache_header) - 1) != opt_numbers) {
+	fclose(fp);
+	return;
+    }
+
+    while (xopo_cache_line(buf, sizeof(buf), fp) != NULL) {
+	if (buf[0] == '\0') {
+	    xopo_cache_add(xep);
+	    xep = NULL;
+	    continue;
+	}
+
+	if (buf[1] != ' ')
+	    continue;		/* Malformed; ignore it */
+
+	if (buf[0] == 'K') {
+	    xopo_cache_add(xep);
+	    xep = xopo_entry_new(buf + 2, xopo_hash(buf + 2));
+
+	} else if (xep == NULL) {
+	    continue;
+
+	} else if (buf[0] == 'S') {
+	    free(xep->xe_output);
+	    xep->xe_output = strdup(buf + 2);
+
+	} else if (buf[0] == 'F' || buf[0] == 'P') {
+	    xmp = xopo_msg_new(buf + 2, strlen(buf + 2), buf[0] == 'P');
+	    if (xmp)
+		TAILQ_INSERT_TAIL(&xep->xe_fields, xmp, xm_link);
+	}
+    }
+
+    xopo_cache_add(xep);
+
+    fclose(fp);
+}
+
+/*
+ * Save the cache, keeping only the entries used in this run, so the
+ * cache doesn't grow without bound as strings change.
+ */
+static void
+xopo_cache_save (const char *filename)
+{
+    xopo_entry_t *xep;
+    xopo_msg_t *xmp;
+    int i;
+
+    size_t len = strlen(filename);
+    char *tmpname = alloca(len + 5);
+    memcpy(tmpname, filename, len);
+    memcpy(tmpname + len, ".new", 5);
+
+    FILE *fp = fopen(tmpname, "w");
+    if (fp == NULL) {
+	xo_warn("could not write cache file: '%s'", tmpname);
+	return;
+    }
+
+    fprintf(fp, "%s%d\n", xopo_cache_header, opt_numbers);
+
+    for (i = 0; i < XOPO_HASH_SIZE; i++) {
+	for (xep = xopo_cache[i]; xep; xep = xep->xe_next) {
+	    if (!xep->xe_used)
+		continue;
+
+	    fprintf(fp, "K %s\n", xep->xe_input);
+	    if (xep->xe_output)
+		fprintf(fp, "S %s\n", xep->xe_output);
+
+	    TAILQ_FOREACH(xmp, &xep->xe_fields, xm_link) {
+		if (xmp->xm_is_plural && xmp->xm_plural)
+		    fprintf(fp, "P %s,%s\n", xmp->xm_data, xmp->xm_plural);
+		else
+		    fprintf(fp, "%c %s\n", xmp->xm_is_plural ? 'P' : 'F',
+			    xmp->xm_data);
+	    }
+
+	    fprintf(fp, "\n");
+	}
+    }
+
+    if (fclose(fp) != 0 || rename(tmpname, filename) != 0) {
+	xo_warn("could not save cache file: '%s'", filename);
+	unlink(tmpname);
+    }
+}
 
-    TAILQ_FOREACH(xmp2, &field_list, xm_link) {
-	if (strcmp(xmp->xm_data, xmp2->xm_data) == 0) {
-	    /* Houston, we have a negative on that trajectory */
-	    free(xmp);
-	    return;
+/*
+ * Emit the field msgids found in all files, in order, without
+ * duplicates.  We use a hash table to find duplicates quickly.
+ */
+static void
+xopo_emit_fields (FILE *outfile, xopo_file_t *files, int count)
+{
+    xopo_msg_t **seen = calloc(XOPO_HASH_SIZE, sizeof(*seen));
+    xopo_msg_t *xmp, *xmp2;
+    xopo_entry_t *xep;
+    size_t j;
+    int i;
+
+    if (seen == NULL)
+	xo_errx(1, "out of memory");
+
+    for (i = 0; i < count; i++) {
+	for (j = 0; j < files[i].xf_count; j++) {
+	    xep = files[i].xf_entries[j];
+
+	    TAILQ_FOREACH(xmp, &xep->xe_fields, xm_link) {
+		xopo_msg_t **bucket
+		    = &seen[xopo_hash(xmp->xm_data) % XOPO_HASH_SIZE];
+
+		for (xmp2 = *bucket; xmp2; xmp2 = xmp2->xm_hash_next)
+		    if (strcmp(xmp->xm_data, xmp2->xm_data) == 0)
+			break;
+
+		if (xmp2)
+		    continue;	/* Already seen */
+
+		xmp->xm_hash_next = *bucket;
+		*bucket = xmp;
+
+		if (xmp->xm_plural) {
+		    fprintf(outfile, "msgid \"%s\"\n"
+			    "msgid_plural \"%s\"\n"
+			    "msgstr[0] \"\"\n"
+			    "msgstr[1] \"\"\n\n",
+			    xmp->xm_data, xmp->xm_plural);
+		} else {
+		    fprintf(outfile, "msgid \"%s\"\nmsgstr \"\"\n\n",
+			    xmp->xm_data);
+		}
+	    }
 	}
     }
 
-    TAILQ_INSERT_TAIL(&field_list, xmp, xm_link);
+    free(seen);
 }
 
 static void
@@ -84,8 +586,10 @@ static void
 print_help (void)
 {
     fprintf(stderr,
-"Usage: xopo [options] format [fields]\n"
+"Usage: xopo [options] [file ...]\n"
+"    --cache <file>        Cache simplified msgids in the given file\n"
 "    --help                Display this help text\n"
+"    --jobs <num> OR -j <num> Process input files using <num> threads\n"
 "    --option <opts> -or -O <opts> Give formatting options\n"
 "    --output <file> -or -o <file> Use file as output destination\n"
 "    --po <file> or -f <file> Generate new msgid's for a po file\n"
@@ -101,7 +605,9 @@ static struct opts {
 } opts;
 
 static struct option long_opts[] = {
+    { "cache", required_argument, NULL, 'c' },
     { "help", no_argument, &opts.o_help, 1 },
+    { "jobs", required_argument, NULL, 'j' },
     { "number", no_argument, NULL, 'n' },
     { "option", required_argument, NULL, 'O' },
     { "output", required_argument, NULL, 'o' },
@@ -118,19 +624,30 @@ main (int argc UNUSED, char **argv)
     char *opt_input = NULL;
     char *opt_output = NULL;
     char *opt_simplify = NULL;
+    char *opt_cache = NULL;
     int rc;
 
     argc = xo_parse_args(argc, argv);
     if (argc < 0)
 	return 1;
 
-    while ((rc = getopt_long(argc, argv, "f:no:O:s:W",
+    while ((rc = getopt_long(argc, argv, "c:f:j:no:O:s:W",
 				long_opts, NULL)) != -1) {
 	switch (rc) {
+	case 'c':
+	    opt_cache = optarg;
+	    break;
+
 	case 'f':
 	    opt_input = optarg;
 	    break;
 
+	case 'j':
+	    opt_jobs = atoi(optarg);
+	    if (opt_jobs < 1)
+		xo_errx(1, "invalid number of jobs: %s", optarg);
+	    break;
+
 	case 'n':
 	    opt_numbers = 1;
 	    break;
@@ -197,19 +714,30 @@ main (int argc UNUSED, char **argv)
 	exit(0);
     }
 
-    static char msgid[] = "msgid ";
-    char buf[BUFSIZ], *cp, *ep;
-    FILE *infile;
     FILE *outfile;
-    TAILQ_INIT(&field_list);
-
-    if (opt_input) {
-	infile = fopen(opt_input, "r");
-	if (infile == NULL)
-	    xo_emit_err(1, "count not open input file: '{:filename}'",
-			opt_input);
-    } else
-	infile = stdin;
+    xopo_file_t *files;
+    int count, i;
+
+    /*
+     * Input files can be given via "-f" and/or as arguments.  Their
+     * output is combined, in order, as if the files were concatenated.
+     */
+    count = argc + (opt_input ? 1 : 0);
+    files = calloc(count ?: 1, sizeof(*files));
+    if (files == NULL)
+	xo_errx(1, "out of memory");
+
+    if (opt_input)
+	files[0].xf_name = opt_input;
+    for (i = 0; i < argc; i++)
+	files[i + (opt_input ? 1 : 0)].xf_name = argv[i];
+    if (count == 0)
+	count = 1;		/* Use stdin */
+
+    if (opt_cache)
+	xopo_cache_load(opt_cache);
+
+    xopo_filter_all(files, count);
 
     if (opt_output) {
 	unlink(opt_output);
@@ -220,69 +748,20 @@ main (int argc UNUSED, char **argv)
     } else
 	outfile = stdout;
 
-    int blank = 0, line;
-
-    for (line = 1;; line++) {
-	if (fgets(buf, sizeof(buf), infile) == NULL)
-	    break;
-
-	if (buf[0] == '#' && buf[1] == '\n')
-	    continue;
-
-	blank = (buf[0] == '\n' && buf[1] == '\0');
-
-	if (strncmp(buf, msgid, sizeof(msgid) - 1) != 0) {
-	    fprintf(outfile, "%s", buf);
-	    continue;
-	}
-
-	for (cp = buf + sizeof(msgid); *cp; cp++)
-	    if (!isspace((int) *cp))
-		break;
-
-	if (*cp == '"')
-	    cp += 1;
-
-	ep = cp + strlen(cp);
-	if (ep > cp)
-	    ep -= 1;
-
-	while (isspace((int) *ep) && ep > cp)
-	    ep -= 1;
+    for (i = 0; i < count; i++)
+	fwrite(files[i].xf_buf, 1, files[i].xf_len, outfile);
 
-	if (*ep != '"')
-	    *ep += 1;
-
-	*ep = '\0';
-
-	cp = xo_simplify_format(NULL, cp, opt_numbers, xopo_msg_cb);
-	if (cp) {
-	    fprintf(outfile, "msgid \"%s\"\n", cp);
-	    free(cp);
-	}
-    }
-
-    if (!blank)
+    if (!files[count - 1].xf_blank)
 	fprintf(outfile, "\n");
 
-    xopo_msg_t *xmp;
-    TAILQ_FOREACH(xmp, &field_list, xm_link) {
-	if (xmp->xm_plural) {
-	    fprintf(outfile, "msgid \"%s\"\n"
-		    "msgid_plural \"%s\"\n"
-		    "msgstr[0] \"\"\n"
-		    "msgstr[1] \"\"\n\n",
-		    xmp->xm_data, xmp->xm_plural);
-	} else {
-	    fprintf(outfile, "msgid \"%s\"\nmsgstr \"\"\n\n", xmp->xm_data);
-	}
-    }
+    xopo_emit_fields(outfile, files, count);
 
-    if (infile != stdin)
-	fclose(infile);
     if (outfile != stdout)
 	fclose(outfile);
 
+    if (opt_cache)
+	xopo_cache_save(opt_cache);
+
     xo_finish();
 
     return 0;